@@ -237,6 +237,7 @@ set(NRNIV_FILE_LIST
     ppshape.cpp
     prcellstate.cpp
     pysecname2sec.cpp
+    recordingset.cpp
     rotate3d.cpp
     savstate.cpp
     secbrows.cpp
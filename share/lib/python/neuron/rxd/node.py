@@ -758,8 +758,10 @@ class Node3D(Node):
         if not hasattr(sp, "_dgrid"):
             sp._dgrid = numpy.ndarray((3, sp._nodes_length), dtype=float, order="C")
             sp._dgrid[:] = sp._d.reshape(3, -1)
-            set_diffusion(0, self._grid_id, sp._dgrid, sp._nodes_length)
         sp._dgrid[:, self._index] = v
+        # also when _dgrid is already in use: the solver caches factors of the
+        # line matrices built from it, which set_diffusion invalidates
+        set_diffusion(0, self._grid_id, sp._dgrid, sp._nodes_length)
 
     @property
     def value(self):
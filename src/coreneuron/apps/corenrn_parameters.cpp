@@ -154,6 +154,13 @@ corenrn_parameters::corenrn_parameters()
                      this->report_buff_size,
                      "Size in MB of the report buffer.")
         ->check(CLI::Range(1, 128));
+    sub_config
+        ->add_option("--report-async-buffers",
+                     this->report_async_buffers,
+                     "Number of report steps buffered for the background report writer, 0 "
+                     "records reports on the simulation threads.")
+        ->capture_default_str()
+        ->check(CLI::Range(0, 1'000'000));
 
     auto sub_output = app.add_option_group("output", "Output configuration.");
     sub_output->add_option("-i, --dt_io", this->dt_io, "Dt of I/O.")
@@ -257,6 +264,7 @@ std::ostream& operator<<(std::ostream& os, const corenrn_parameters& corenrn_par
        << "--celsius=" << corenrn_param.celsius << std::endl
        << "--mindelay=" << corenrn_param.mindelay << std::endl
        << "--report-buffer-size=" << corenrn_param.report_buff_size << std::endl
+       << "--report-async-buffers=" << corenrn_param.report_async_buffers << std::endl
        << std::endl
        << "OUTPUT PARAMETERS" << std::endl
        << "--dt_io=" << corenrn_param.dt_io << std::endl
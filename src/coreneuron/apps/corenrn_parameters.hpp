@@ -56,6 +56,7 @@ struct corenrn_parameters_data {
     unsigned nwarp = 65536;  /// Number of warps to balance for cell_interleave_permute == 2
     unsigned num_gpus = 0;   /// Number of gpus to use per node
     unsigned report_buff_size = report_buff_size_default;  /// Size in MB of the report buffer.
+    unsigned report_async_buffers = 0;  /// Report steps buffered for the background writer.
     int seed = -1;  /// Initialization seed for random number generator (int)
 
     bool mpi_enable = false;         /// Enable MPI flag.
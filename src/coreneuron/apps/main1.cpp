@@ -560,6 +560,9 @@ extern "C" int run_solve_core(int argc, char** argv) {
         }
 
         // register all reports with libsonata
+        if (corenrn_param.report_async_buffers && !configs.empty()) {
+            setup_report_writer(corenrn_param.report_async_buffers);
+        }
         double min_report_dt = INT_MAX;
         size_t lfp_report_counter = 0;
         for (size_t i = 0; i < configs.size(); i++) {
@@ -1,6 +1,7 @@
 #include "coreneuron/io/lfp.hpp"
 #include "coreneuron/apps/corenrn_parameters.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <sstream>
@@ -71,68 +72,202 @@ double line_source_lfp_factor(const Point3D& e_pos,
 
 using namespace lfputils;
 
+namespace {
+// Dense kernel blocking: each current loaded from a tile is used for
+// rows_per_block electrodes, and a tile of segs_per_tile currents (16 KiB)
+// stays in L1 while all the rows of a panel are processed.
+constexpr std::size_t rows_per_block = 4;
+constexpr std::size_t rows_per_panel = 32;
+constexpr std::size_t segs_per_tile = 2048;
+// Below this many factors the OpenMP fork/join costs more than it saves.
+constexpr std::size_t min_parallel_factors = 1 << 16;
+}  // namespace
+
 template <LFPCalculatorType Type, typename SegmentIdTy>
 LFPCalculator<Type, SegmentIdTy>::LFPCalculator(const Point3Ds& seg_start,
                                                 const Point3Ds& seg_end,
                                                 const std::vector<double>& radius,
                                                 const std::vector<SegmentIdTy>& segment_ids,
                                                 const Point3Ds& electrodes,
-                                                double extra_cellular_conductivity)
-    : segment_ids_(segment_ids) {
+                                                double extra_cellular_conductivity,
+                                                double cutoff_distance)
+    : n_electrodes_(electrodes.size())
+    , n_segments_(seg_start.size())
+    , segment_ids_(segment_ids) {
     if (seg_start.size() != seg_end.size()) {
         throw std::invalid_argument("Different number of segment starts and ends.");
     }
     if (seg_start.size() != radius.size()) {
         throw std::invalid_argument("Different number of segments and radii.");
     }
+    if (seg_start.size() != segment_ids.size()) {
+        throw std::invalid_argument("Different number of segments and segment ids.");
+    }
+    if (cutoff_distance < 0.0) {
+        throw std::invalid_argument("Negative LFP cutoff distance.");
+    }
     double f(1.0 / (extra_cellular_conductivity * 4.0 * pi));
 
-    m.resize(electrodes.size());
-    for (size_t k = 0; k < electrodes.size(); ++k) {
-        auto& ms = m[k];
-        ms.resize(seg_start.size());
-        for (size_t l = 0; l < seg_start.size(); l++) {
-            ms[l] = getFactor(electrodes[k], seg_start[l], seg_end[l], radius[l], f);
+    row_ptr_.resize(n_electrodes_ + 1);
+    if (cutoff_distance == 0.0) {
+        val_.resize(n_electrodes_ * n_segments_);
+        const long ne = n_electrodes_;
+        // clang-format off
+        #pragma omp parallel for schedule(static) if (val_.size() >= min_parallel_factors)
+        // clang-format on
+        for (long k = 0; k < ne; ++k) {
+            double* row = val_.data() + k * n_segments_;
+            for (size_t l = 0; l < n_segments_; l++) {
+                row[l] = getFactor(electrodes[k], seg_start[l], seg_end[l], radius[l], f);
+            }
+        }
+        for (size_t k = 0; k <= n_electrodes_; ++k) {
+            row_ptr_[k] = k * n_segments_;
+        }
+        dense_ = true;
+    } else {
+        std::vector<Point3D> centers(n_segments_);
+        for (size_t l = 0; l < n_segments_; l++) {
+            centers[l] = barycenter(seg_start[l], seg_end[l]);
+        }
+        for (size_t k = 0; k < n_electrodes_; ++k) {
+            row_ptr_[k] = val_.size();
+            for (size_t l = 0; l < n_segments_; l++) {
+                if (norm(paxpy(electrodes[k], -1.0, centers[l])) > cutoff_distance) {
+                    continue;
+                }
+                col_.push_back(l);
+                val_.push_back(getFactor(electrodes[k], seg_start[l], seg_end[l], radius[l], f));
+            }
+        }
+        row_ptr_[n_electrodes_] = val_.size();
+        if (val_.size() == n_electrodes_ * n_segments_) {
+            // nothing was cut off, the implicit column indices are cheaper
+            col_.clear();
+            dense_ = true;
+        }
+        col_.shrink_to_fit();
+        val_.shrink_to_fit();
+    }
+    currents_.resize(n_segments_);
+    res_.resize(n_electrodes_);
+    lfp_values_.resize(n_electrodes_);
+}
+
+template <LFPCalculatorType Type, typename SegmentIdTy>
+void LFPCalculator<Type, SegmentIdTy>::dense_lfp(double* res) const {
+    const std::size_t ns = n_segments_;
+    const double* c = currents_.data();
+    const long npanel = (n_electrodes_ + rows_per_panel - 1) / rows_per_panel;
+    // clang-format off
+    #pragma omp parallel for schedule(static) if (val_.size() >= min_parallel_factors)
+    // clang-format on
+    for (long p = 0; p < npanel; ++p) {
+        const std::size_t k_begin = p * rows_per_panel;
+        const std::size_t k_end = std::min(k_begin + rows_per_panel, n_electrodes_);
+        double acc[rows_per_panel] = {};
+        for (std::size_t l_begin = 0; l_begin < ns; l_begin += segs_per_tile) {
+            const std::size_t l_end = std::min(l_begin + segs_per_tile, ns);
+            std::size_t k = k_begin;
+            for (; k + rows_per_block <= k_end; k += rows_per_block) {
+                const double* m0 = val_.data() + k * ns;
+                const double* m1 = m0 + ns;
+                const double* m2 = m1 + ns;
+                const double* m3 = m2 + ns;
+                double r0 = 0.0, r1 = 0.0, r2 = 0.0, r3 = 0.0;
+                // clang-format off
+                #pragma omp simd reduction(+ : r0, r1, r2, r3)
+                // clang-format on
+                for (std::size_t l = l_begin; l < l_end; ++l) {
+                    r0 += m0[l] * c[l];
+                    r1 += m1[l] * c[l];
+                    r2 += m2[l] * c[l];
+                    r3 += m3[l] * c[l];
+                }
+                acc[k - k_begin] += r0;
+                acc[k - k_begin + 1] += r1;
+                acc[k - k_begin + 2] += r2;
+                acc[k - k_begin + 3] += r3;
+            }
+            for (; k < k_end; ++k) {
+                const double* m0 = val_.data() + k * ns;
+                double r0 = 0.0;
+                // clang-format off
+                #pragma omp simd reduction(+ : r0)
+                // clang-format on
+                for (std::size_t l = l_begin; l < l_end; ++l) {
+                    r0 += m0[l] * c[l];
+                }
+                acc[k - k_begin] += r0;
+            }
         }
+        std::copy(acc, acc + (k_end - k_begin), res + k_begin);
+    }
+}
+
+template <LFPCalculatorType Type, typename SegmentIdTy>
+void LFPCalculator<Type, SegmentIdTy>::sparse_lfp(double* res) const {
+    const double* c = currents_.data();
+    const double* v = val_.data();
+    const int* col = col_.data();
+    const long ne = n_electrodes_;
+    // clang-format off
+    #pragma omp parallel for schedule(static) if (val_.size() >= min_parallel_factors)
+    // clang-format on
+    for (long k = 0; k < ne; ++k) {
+        double r = 0.0;
+        // clang-format off
+        #pragma omp simd reduction(+ : r)
+        // clang-format on
+        for (std::size_t j = row_ptr_[k]; j < row_ptr_[k + 1]; ++j) {
+            r += v[j] * c[col[j]];
+        }
+        res[k] = r;
     }
 }
 
 template <LFPCalculatorType Type, typename SegmentIdTy>
 template <typename Vector>
 inline void LFPCalculator<Type, SegmentIdTy>::lfp(const Vector& membrane_current) {
-    std::vector<double> res(m.size());
-    for (size_t k = 0; k < m.size(); ++k) {
-        res[k] = 0.0;
-        auto& ms = m[k];
-        for (size_t l = 0; l < ms.size(); l++) {
-            res[k] += ms[l] * membrane_current[segment_ids_[l]];
-        }
+    // Gather once, rather than once per electrode in the kernels.
+    for (size_t l = 0; l < n_segments_; l++) {
+        currents_[l] = membrane_current[segment_ids_[l]];
     }
+    double* res = res_.data();
 #if NRNMPI
-    if (corenrn_param.mpi_enable) {
-        lfp_values_.resize(res.size());
-        int mpi_sum{1};
-        nrnmpi_dbl_allreduce_vec(res.data(), lfp_values_.data(), res.size(), mpi_sum);
-    } else
+    if (!corenrn_param.mpi_enable)
 #endif
     {
-        std::swap(res, lfp_values_);
+        res = lfp_values_.data();
     }
+    // if the cutoff dropped every factor, the sparse rows are empty and give 0
+    if (dense_) {
+        dense_lfp(res);
+    } else {
+        sparse_lfp(res);
+    }
+#if NRNMPI
+    if (corenrn_param.mpi_enable) {
+        int mpi_sum{1};
+        nrnmpi_dbl_allreduce_vec(res_.data(), lfp_values_.data(), res_.size(), mpi_sum);
+    }
+#endif
 }
 
-
 template LFPCalculator<LineSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
                                                   const lfputils::Point3Ds& seg_end,
                                                   const std::vector<double>& radius,
                                                   const std::vector<int>& segment_ids,
                                                   const lfputils::Point3Ds& electrodes,
-                                                  double extra_cellular_conductivity);
+                                                  double extra_cellular_conductivity,
+                                                  double cutoff_distance);
 template LFPCalculator<PointSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
                                                    const lfputils::Point3Ds& seg_end,
                                                    const std::vector<double>& radius,
                                                    const std::vector<int>& segment_ids,
                                                    const lfputils::Point3Ds& electrodes,
-                                                   double extra_cellular_conductivity);
+                                                   double extra_cellular_conductivity,
+                                                   double cutoff_distance);
 template void LFPCalculator<LineSource>::lfp(const DoublePtr& membrane_current);
 template void LFPCalculator<PointSource>::lfp(const DoublePtr& membrane_current);
 template void LFPCalculator<LineSource>::lfp(const std::vector<double>& membrane_current);
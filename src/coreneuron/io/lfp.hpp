@@ -67,6 +67,13 @@ enum LFPCalculatorType { LineSource, PointSource };
 
 /**
  * \brief LFPCalculator allows calculation of LFP given membrane currents.
+ *
+ * The transfer matrix (electrodes x segments) is stored contiguously in CSR
+ * form. Without a cutoff distance every row is full and the column indices
+ * are implicit, in which case lfp() uses a register and cache blocked dense
+ * kernel. With a cutoff distance the factors of segments further away from
+ * an electrode are dropped and lfp() uses a sparse kernel. In both cases rows
+ * are evaluated in parallel by the OpenMP threads that run the NrnThreads.
  */
 template <LFPCalculatorType Ty, typename SegmentIdTy = int>
 struct LFPCalculator {
@@ -76,16 +83,20 @@ struct LFPCalculator {
      * \param seg_end all segments end owned by the proc
      * \param radius fence around the segment. Ensures electrode cannot be
      * arbitrarily close to the segment
+     * \param segment_ids index of each segment in the membrane current vector
      * \param electrodes positions of the electrodes
      * \param extra_cellular_conductivity conductivity of the extra-cellular
      * medium
+     * \param cutoff_distance segments whose center is further than this from
+     * an electrode do not contribute to its LFP. 0 (default) keeps all of them.
      */
     LFPCalculator(const lfputils::Point3Ds& seg_start,
                   const lfputils::Point3Ds& seg_end,
                   const std::vector<double>& radius,
                   const std::vector<SegmentIdTy>& segment_ids,
                   const lfputils::Point3Ds& electrodes,
-                  double extra_cellular_conductivity);
+                  double extra_cellular_conductivity,
+                  double cutoff_distance = 0.0);
 
     template <typename Vector>
     void lfp(const Vector& membrane_current);
@@ -94,14 +105,36 @@ struct LFPCalculator {
         return lfp_values_;
     }
 
+    /** Number of stored (electrode, segment) factors. */
+    std::size_t num_factors() const noexcept {
+        return val_.size();
+    }
+
+    /** True if every electrode-segment pair is stored. */
+    bool is_dense() const noexcept {
+        return dense_;
+    }
+
   private:
     inline double getFactor(const lfputils::Point3D& e_pos,
                             const lfputils::Point3D& seg_0,
                             const lfputils::Point3D& seg_1,
                             const double radius,
                             const double f) const;
+    void dense_lfp(double* res) const;
+    void sparse_lfp(double* res) const;
+
+    std::size_t n_electrodes_;
+    std::size_t n_segments_;
     std::vector<double> lfp_values_;
-    std::vector<std::vector<double>> m;
+    /// CSR transfer matrix, col_ is empty if the matrix is dense
+    std::vector<std::size_t> row_ptr_;
+    std::vector<int> col_;
+    std::vector<double> val_;
+    bool dense_ = false;
+    /// membrane currents gathered in segment order, and the local sums
+    std::vector<double> currents_;
+    std::vector<double> res_;
     const std::vector<SegmentIdTy>& segment_ids_;
 };
 
@@ -128,13 +161,15 @@ extern template LFPCalculator<LineSource>::LFPCalculator(const lfputils::Point3D
                                                          const std::vector<double>& radius,
                                                          const std::vector<int>& segment_ids,
                                                          const lfputils::Point3Ds& electrodes,
-                                                         double extra_cellular_conductivity);
+                                                         double extra_cellular_conductivity,
+                                                         double cutoff_distance);
 extern template LFPCalculator<PointSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
                                                           const lfputils::Point3Ds& seg_end,
                                                           const std::vector<double>& radius,
                                                           const std::vector<int>& segment_ids,
                                                           const lfputils::Point3Ds& electrodes,
-                                                          double extra_cellular_conductivity);
+                                                          double extra_cellular_conductivity,
+                                                          double cutoff_distance);
 extern template void LFPCalculator<LineSource>::lfp(const lfputils::DoublePtr& membrane_current);
 extern template void LFPCalculator<PointSource>::lfp(const lfputils::DoublePtr& membrane_current);
 extern template void LFPCalculator<LineSource>::lfp(const std::vector<double>& membrane_current);
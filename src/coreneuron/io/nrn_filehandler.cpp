@@ -6,14 +6,41 @@
 # =============================================================================.
 */
 
+#include <charconv>
 #include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "coreneuron/io/nrn_filehandler.hpp"
 #include "coreneuron/nrnconf.h"
 
 namespace coreneuron {
+namespace {
+/** Parse an integer at the beginning of s (after blanks) and drop it from s.
+ * Return false if there is none.
+ */
+bool parse_int(std::string_view& s, int& i) {
+    size_t b = s.find_first_not_of(" \t");
+    if (b == std::string_view::npos) {
+        return false;
+    }
+    const char* first = s.data() + b;
+    const char* last = s.data() + s.size();
+    // accept an explicit sign as sscanf("%d") does
+    if (*first == '+') {
+        ++first;
+    }
+    auto result = std::from_chars(first, last, i);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    s.remove_prefix(result.ptr - s.data());
+    return true;
+}
+}  // namespace
+
 FileHandler::FileHandler(const std::string& filename)
-    : chkpnt(0)
-    , stored_chkpnt(0) {
+    : FileHandler() {
     this->open(filename);
 }
 
@@ -25,57 +52,78 @@ bool FileHandler::file_exist(const std::string& filename) {
 void FileHandler::open(const std::string& filename, std::ios::openmode mode) {
     nrn_assert((mode & (std::ios::in | std::ios::out)));
     close();
-    F.open(filename, mode | std::ios::binary);
-    if (!F.is_open()) {
-        std::cerr << "cannot open file '" << filename << "'" << std::endl;
-    }
-    nrn_assert(F.is_open());
     current_mode = mode;
-    char version[256];
     if (current_mode & std::ios::in) {
-        F.getline(version, sizeof(version));
-        nrn_assert(!F.fail());
-        check_bbcore_write_version(version);
+        nrn_assert(!(current_mode & std::ios::out));
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "cannot open file '" << filename << "'" << std::endl;
+        }
+        nrn_assert(fd >= 0);
+        struct stat st;
+        nrn_assert(fstat(fd, &st) == 0);
+        size_t size = st.st_size;
+        void* p = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        if (p != MAP_FAILED) {
+            // the phase files are read front to back exactly once, start
+            // reading ahead right away
+            madvise(p, size, MADV_SEQUENTIAL);
+            madvise(p, size, MADV_WILLNEED);
+            mapped = true;
+            map_begin = static_cast<const char*>(p);
+        } else {
+            // e.g. empty file or a file system that does not support mmap
+            buffer.resize(size + 1);
+            size_t n = 0;
+            while (n < size) {
+                ssize_t r = ::read(fd, buffer.data() + n, size - n);
+                nrn_assert(r > 0);
+                n += r;
+            }
+            map_begin = buffer.data();
+        }
+        ::close(fd);
+        map_end = map_begin + size;
+        pos = map_begin;
+        F.clear();
+        check_bbcore_write_version(std::string(read_line()).c_str());
     }
     if (current_mode & std::ios::out) {
+        F.open(filename, mode | std::ios::binary);
+        if (!F.is_open()) {
+            std::cerr << "cannot open file '" << filename << "'" << std::endl;
+        }
+        nrn_assert(F.is_open());
         F << bbcore_write_version << "\n";
     }
 }
 
 bool FileHandler::eof() {
-    if (F.eof()) {
-        return true;
-    }
-    int a = F.get();
-    if (F.eof()) {
-        return true;
-    }
-    F.putback(a);
-    return false;
+    return pos == map_end;
 }
 
-int FileHandler::read_int() {
-    char line_buf[max_line_length];
-
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+std::string_view FileHandler::read_line() {
+    nrn_assert(pos && pos < map_end);
+    const char* nl = static_cast<const char*>(std::memchr(pos, '\n', map_end - pos));
+    const char* end = nl ? nl : map_end;
+    std::string_view line(pos, end - pos);
+    pos = nl ? nl + 1 : map_end;
+    return line;
+}
 
+int FileHandler::read_int() {
+    std::string_view line = read_line();
     int i;
-    int n_scan = sscanf(line_buf, "%d", &i);
-    nrn_assert(n_scan == 1);
-
+    nrn_assert(parse_int(line, i));
     return i;
 }
 
 void FileHandler::read_mapping_count(int* gid, int* nsec, int* nseg, int* nseclist) {
-    char line_buf[max_line_length];
-
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+    std::string_view line = read_line();
 
     /** mapping file has extra strings, ignore those */
-    int n_scan = sscanf(line_buf, "%d %d %d %d", gid, nsec, nseg, nseclist);
-    nrn_assert(n_scan == 4);
+    nrn_assert(parse_int(line, *gid) && parse_int(line, *nsec) && parse_int(line, *nseg) &&
+               parse_int(line, *nseclist));
 }
 
 void FileHandler::read_mapping_cell_count(int* count) {
@@ -83,17 +131,19 @@ void FileHandler::read_mapping_cell_count(int* count) {
 }
 
 void FileHandler::read_checkpoint_assert() {
-    char line_buf[max_line_length];
-
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+    std::string_view line = read_line();
 
     int i;
-    int n_scan = sscanf(line_buf, "chkpnt %d\n", &i);
-    if (n_scan != 1) {
+    constexpr std::string_view prefix = "chkpnt ";
+    bool ok = line.substr(0, prefix.size()) == prefix;
+    if (ok) {
+        line.remove_prefix(prefix.size());
+        ok = parse_int(line, i);
+    }
+    if (!ok) {
         fprintf(stderr, "no chkpnt line for %d\n", chkpnt);
     }
-    nrn_assert(n_scan == 1);
+    nrn_assert(ok);
     if (i != chkpnt) {
         fprintf(stderr, "file chkpnt %d != expected %d\n", i, chkpnt);
     }
@@ -102,6 +152,15 @@ void FileHandler::read_checkpoint_assert() {
 }
 
 void FileHandler::close() {
-    F.close();
+    if (map_begin) {
+        if (mapped) {
+            munmap(const_cast<char*>(map_begin), map_end - map_begin);
+        }
+        std::vector<char>().swap(buffer);
+        map_begin = map_end = pos = nullptr;
+        mapped = false;
+    } else {
+        F.close();
+    }
 }
 }  // namespace coreneuron
@@ -11,8 +11,10 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <string_view>
 #include <vector>
 #include <cmath>
+#include <cstring>
 #include <sys/stat.h>
 
 #include "coreneuron/io/nrnsection_mapping.hpp"
@@ -29,24 +31,40 @@ namespace coreneuron {
  *
  * All automatic allocations performed by read_int_array()
  * and read_dbl_array() methods use new [].
+ *
+ * Files opened for reading are memory mapped as a whole (or read in one go
+ * if they cannot be mapped), so that text entries are parsed and arrays are
+ * copied straight from the page cache without stream buffering or line
+ * buffers. Writers pad checkpoint lines with blanks so that every array
+ * starts at a multiple of chkpnt_align bytes in the file, and hence in the
+ * mapping.
  */
 
-// @todo: remove this static buffer
-const int max_line_length = 1024;
+/// Alignment (bytes from start of file) of arrays following a checkpoint line
+constexpr std::size_t chkpnt_align = 64;
 
 class FileHandler {
-    std::fstream F;                        //!< File stream associated with reader.
+    std::fstream F;                        //!< File stream associated with writer.
     std::ios_base::openmode current_mode;  //!< File open mode (not stored in fstream)
     int chkpnt;                            //!< Current checkpoint number state.
     int stored_chkpnt;                     //!< last "remembered" checkpoint number state.
+    const char* map_begin;                 //!< Contents of the file open for reading.
+    const char* map_end;                   //!< End of the contents.
+    const char* pos;                       //!< Current read position in the contents.
+    bool mapped;                           //!< Contents are mmap-ed (not in buffer).
+    std::vector<char> buffer;              //!< Contents if the file could not be mapped.
+
     /** Read a checkpoint line, bump our chkpnt counter, and assert equality.
      *
      * Checkpoint information is represented by a sequence "checkpt %d\n"
      * where %d is a scanf-compatible representation of the checkpoint
-     * integer.
+     * integer. Blanks before the newline are padding and are ignored.
      */
     void read_checkpoint_assert();
 
+    /** Return the next line (without newline) and move past it. */
+    std::string_view read_line();
+
     // FileHandler is not copyable.
     FileHandler(const FileHandler&) = delete;
     FileHandler& operator=(const FileHandler&) = delete;
@@ -54,16 +72,28 @@ class FileHandler {
   public:
     FileHandler()
         : chkpnt(0)
-        , stored_chkpnt(0) {}
+        , stored_chkpnt(0)
+        , map_begin(nullptr)
+        , map_end(nullptr)
+        , pos(nullptr)
+        , mapped(false) {}
 
     explicit FileHandler(const std::string& filename);
 
+    ~FileHandler() {
+        close();
+    }
+
     /** Preserving chkpnt state, move to a new file. */
     void open(const std::string& filename, std::ios::openmode mode = std::ios::in);
 
-    /** Is the file not open */
+    /** Is the file not open
+     *
+     * As with std::fstream, this is also true after closing a file that was
+     * not open.
+     */
     bool fail() const {
-        return F.fail();
+        return !map_begin && F.fail();
     }
 
     static bool file_exist(const std::string& filename);
@@ -119,10 +149,7 @@ class FileHandler {
                           NrnThreadMappingInfo* ntmapping,
                           std::shared_ptr<CellMapping> cmap,
                           const NrnThread& nt) {
-        std::string line;
-        std::getline(F, line);
-
-        std::istringstream iss(line);
+        std::istringstream iss{std::string(read_line())};
         std::string name_str;
         int nsec = 0;
         int nseg = 0;
@@ -195,16 +222,12 @@ class FileHandler {
             nrn_assert(p != 0);
 
         read_checkpoint_assert();
-        switch (flag) {
-        case seek:
-            F.seekg(count * sizeof(T), std::ios_base::cur);
-            break;
-        case read:
-            F.read((char*) p, count * sizeof(T));
-            break;
+        size_t nbytes = count * sizeof(T);
+        nrn_assert(size_t(map_end - pos) >= nbytes);
+        if (flag == read && nbytes) {
+            std::memcpy(p, pos, nbytes);
         }
-
-        nrn_assert(!F.fail());
+        pos += nbytes;
         return p;
     }
 
@@ -284,7 +307,10 @@ class FileHandler {
     /* write_checkpoint is callable only for our internal uses, making it accesible to user, makes
      * file format unpredictable */
     void write_checkpoint() {
-        F << "chkpnt " << chkpnt++ << "\n";
+        std::string line = "chkpnt " + std::to_string(chkpnt++);
+        size_t end = size_t(F.tellp()) + line.size() + 1;
+        line.append((chkpnt_align - end % chkpnt_align) % chkpnt_align, ' ');
+        F << line << "\n";
     }
 };
 }  // namespace coreneuron
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <cstring>
 #include <mutex>
 
@@ -41,6 +42,7 @@
 // callbacks into nrn/src/nrniv/nrnbbcore_write.cpp
 #include "coreneuron/sim/fast_imem.hpp"
 #include "coreneuron/coreneuron.hpp"
+#include "coreneuron/utils/profile/profiler_interface.h"
 
 
 /// --> Coreneuron
@@ -153,6 +155,44 @@ void (*nrn2core_all_weights_return_)(std::vector<double*>& weights);
 namespace coreneuron {
 static OMP_Mutex mut;
 
+/// Wall time of each step of nrn_setup on this rank, reported (maximum over
+/// ranks) with --verbose debug to see where the startup time goes.
+static std::vector<std::pair<const char*, double>> setup_step_times;
+
+/// Time a step of nrn_setup until the end of the scope, also as an
+/// Instrumentor region.
+struct SetupStep {
+    const char* name;
+    Instrumentor::phase p;
+    double start;
+    explicit SetupStep(const char* name_)
+        : name(name_)
+        , p(name_)
+        , start(nrn_wtime()) {}
+    ~SetupStep() {
+        setup_step_times.emplace_back(name, nrn_wtime() - start);
+    }
+};
+
+static void report_setup_step_times() {
+    if (corenrn_param.verbose < corenrn_parameters::verbose_level::DEBUG_INFO) {
+        setup_step_times.clear();
+        return;
+    }
+    for (const auto& step: setup_step_times) {
+        double t = step.second;
+#if NRNMPI
+        if (corenrn_param.mpi_enable) {
+            t = nrnmpi_dbl_allmax(t);
+        }
+#endif
+        if (nrnmpi_myid == 0) {
+            printf("  %-24s : %.2lf seconds (max over ranks)\n", step.first, t);
+        }
+    }
+    setup_step_times.clear();
+}
+
 /// Vector of maps for negative presyns
 std::vector<std::map<int, PreSyn*>> neg_gid2out;
 /// Maps for ouput and input presyns
@@ -263,51 +303,82 @@ void determine_inputpresyn() {
     // do not need to worry about negative gid overlap since only use
     // it to search for PreSyn in this thread.
 
-    std::vector<InputPreSyn*> inputpresyn_;
-
-    for (int ith = 0; ith < nrn_nthread; ++ith) {
-        NrnThread& nt = nrn_threads[ith];
-        // associate gid with InputPreSyn and increase PreSyn and InputPreSyn count
-        nt.n_input_presyn = 0;
+    // The map lookups are done concurrently for all threads (gid2out and
+    // neg_gid2out are not modified here). Each thread records the PreSyn of
+    // each of its NetCon and, in order of first appearance, the source gids
+    // that are not output gids of this process together with their NetCon
+    // count. Only the merge into gid2in, which creates the InputPreSyn, is
+    // serial and done in thread order, so the result does not depend on the
+    // number of OpenMP threads.
+    std::vector<std::vector<PreSyn*>> nc_presyn(nrn_nthread);
+    std::vector<std::vector<std::pair<int, int>>> input_gid_cnt(nrn_nthread);
+    nrn_multithread_job([&](NrnThread* nt) {
+        int ith = nt->id;
+        auto& presyns = nc_presyn[ith];
+        auto& gid_cnt = input_gid_cnt[ith];
+        presyns.assign(nt->n_netcon, nullptr);
+        std::unordered_map<int, std::size_t> gid_index;
         // if single thread or file transfer then definitely empty.
         std::vector<int>& negsrcgid_tid = nrnthreads_netcon_negsrcgid_tid[ith];
         size_t i_tid = 0;
-        for (int i = 0; i < nt.n_netcon; ++i) {
+        for (int i = 0; i < nt->n_netcon; ++i) {
             int gid = nrnthreads_netcon_srcgid[ith][i];
             if (gid >= 0) {
-                /// If PreSyn or InputPreSyn is already in the map
+                /// If PreSyn is already in the map
                 auto gid2out_it = gid2out.find(gid);
                 if (gid2out_it != gid2out.end()) {
-                    /// Increase PreSyn count
-                    ++gid2out_it->second->nc_cnt_;
+                    presyns[i] = gid2out_it->second;
                     continue;
                 }
-                auto gid2in_it = gid2in.find(gid);
-                if (gid2in_it != gid2in.end()) {
-                    /// Increase InputPreSyn count
-                    ++gid2in_it->second->nc_cnt_;
-                    continue;
+                /// Otherwise count it for the InputPreSyn
+                auto it = gid_index.emplace(gid, gid_cnt.size());
+                if (it.second) {
+                    gid_cnt.emplace_back(gid, 0);
                 }
-
-                /// Create InputPreSyn and increase its count
-                InputPreSyn* psi = new InputPreSyn;
-                ++psi->nc_cnt_;
-                gid2in[gid] = psi;
-                inputpresyn_.push_back(psi);
-                ++nt.n_input_presyn;
+                ++gid_cnt[it.first->second].second;
             } else {
-                int tid = nt.id;
+                int tid = ith;
                 if (!negsrcgid_tid.empty()) {
                     tid = negsrcgid_tid[i_tid++];
                 }
                 auto gid2out_it = neg_gid2out[tid].find(gid);
                 if (gid2out_it != neg_gid2out[tid].end()) {
-                    /// Increase negative PreSyn count
-                    ++gid2out_it->second->nc_cnt_;
+                    presyns[i] = gid2out_it->second;
                 }
             }
         }
+    });
+
+    std::vector<InputPreSyn*> inputpresyn_;
+
+    for (int ith = 0; ith < nrn_nthread; ++ith) {
+        NrnThread& nt = nrn_threads[ith];
+        // associate gid with InputPreSyn and increase PreSyn and InputPreSyn count
+        nt.n_input_presyn = 0;
+        for (PreSyn* ps: nc_presyn[ith]) {
+            if (ps) {
+                /// Increase PreSyn count
+                ++ps->nc_cnt_;
+            }
+        }
+        for (const auto& gc: input_gid_cnt[ith]) {
+            auto gid2in_it = gid2in.find(gc.first);
+            if (gid2in_it != gid2in.end()) {
+                /// Increase InputPreSyn count
+                gid2in_it->second->nc_cnt_ += gc.second;
+                continue;
+            }
+
+            /// Create InputPreSyn and set its count
+            InputPreSyn* psi = new InputPreSyn;
+            psi->nc_cnt_ = gc.second;
+            gid2in[gc.first] = psi;
+            inputpresyn_.push_back(psi);
+            ++nt.n_input_presyn;
+        }
     }
+    nc_presyn.clear();
+    input_gid_cnt.clear();
 
     // now, we can opportunistically create the NetCon* pointer array
     // to save some memory overhead for
@@ -364,21 +435,30 @@ void determine_inputpresyn() {
     // note that not all netcon_in_presyn will be filled if there are netcon
     // with no presyn (ie. nrnthreads_netcon_srcgid[nt.id][i] = -1) but that is ok since they are
     // only used via ps.nc_index_ and ps.nc_cnt_;
-    for (int ith = 0; ith < nrn_nthread; ++ith) {
-        NrnThread& nt = nrn_threads[ith];
+    // As above, the lookups are concurrent and the filling is serial.
+    std::vector<std::vector<std::pair<PreSyn*, InputPreSyn*>>> nc_source(nrn_nthread);
+    nrn_multithread_job([&](NrnThread* nt) {
+        int ith = nt->id;
+        auto& source = nc_source[ith];
+        source.resize(nt->n_netcon);
         // if single thread or file transfer then definitely empty.
         std::vector<int>& negsrcgid_tid = nrnthreads_netcon_negsrcgid_tid[ith];
         size_t i_tid = 0;
-        for (int i = 0; i < nt.n_netcon; ++i) {
-            NetCon* nc = nt.netcons + i;
+        for (int i = 0; i < nt->n_netcon; ++i) {
             int gid = nrnthreads_netcon_srcgid[ith][i];
             int tid = ith;
             if (!negsrcgid_tid.empty() && gid < -1) {
                 tid = negsrcgid_tid[i_tid++];
             }
-            PreSyn* ps;
-            InputPreSyn* psi;
-            netpar_tid_gid2ps(tid, gid, &ps, &psi);
+            netpar_tid_gid2ps(tid, gid, &source[i].first, &source[i].second);
+        }
+    });
+    for (int ith = 0; ith < nrn_nthread; ++ith) {
+        NrnThread& nt = nrn_threads[ith];
+        for (int i = 0; i < nt.n_netcon; ++i) {
+            NetCon* nc = nt.netcons + i;
+            PreSyn* ps = nc_source[ith][i].first;
+            InputPreSyn* psi = nc_source[ith][i].second;
             if (ps) {
                 netcon_in_presyn_order_[ps->nc_index_ + ps->nc_cnt_] = nc;
                 ++ps->nc_cnt_;
@@ -417,7 +497,10 @@ void nrn_setup(const char* filesdat,
 
     int ngroup;
     int* gidgroups;
-    nrn_read_filesdat(ngroup, gidgroups, filesdat);
+    {
+        SetupStep step("setup-read-filesdat");
+        nrn_read_filesdat(ngroup, gidgroups, filesdat);
+    }
     UserParams userParams(ngroup,
                           gidgroups,
                           datpath,
@@ -481,29 +564,39 @@ void nrn_setup(const char* filesdat,
     // of phase2.  So gap junction setup is deferred to after phase2.
 
     nrnthreads_netcon_negsrcgid_tid.resize(nrn_nthread);
-    if (corenrn_file_mode) {
-        coreneuron::phase_wrapper<coreneuron::phase::one>(userParams, !corenrn_file_mode);
-    } else {
-        nrn_multithread_job([](NrnThread* n) {
-            Phase1 p1{n->id};
-            p1.populate(*n, mut);
-        });
+    {
+        SetupStep step("setup-phase1");
+        if (corenrn_file_mode) {
+            coreneuron::phase_wrapper<coreneuron::phase::one>(userParams, !corenrn_file_mode);
+        } else {
+            nrn_multithread_job([](NrnThread* n) {
+                Phase1 p1{n->id};
+                p1.populate(*n, mut);
+            });
+        }
     }
 
     // from the gid2out map and the nrnthreads_netcon_srcgid array,
     // fill the gid2in, and from the number of entries,
     // allocate the process wide InputPreSyn array
-    determine_inputpresyn();
+    {
+        SetupStep step("setup-inputpresyn");
+        determine_inputpresyn();
+    }
 
     // read the rest of the gidgroup's data and complete the setup for each
     // thread.
     /* nrn_multithread_job supports serial, pthread, and openmp. */
-    coreneuron::phase_wrapper<coreneuron::phase::two>(userParams, !corenrn_file_mode);
+    {
+        SetupStep step("setup-phase2");
+        coreneuron::phase_wrapper<coreneuron::phase::two>(userParams, !corenrn_file_mode);
+    }
 
     // gap junctions
     // Gaps are done after phase2, in order to use layout and permutation
     // information via calls to legacy_index2pointer.
     if (nrn_have_gaps) {
+        SetupStep step("setup-gap");
         nrn_partrans::transfer_thread_data_ = new nrn_partrans::TransferThreadData[nrn_nthread];
         if (!corenrn_embedded) {
             nrn_partrans::setup_info_ = new SetupTransferInfo[nrn_nthread];
@@ -522,8 +615,10 @@ void nrn_setup(const char* filesdat,
         nrn_partrans::setup_info_ = nullptr;
     }
 
-    if (is_mapping_needed)
+    if (is_mapping_needed) {
+        SetupStep step("setup-phase3");
         coreneuron::phase_wrapper<coreneuron::phase::three>(userParams, !corenrn_file_mode);
+    }
 
     *mindelay = set_mindelay(*mindelay);
 
@@ -548,6 +643,8 @@ void nrn_setup(const char* filesdat,
     /// which is only executed by StochKV.c.
     nrn_mk_table_check();  // was done in nrn_thread_memblist_setup in multicore.c
 
+    report_setup_step_times();
+
     size_t model_size_bytes;
 
     if (corenrn_param.model_stats) {
@@ -70,49 +70,48 @@ void Phase1::populate(NrnThread& nt, OMP_Mutex& mut) {
         nt.presyns = new PreSyn[nt.n_presyn];
     }
 
+    // Note that the negative (type, index)
+    // coded information goes into the neg_gid2out[tid] hash table.
+    // See netpar.cpp for the netpar_tid_... function implementations.
+    // Both that table and the process wide gid2out table can be deleted
+    // before the end of setup
+
+    /// Put negative gids into the thread's own map, which needs no lock, and
+    /// collect the output PreSyn so that the threads take the mutex only once
+    /// each to merge them into the process wide gid2out hash table.
+    std::vector<std::pair<int, PreSyn*>> outputs;
+    outputs.reserve(this->output_gids.size());
     PreSyn* ps = nt.presyns;
     /// go through all presyns
     for (auto& gid: this->output_gids) {
-        if (gid == -1) {
-            ++ps;
-            continue;
+        if (gid >= 0) {
+            ps->gid_ = gid;
+            ps->output_index_ = gid;
+            outputs.emplace_back(gid, ps);
+        } else if (gid != -1) {
+            nrn_assert(neg_gid2out[nt.id].find(gid) == neg_gid2out[nt.id].end());
+            ps->output_index_ = -1;
+            neg_gid2out[nt.id][gid] = ps;
         }
-
-        {
-            const std::lock_guard<OMP_Mutex> lock(mut);
-            // Note that the negative (type, index)
-            // coded information goes into the neg_gid2out[tid] hash table.
-            // See netpar.cpp for the netpar_tid_... function implementations.
-            // Both that table and the process wide gid2out table can be deleted
-            // before the end of setup
-
-            /// Put gid into the gid2out hash table with correspondent output PreSyn
-            /// Or to the negative PreSyn map
-            if (gid >= 0) {
-                if (gid2in.find(gid) != gid2in.end()) {
-                    auto const m = "gid=" + std::to_string(gid) +
-                                   " already exists as an input port";
-                    hoc_execerror(m.c_str(),
-                                  "Setup all the output ports on this process before using them as "
-                                  "input ports.");
-                }
-                if (gid2out.find(gid) != gid2out.end()) {
-                    auto const m = "gid=" + std::to_string(gid) +
-                                   " already exists on this process as an output port";
-                    hoc_execerror(m.c_str(), nullptr);
-                }
-                ps->gid_ = gid;
-                ps->output_index_ = gid;
-                gid2out[gid] = ps;
-            } else {
-                nrn_assert(neg_gid2out[nt.id].find(gid) == neg_gid2out[nt.id].end());
-                ps->output_index_ = -1;
-                neg_gid2out[nt.id][gid] = ps;
-            }
-        }  // end of the mutex
-
         ++ps;
     }
+
+    const std::lock_guard<OMP_Mutex> lock(mut);
+    for (const auto& output: outputs) {
+        int gid = output.first;
+        if (gid2in.find(gid) != gid2in.end()) {
+            auto const m = "gid=" + std::to_string(gid) + " already exists as an input port";
+            hoc_execerror(m.c_str(),
+                          "Setup all the output ports on this process before using them as "
+                          "input ports.");
+        }
+        /// Put gid into the gid2out hash table with correspondent output PreSyn
+        if (!gid2out.emplace(gid, output.second).second) {
+            auto const m = "gid=" + std::to_string(gid) +
+                           " already exists on this process as an output port";
+            hoc_execerror(m.c_str(), nullptr);
+        }
+    }
 }
 
 }  // namespace coreneuron
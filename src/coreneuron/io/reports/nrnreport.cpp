@@ -13,11 +13,13 @@
 #include <set>
 #include <cmath>
 
+#include "coreneuron/apps/corenrn_parameters.hpp"
 #include "coreneuron/network/netcon.hpp"
 #include "coreneuron/utils/nrn_assert.h"
 #include "coreneuron/network/netcvode.hpp"
 #include "coreneuron/sim/multicore.hpp"
 #include "coreneuron/io/reports/nrnreport.hpp"
+#include "coreneuron/io/reports/report_writer.hpp"
 #include "coreneuron/io/nrnsection_mapping.hpp"
 #include "coreneuron/mechanism/mech_mapping.hpp"
 #include "coreneuron/mechanism/membfunc.hpp"
@@ -34,6 +36,10 @@ static int size_report_buffer = 4;
 void nrn_flush_reports(double t) {
     // flush before buffer is full
 #ifdef ENABLE_SONATA_REPORTS
+    if (report_writer) {
+        report_writer->flush(t);
+        return;
+    }
     sonata_check_and_flush(t);
 #endif
 }
@@ -63,8 +69,41 @@ void set_report_buffer_size(int n) {
 #endif
 }
 
+/** Record report steps on a background thread, buffering up to num_slots
+ *  steps. Must be called before the reports are created.
+ */
+void setup_report_writer(int num_slots) {
+#ifdef ENABLE_SONATA_REPORTS
+    // flushing uses MPI, which only the main thread may call
+    report_writer = std::make_unique<ReportWriter>(num_slots, !corenrn_param.mpi_enable);
+#endif
+}
+
 void finalize_report() {
 #ifdef ENABLE_SONATA_REPORTS
+    if (report_writer) {
+        report_writer->finalize(nrn_threads[0]._t);
+        const auto& stats = report_writer->stats();
+        double stall_time = stats.stall_time;
+        double drain_time = stats.drain_time;
+        double num_stalls = stats.num_stalls;
+#if NRNMPI
+        if (corenrn_param.mpi_enable) {
+            stall_time = nrnmpi_dbl_allmax(stall_time);
+            drain_time = nrnmpi_dbl_allmax(drain_time);
+            num_stalls = nrnmpi_dbl_allmax(num_stalls);
+        }
+#endif
+        if (nrnmpi_myid == 0 && !corenrn_param.is_quiet()) {
+            printf(" Report writer: stalled %.0lf times for %.2lf seconds, waited %.2lf seconds "
+                   "before flushes (max over ranks)\n",
+                   num_stalls,
+                   stall_time,
+                   drain_time);
+        }
+        report_writer.reset();
+        return;
+    }
     sonata_flush(nrn_threads[0]._t);
 #endif
 }
@@ -268,6 +268,7 @@ std::vector<ReportConfiguration> create_report_configurations(const std::string&
 void finalize_report();
 void nrn_flush_reports(double t);
 void set_report_buffer_size(int n);
+void setup_report_writer(int num_slots);
 
 }  // namespace coreneuron
 
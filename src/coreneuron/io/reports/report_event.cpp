@@ -41,110 +41,187 @@ ReportEvent::ReportEvent(double dt,
         gids_to_report.push_back(gid.first);
     }
     std::sort(gids_to_report.begin(), gids_to_report.end());
+    if (report_writer) {
+        pending_step = step;
+        for (int gid: gids_to_report) {
+            for (const auto& var: vars_to_report[gid]) {
+                sources.push_back(var.var_value);
+            }
+        }
+        // libsonata keeps the addresses, staging must not be resized after this
+        staging.resize(sources.size());
+        double* staged = staging.data();
+        for (int gid: gids_to_report) {
+            auto& vars = staged_vars[gid];
+            for (const auto& var: vars_to_report[gid]) {
+                vars.emplace_back(var.id, staged++);
+            }
+        }
+        report_writer->add(this);
+    }
 }
 
-// Compute and store the weighted sum of currents for each segment,
-// then compute the soma total as the sum of its segments' currents.
-// This function assumes that nt->summation_report_handler_ and vars_to_report are properly
-// populated.
-
-void ReportEvent::summation_alu(NrnThread* nt) {
-    auto& summation_report = nt->summation_report_handler_->summation_reports_[report_path];
-    const auto weighted_sum_accumulator = [](double acc, const auto& pair) {
-        // pair.first is a pointer to the current value,
-        // pair.second is the scaling factor
-        return acc + (*pair.first) * pair.second;
+// The currents are flattened in the order of the setup maps, so that the sums
+// are computed with the same operations as from the maps.
+void ReportEvent::freeze_currents(const NrnThread& nt) {
+    if (report_type != ReportType::Summation && report_type != ReportType::LFP) {
+        return;
+    }
+    auto& summation_report = nt.summation_report_handler_->summation_reports_[report_path];
+    const auto add_row = [&](int segment_id) {
+        segment_ids.push_back(segment_id);
+        const auto it = summation_report.currents_.find(segment_id);
+        if (it != summation_report.currents_.end()) {
+            for (const auto& [ptr, scale]: it->second) {
+                current_ptr.push_back(ptr);
+                current_scale.push_back(scale);
+            }
+        }
+        current_offset.push_back(current_ptr.size());
     };
+    current_offset.assign(1, 0);
 
-    // Calculate weighted sum of currents for each segment using std::accumulate
-    for (const auto& [segment_id, current_pairs]: summation_report.currents_) {
-        double sum = std::accumulate(current_pairs.begin(),
-                                     current_pairs.end(),
-                                     0.0,
-                                     weighted_sum_accumulator);
-
-        summation_report.summation_[segment_id] = sum;
+    if (report_type == ReportType::Summation) {
+        // summation_ is sized for the thread before the report event is created
+        summation = summation_report.summation_.data();
+        for (const auto& kv: summation_report.currents_) {
+            add_row(kv.first);
+        }
+        soma_offset.assign(1, 0);
+        for (const auto& [gid, gid_segment_ids]: summation_report.gid_segments_) {
+            soma_segment_ids.insert(soma_segment_ids.end(),
+                                    gid_segment_ids.begin(),
+                                    gid_segment_ids.end());
+            soma_offset.push_back(soma_segment_ids.size());
+            soma_output.push_back(vars_to_report[gid].front().var_value);
+        }
+        return;
     }
 
-    // Calculate the soma total current by summing over its segments using std::accumulate
-    if (!summation_report.gid_segments_.empty()) {
-        const auto accumulator = [&summation_report](double acc, int segment_id) {
-            return acc + summation_report.summation_[segment_id];
-        };
-        for (const auto& [gid, segment_ids]: summation_report.gid_segments_) {
-            double sum_soma =
-                std::accumulate(segment_ids.begin(), segment_ids.end(), 0.0, accumulator);
+    const auto* mapinfo = static_cast<NrnThreadMappingInfo*>(nt.mapping);
+    std::size_t max_electrodes = 0;
+    for (int gid: gids_to_report) {
+        const auto& outputs = vars_to_report[gid];
+        const auto& cell_mapping = mapinfo->get_cell_mapping(gid);
+        LfpCell cell{};
+        cell.first_row = segment_ids.size();
+        for (int segment_id: cell_mapping->lfp_segment_ids) {
+            add_row(segment_id);
+        }
+        cell.last_row = segment_ids.size();
+        cell.factors = cell_mapping->lfp_factors_flat.data();
+        cell.n_electrodes = cell_mapping->num_electrodes();
+        // only the electrodes of this report are computed
+        const auto [first, last] = std::minmax_element(
+            outputs.begin(), outputs.end(), [](const auto& a, const auto& b) {
+                return a.id < b.id;
+            });
+        cell.first_electrode = first->id;
+        nrn_assert(cell.last_row == cell.first_row || last->id < cell.n_electrodes);
+        cell.n_reported = last->id - first->id + 1;
+        max_electrodes = std::max(max_electrodes, cell.n_reported);
+        cell.outputs = outputs;
+        lfp_cells.push_back(std::move(cell));
+    }
+    lfp_values.resize(max_electrodes);
+}
 
-            *(vars_to_report[gid].front().var_value) = sum_soma;
+// Compute and store the weighted sum of currents for each segment,
+// then compute the soma total as the sum of its segments' currents.
+// This function assumes that freeze_currents was called after the
+// nt->summation_report_handler_ and vars_to_report were populated.
+void ReportEvent::summation_alu() {
+    for (std::size_t r = 0; r < segment_ids.size(); ++r) {
+        summation[segment_ids[r]] = current_sum(r, 0.0);
+    }
+    for (std::size_t c = 0; c < soma_output.size(); ++c) {
+        double sum_soma = 0.0;
+        for (auto k = soma_offset[c]; k < soma_offset[c + 1]; ++k) {
+            sum_soma += summation[soma_segment_ids[k]];
         }
+        *soma_output[c] = sum_soma;
     }
 }
 
 /** @brief Compute Local Field Potentials (LFP) for each cell.
  *
  * For every segment of a cell, computes the total membrane current (imem + iclamp)
- * and accumulates the weighted contribution to each electrode using precomputed
- * transfer factors. Results are written into the report output buffers.
+ * and accumulates the weighted contribution to each reported electrode using
+ * precomputed transfer factors. Results are written into the report output buffers.
  */
 void ReportEvent::lfp_calc(NrnThread* nt) {
-    auto* mapinfo = static_cast<NrnThreadMappingInfo*>(nt->mapping);
-    double* fast_imem_rhs = nt->nrn_fast_imem->nrn_sav_rhs;
-    auto& summation_report = nt->summation_report_handler_->summation_reports_[report_path];
-    for (const auto& kv: vars_to_report) {
-        int gid = kv.first;
-        const auto& electrode_outputs = kv.second;
-        const auto& cell_mapping = mapinfo->get_cell_mapping(gid);
-        const auto n_electrodes = cell_mapping->num_electrodes();
-        const auto n_segments = cell_mapping->lfp_segment_ids.size();
-        std::vector<double> lfp_values(n_electrodes, 0.0);
-        for (size_t i = 0; i < n_segments; i++) {
-            const auto segment_id = cell_mapping->lfp_segment_ids[i];
-
+    const double* fast_imem_rhs = nt->nrn_fast_imem->nrn_sav_rhs;
+    double* values = lfp_values.data();
+    for (const auto& cell: lfp_cells) {
+        std::fill_n(values, cell.n_reported, 0.0);
+        const double* factors = cell.factors + cell.first_electrode;
+        for (auto r = cell.first_row; r < cell.last_row; ++r, factors += cell.n_electrodes) {
             // compute imem + iclamp
-            const double imem = std::accumulate(summation_report.currents_[segment_id].begin(),
-                                                summation_report.currents_[segment_id].end(),
-                                                fast_imem_rhs[segment_id],
-                                                [](double sum, const auto& value) {
-                                                    return sum + *value.first * value.second;
-                                                });
-
+            const double imem = current_sum(r, fast_imem_rhs[segment_ids[r]]);
             // dot product with the factors
-            const double* factors = &cell_mapping->lfp_factors_flat[i * n_electrodes];
-            for (size_t e = 0; e < n_electrodes; e++) {
-                lfp_values[e] += imem * factors[e];
+            for (std::size_t e = 0; e < cell.n_reported; e++) {
+                values[e] += imem * factors[e];
             }
         }
 
         // write LFP values to report output buffers
-        for (const auto& output: electrode_outputs) {
-            *(output.var_value) = lfp_values[output.id];
+        for (const auto& output: cell.outputs) {
+            *(output.var_value) = values[output.id - cell.first_electrode];
         }
     }
 }
 
 /** on deliver, call ReportingLib and setup next event */
 void ReportEvent::deliver(double t, NetCvode* nc, NrnThread* nt) {
+    // Sum currents and calculate lfp only on reporting steps, from the data of
+    // this thread only
+    const bool reporting_step = (static_cast<int>(step) % reporting_period) == 0;
+    if (reporting_step) {
+        if (report_type == ReportType::Summation) {
+            summation_alu();
+        } else if (report_type == ReportType::LFP) {
+            lfp_calc(nt);
+        }
+    }
+    if (report_writer) {
+        // Only copy the values, the writer thread calls libsonata
+        if (reporting_step) {
+            report_writer->push(this, pending_step, step, sources);
+            pending_step = step + 1;
+        }
+    } else {
 /* libsonata is not thread safe */
 #pragma omp critical
-    {
-        // Sum currents and calculate lfp only on reporting steps
-        if ((static_cast<int>(step) % reporting_period) == 0) {
-            if (report_type == ReportType::Summation) {
-                summation_alu(nt);
-            } else if (report_type == ReportType::LFP) {
-                lfp_calc(nt);
-            }
+        {
+            // each thread needs to know its own step
+            record_node_data(step);
         }
-        // each thread needs to know its own step
-#ifdef ENABLE_SONATA_REPORTS
-        sonata_record_node_data(step,
-                                gids_to_report.size(),
-                                gids_to_report.data(),
-                                report_path.data());
-#endif
-        send(t + dt, nc, nt);
-        step++;
     }
+    send(t + dt, nc, nt);
+    step++;
+}
+
+void ReportEvent::push_pending_steps() {
+    if (pending_step < step) {
+        report_writer->push(this, pending_step, step - 1, sources, false);
+        pending_step = step;
+    }
+}
+
+void ReportEvent::record_steps(double first_step, double last_step, const double* values) {
+    // As for the summation and LFP values computed in deliver, the values are
+    // only updated on reporting steps, libsonata does not read them in between.
+    for (double s = first_step; s < last_step; s += 1.0) {
+        record_node_data(s);
+    }
+    if (values) {
+        std::copy(values, values + staging.size(), staging.begin());
+    }
+    record_node_data(last_step);
+}
+
+void ReportEvent::record_node_data(double step) {
+    sonata_record_node_data(step, gids_to_report.size(), gids_to_report.data(), report_path.data());
 }
 
 bool ReportEvent::require_checkpoint() {
@@ -15,6 +15,7 @@
 
 #include "coreneuron/network/netcon.hpp"
 #include "coreneuron/network/netcvode.hpp"
+#include "coreneuron/io/reports/report_writer.hpp"
 
 namespace coreneuron {
 
@@ -42,12 +43,35 @@ class ReportEvent: public DiscreteEvent {
     /** on deliver, call libsonata and setup next event */
     void deliver(double t, NetCvode* nc, NrnThread* nt) override;
     bool require_checkpoint() override;
-    void summation_alu(NrnThread* nt);
+    /** Freeze the currents summed by a summation or LFP report into flat
+     *  arrays, once the report handler has set them up for the thread nt.
+     */
+    void freeze_currents(const NrnThread& nt);
+    void summation_alu();
     void lfp_calc(NrnThread* nt);
     int type() const override {
         return ReportEventType;
     }
 
+    /** The variables to register with libsonata: the reported variables, or
+     *  with the asynchronous report writer, the staging buffer they are
+     *  copied to by record_steps.
+     */
+    const VarsToReport& registered_vars() const noexcept {
+        return report_writer ? staged_vars : vars_to_report;
+    }
+    /** Queue the steps since the last reporting step to the report writer. */
+    void push_pending_steps();
+    /** Record steps first_step .. last_step, called by the report writer.
+     *  \param values the values of last_step, or nullptr if the values
+     *  of the previous reporting step are still current
+     */
+    void record_steps(double first_step, double last_step, const double* values);
+
+  protected:
+    /** Hand the registered variables of a step to libsonata. */
+    virtual void record_node_data(double step);
+
   private:
     double dt;
     double step;
@@ -58,6 +82,44 @@ class ReportEvent: public DiscreteEvent {
     double tstart;
     VarsToReport vars_to_report;
     ReportType report_type;
+    /// with the report writer: the reported variables in gids_to_report order,
+    /// the buffer libsonata reads them from and the first step not queued yet
+    std::vector<double*> sources;
+    std::vector<double> staging;
+    VarsToReport staged_vars;
+    double pending_step;
+    /// summation and LFP: the weighted sum of currents of segment_ids[r] is
+    /// the sum of *current_ptr[k] * current_scale[k] for k in
+    /// [current_offset[r], current_offset[r + 1])
+    std::vector<int> segment_ids;
+    std::vector<std::size_t> current_offset;
+    std::vector<double*> current_ptr;
+    std::vector<double> current_scale;
+    /// summation: the sums per segment and, for soma reports, the segments
+    /// soma_output[c] sums in the same form
+    double* summation = nullptr;
+    std::vector<std::size_t> soma_offset;
+    std::vector<int> soma_segment_ids;
+    std::vector<double*> soma_output;
+    /// LFP: the rows of segment_ids of a cell and the electrodes it reports
+    struct LfpCell {
+        std::size_t first_row;
+        std::size_t last_row;
+        const double* factors;
+        std::size_t n_electrodes;
+        std::size_t first_electrode;
+        std::size_t n_reported;
+        std::vector<VarWithMapping> outputs;
+    };
+    std::vector<LfpCell> lfp_cells;
+    std::vector<double> lfp_values;
+
+    double current_sum(std::size_t row, double sum) const {
+        for (auto k = current_offset[row]; k < current_offset[row + 1]; ++k) {
+            sum += *current_ptr[k] * current_scale[k];
+        }
+        return sum;
+    }
 };
 #endif
 
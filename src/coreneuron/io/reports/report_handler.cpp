@@ -670,21 +670,20 @@ void ReportHandler::create_report(ReportConfiguration& report_config,
         const std::vector<int> intersection_ids = get_intersection_ids(nt, report_config.target);
         VarsToReport vars_to_report;
         const bool is_soma_target = report_config.sections == SectionType::Soma;
+        bool is_custom_report = false;
         switch (report_config.type) {
         case ReportType::Compartment: {
             vars_to_report = get_section_vars_to_report(nt, intersection_ids, report_config);
-            register_section_report(nt, report_config, vars_to_report, is_soma_target);
             break;
         }
         case ReportType::CompartmentSet: {
             vars_to_report =
                 get_compartment_set_vars_to_report(nt, intersection_ids, report_config);
-            register_section_report(nt, report_config, vars_to_report, is_soma_target);
             break;
         }
         case ReportType::Summation: {
             vars_to_report = get_summation_vars_to_report(nt, intersection_ids, report_config);
-            register_custom_report(nt, report_config, vars_to_report);
+            is_custom_report = true;
             break;
         }
         case ReportType::LFP: {
@@ -694,12 +693,11 @@ void ReportHandler::create_report(ReportConfiguration& report_config,
                                                     report_config,
                                                     mapinfo->_lfp.data(),
                                                     report_config.lfp_report_index);
-            register_section_report(nt, report_config, vars_to_report, is_soma_target);
             break;
         }
         case ReportType::Synapse: {
             vars_to_report = get_synapse_vars_to_report(nt, intersection_ids, report_config);
-            register_custom_report(nt, report_config, vars_to_report);
+            is_custom_report = true;
             break;
         }
         default: {
@@ -708,13 +706,27 @@ void ReportHandler::create_report(ReportConfiguration& report_config,
         }
         }
 
+        std::unique_ptr<ReportEvent> report_event;
         if (!vars_to_report.empty()) {
-            auto report_event = std::make_unique<ReportEvent>(dt,
-                                                              t,
-                                                              vars_to_report,
-                                                              report_config.output_path.data(),
-                                                              report_config.report_dt,
-                                                              report_config.type);
+            report_event = std::make_unique<ReportEvent>(dt,
+                                                         t,
+                                                         vars_to_report,
+                                                         report_config.output_path.data(),
+                                                         report_config.report_dt,
+                                                         report_config.type);
+            report_event->freeze_currents(nt);
+        }
+        // with the asynchronous report writer libsonata reads the values from
+        // the staging buffer of the report event
+        const VarsToReport& registered_vars = report_event ? report_event->registered_vars()
+                                                           : vars_to_report;
+        if (is_custom_report) {
+            register_custom_report(nt, report_config, registered_vars);
+        } else {
+            register_section_report(nt, report_config, registered_vars, is_soma_target);
+        }
+
+        if (report_event) {
             report_event->send(t, net_cvode_instance, &nt);
             m_report_events.push_back(std::move(report_event));
         }
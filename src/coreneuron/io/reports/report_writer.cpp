@@ -0,0 +1,146 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2021 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================
+*/
+
+#include "coreneuron/io/reports/report_writer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "coreneuron/io/reports/report_event.hpp"
+#include "coreneuron/utils/nrn_assert.h"
+#ifdef ENABLE_SONATA_REPORTS
+#include "bbp/sonata/reports.h"
+#endif  // ENABLE_SONATA_REPORTS
+
+namespace coreneuron {
+
+#ifdef ENABLE_SONATA_REPORTS
+std::unique_ptr<ReportWriter> report_writer;
+
+ReportWriter::ReportWriter(std::size_t num_slots, bool flush_in_writer)
+    : ring_(num_slots)
+    , flush_in_writer_(flush_in_writer) {
+    nrn_assert(num_slots > 0);
+    thread_ = std::thread(&ReportWriter::run, this);
+}
+
+ReportWriter::~ReportWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    slot_used_.notify_one();
+    thread_.join();
+}
+
+void ReportWriter::add(ReportEvent* report) {
+    reports_.push_back(report);
+}
+
+ReportWriter::Slot& ReportWriter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (used_ == ring_.size()) {
+        const auto start = std::chrono::steady_clock::now();
+        slot_free_.wait(lock, [this] { return used_ < ring_.size(); });
+        const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+        stats_.stall_time += waited.count();
+        ++stats_.num_stalls;
+    }
+    Slot& slot = ring_[(head_ + used_) % ring_.size()];
+    ++used_;
+    stats_.max_used = std::max(stats_.max_used, used_);
+    return slot;
+}
+
+void ReportWriter::publish(Slot& slot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.ready = true;
+    }
+    slot_used_.notify_one();
+}
+
+void ReportWriter::push(ReportEvent* report,
+                        double first_step,
+                        double last_step,
+                        const std::vector<double*>& sources,
+                        bool with_values) {
+    Slot& slot = acquire();
+    // the slot is ours until it is published, fill it without the lock
+    slot.report = report;
+    slot.first_step = first_step;
+    slot.last_step = last_step;
+    slot.has_values = with_values;
+    if (with_values) {
+        slot.values.resize(sources.size());
+        std::transform(sources.begin(), sources.end(), slot.values.begin(), [](const double* v) {
+            return *v;
+        });
+    }
+    publish(slot);
+}
+
+void ReportWriter::drain() {
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    slot_free_.wait(lock, [this] { return used_ == 0; });
+    const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+    stats_.drain_time += waited.count();
+}
+
+void ReportWriter::flush(double t) {
+    // called between integration intervals, no thread is delivering report events
+    for (auto* report: reports_) {
+        report->push_pending_steps();
+    }
+    if (flush_in_writer_) {
+        Slot& slot = acquire();
+        slot.report = nullptr;
+        slot.t = t;
+        publish(slot);
+    } else {
+        drain();
+        sonata_check_and_flush(t);
+    }
+}
+
+void ReportWriter::finalize(double t) {
+    for (auto* report: reports_) {
+        report->push_pending_steps();
+    }
+    drain();
+    sonata_flush(t);
+}
+
+void ReportWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        slot_used_.wait(lock, [this] { return stop_ || (used_ && ring_[head_].ready); });
+        if (!used_ || !ring_[head_].ready) {
+            return;
+        }
+        Slot& slot = ring_[head_];
+        lock.unlock();
+        if (slot.report) {
+            slot.report->record_steps(slot.first_step,
+                                      slot.last_step,
+                                      slot.has_values ? slot.values.data() : nullptr);
+        } else {
+            sonata_check_and_flush(slot.t);
+        }
+        lock.lock();
+        slot.ready = false;
+        head_ = (head_ + 1) % ring_.size();
+        --used_;
+        ++stats_.num_slots;
+        slot_free_.notify_all();
+    }
+}
+#endif  // ENABLE_SONATA_REPORTS
+
+}  // Namespace coreneuron
@@ -0,0 +1,124 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2021 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coreneuron {
+
+#ifdef ENABLE_SONATA_REPORTS
+class ReportEvent;
+
+/**
+ * \brief Records report steps into libsonata on a background thread.
+ *
+ * On a reporting step, ReportEvent::deliver copies the reported values into
+ * a slot of a bounded ring and continues with the simulation. The writer
+ * thread moves the values of each slot into the staging buffer that was
+ * registered with libsonata for the report and records the step. When all
+ * the slots are in use, deliver waits for the writer (back-pressure) and
+ * the time waited is accounted as stall time.
+ *
+ * libsonata is not thread safe, so once reports are set up it is only used
+ * by the writer thread or while the writer is idle. Flushing writes the
+ * report files with MPI collectives, and as MPI is initialized with
+ * MPI_THREAD_FUNNELED, flush() drains the ring and flushes on the calling
+ * (main) thread when MPI is enabled. Without MPI the flush is queued and
+ * done by the writer as well.
+ */
+class ReportWriter {
+  public:
+    struct Stats {
+        /// Time the simulation threads waited for a free slot (s), summed over threads
+        double stall_time = 0.0;
+        /// Number of times a simulation thread had to wait for a free slot
+        std::size_t num_stalls = 0;
+        /// Time the main thread waited for the writer before flushing (s)
+        double drain_time = 0.0;
+        /// Number of slots the writer recorded
+        std::size_t num_slots = 0;
+        /// Largest number of slots in use at the same time
+        std::size_t max_used = 0;
+    };
+
+    /**
+     * \param num_slots capacity of the ring, at least 1
+     * \param flush_in_writer whether the writer thread does the flushes
+     */
+    ReportWriter(std::size_t num_slots, bool flush_in_writer);
+    /// Flushes nothing, finalize() must have been called if anything was recorded
+    ~ReportWriter();
+
+    /** Register a report whose steps go through the writer. */
+    void add(ReportEvent* report);
+
+    /**
+     * Queue steps first_step .. last_step of a report.
+     * \param report the report, registered with add()
+     * \param sources the reported variables, copied into the slot
+     * \param with_values false if last_step is not a reporting step and
+     * sources are not copied
+     */
+    void push(ReportEvent* report,
+              double first_step,
+              double last_step,
+              const std::vector<double*>& sources,
+              bool with_values = true);
+
+    /** Flush the reports up to time t. Called by the main thread. */
+    void flush(double t);
+
+    /** Record the last steps and flush everything at time t. Called by the main thread. */
+    void finalize(double t);
+
+    const Stats& stats() const noexcept {
+        return stats_;
+    }
+
+  private:
+    struct Slot {
+        ReportEvent* report = nullptr;
+        double first_step = 0.0;
+        double last_step = 0.0;
+        /// a slot without a report is a flush at time t
+        double t = 0.0;
+        bool has_values = false;
+        /// filled, the writer can take it
+        bool ready = false;
+        std::vector<double> values;
+    };
+
+    Slot& acquire();
+    void publish(Slot& slot);
+    void drain();
+    void run();
+
+    std::vector<Slot> ring_;
+    std::size_t head_ = 0;  /// next slot the writer takes
+    std::size_t used_ = 0;  /// number of slots being filled, queued or being written
+    bool stop_ = false;
+    const bool flush_in_writer_;
+    std::vector<ReportEvent*> reports_;
+    Stats stats_;
+    std::mutex mutex_;
+    std::condition_variable slot_free_;
+    std::condition_variable slot_used_;
+    std::thread thread_;
+};
+
+/// The report writer, nullptr if report steps are recorded by the simulation threads
+extern std::unique_ptr<ReportWriter> report_writer;
+#endif  // ENABLE_SONATA_REPORTS
+
+}  // Namespace coreneuron
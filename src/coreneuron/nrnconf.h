@@ -47,6 +47,7 @@ extern const char* bbcore_write_version;
 extern void* nrn_cacheline_alloc(void** memptr, size_t size);
 extern void* emalloc_align(size_t size, size_t alignment);
 extern void* ecalloc_align(size_t n, size_t size, size_t alignment);
+extern bool bbcore_read_version_supported(const char*);
 extern void check_bbcore_write_version(const char*);
 
 
@@ -41,6 +41,20 @@ namespace neuron {
 #endif
 int interleave_permute_type;
 InterleaveInfo* interleave_info;  // nrn_nthread array
+#if !CORENRN_BUILD
+int interleave_simd;
+
+// For the lockstep solve of interleave_permute_type 1 on the CPU: the nodes
+// of a thread after the roots split into runs within a level, each solved by
+// one simd loop. The parent of node i of a run is i + parent_offset, or
+// _v_parent_index[i] if parent_offset is 0.
+struct LevelRun {
+    int begin;
+    int end;
+    int parent_offset;
+};
+static std::vector<std::vector<LevelRun>> level_runs;  // nrn_nthread array
+#endif
 
 
 void InterleaveInfo::swap(InterleaveInfo& info) {
@@ -422,7 +436,39 @@ std::vector<int> interleave_order(int ith, int ncell, int nnode, int* parent) {
 }
 
 #if !CORENRN_BUILD
+// Identical cells are adjacent in the interleaved order, so their nodes of a
+// level have parents at a constant offset. Runs shorter than a simd vector
+// are merged into gather runs.
+static std::vector<LevelRun> make_level_runs(NrnThread& nt, InterleaveInfo& ii) {
+    constexpr int min_run = 8;
+    const int* parent = nt._v_parent_index;
+    std::vector<LevelRun> runs;
+    int i = nt.ncell;
+    for (int istride = 0; istride < ii.nstride; ++istride) {
+        const int level_end = i + ii.stride[istride];
+        const auto level_first_run = runs.size();
+        while (i < level_end) {
+            const int offset = parent[i] - i;
+            int j = i + 1;
+            while (j < level_end && parent[j] - j == offset) {
+                ++j;
+            }
+            if (j - i >= min_run) {
+                runs.push_back({i, j, offset});
+            } else if (runs.size() > level_first_run && runs.back().parent_offset == 0) {
+                runs.back().end = j;
+            } else {
+                runs.push_back({i, j, 0});
+            }
+            i = j;
+        }
+    }
+    nrn_assert(i == nt.end);
+    return runs;
+}
+
 void nrn_permute_node_order() {
+    level_runs.clear();
     if (!interleave_permute_type) {
         return;
     }
@@ -457,6 +503,12 @@ void nrn_permute_node_order() {
         }
         //        prnode("after perm", nt);
     }
+    if (interleave_permute_type == 1) {
+        level_runs.resize(nrn_nthread);
+        for (int tid = 0; tid < nrn_nthread; ++tid) {
+            level_runs[tid] = make_level_runs(nrn_threads[tid], interleave_info[tid]);
+        }
+    }
     //    printf("leave nrn_permute_node_order\n");
 }
 #endif  // !CORENRN_BUILD
@@ -810,10 +862,83 @@ void solve_interleaved1(int ith) {
     nrn_pragma_acc(wait(nt->stream_id))
 }
 
+#if !CORENRN_BUILD
+/**
+ * \brief Solve the Hines matrices of all the cells of a thread in lockstep.
+ *
+ * With interleave_permute_type == 1, the nodes of a level, one per cell, are
+ * adjacent and do not depend on each other, so the level is one simd loop
+ * over the cells instead of solve_interleaved1 solving one cell after the
+ * other. The parent of a node is always in an earlier level and the updates
+ * of a parent come in the same order, so the results are the same.
+ */
+static void solve_interleaved_simd(int ith) {
+    NrnThread* nt = nrn_threads + ith;
+    auto* const vec_a = nt->node_a_storage();
+    auto* const vec_b = nt->node_b_storage();
+    auto* const vec_d = nt->node_d_storage();
+    auto* const vec_rhs = nt->node_rhs_storage();
+    const int* const parent = nt->_v_parent_index;
+    const auto& runs = level_runs[ith];
+
+    // triangularization, from the last level to the first
+    for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+        const int begin = run->begin;
+        const int end = run->end;
+        if (const int offset = run->parent_offset) {
+            nrn_pragma_omp(simd)
+            for (int i = begin; i < end; ++i) {
+                double p = vec_a[i] / vec_d[i];
+                vec_d[i + offset] -= p * vec_b[i];
+                vec_rhs[i + offset] -= p * vec_rhs[i];
+            }
+        } else {
+            nrn_pragma_omp(simd)
+            for (int i = begin; i < end; ++i) {
+                int ip = parent[i];
+                double p = vec_a[i] / vec_d[i];
+                vec_d[ip] -= p * vec_b[i];
+                vec_rhs[ip] -= p * vec_rhs[i];
+            }
+        }
+    }
+
+    // back substitution, from the roots to the last level
+    const int ncell = nt->ncell;
+    nrn_pragma_omp(simd)
+    for (int i = 0; i < ncell; ++i) {
+        vec_rhs[i] /= vec_d[i];
+    }
+    for (const auto& run: runs) {
+        const int begin = run.begin;
+        const int end = run.end;
+        if (const int offset = run.parent_offset) {
+            nrn_pragma_omp(simd)
+            for (int i = begin; i < end; ++i) {
+                vec_rhs[i] -= vec_b[i] * vec_rhs[i + offset];
+                vec_rhs[i] /= vec_d[i];
+            }
+        } else {
+            nrn_pragma_omp(simd)
+            for (int i = begin; i < end; ++i) {
+                vec_rhs[i] -= vec_b[i] * vec_rhs[parent[i]];
+                vec_rhs[i] /= vec_d[i];
+            }
+        }
+    }
+}
+#endif
+
 void solve_interleaved(int ith) {
     if (interleave_permute_type != 1) {
         solve_interleaved2(ith);
     } else {
+#if !CORENRN_BUILD
+        if (interleave_simd) {
+            solve_interleaved_simd(ith);
+            return;
+        }
+#endif
         solve_interleaved1(ith);
     }
 }
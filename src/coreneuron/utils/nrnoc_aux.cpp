@@ -21,7 +21,10 @@ int v_structure_change;
 int diam_changed;
 #define MAXERRCOUNT 5
 int hoc_errno_count;
-const char* bbcore_write_version = "1.8";  // Include ArrayDims
+const char* bbcore_write_version = "1.9";  // Align arrays after chkpnt lines
+// Earlier versions that are still read. 1.8 only lacks the chkpnt line
+// padding, which the reader does not rely on.
+static const char* bbcore_read_versions[] = {"1.8"};
 
 char* pnt_name(Point_process* pnt) {
     return corenrn.get_memb_func(pnt->_type).sym;
@@ -122,11 +125,23 @@ double hoc_Exp(double x) {
     return exp(x);
 }
 
+bool bbcore_read_version_supported(const char* version) {
+    if (strcmp(version, bbcore_write_version) == 0) {
+        return true;
+    }
+    for (const char* v: bbcore_read_versions) {
+        if (strcmp(version, v) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /* check for version bbcore_write version between NEURON and CoreNEURON
  * abort in case of missmatch
  */
 void check_bbcore_write_version(const char* version) {
-    if (strcmp(version, bbcore_write_version) != 0) {
+    if (!bbcore_read_version_supported(version)) {
         if (nrnmpi_myid == 0)
             fprintf(stderr,
                     "Error: Incompatible binary input dataset version (expected %s, input %s)\n",
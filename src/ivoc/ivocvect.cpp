@@ -114,6 +114,7 @@ static double dmaxint_ = 9007199254740992;
 extern Object* hoc_thisobject;
 extern Symlist* hoc_top_level_symlist;
 IvocVect* (*nrnpy_vec_from_python_p_)(void*);
+IvocVect* (*nrnpy_vec_from_buffer_p_)(void*);
 Object** (*nrnpy_vec_to_python_p_)(void*);
 Object** (*nrnpy_vec_as_numpy_helper_)(int, double*);
 double (*nrnpy_call_func)(Object*, double);
@@ -1369,9 +1370,16 @@ int IvocVect::buffer_size() {
 }
 
 void IvocVect::buffer_size(int n) {
+    // reserve never shrinks
+    check_exports(std::max(size_t(n), vec_.size()));
     vec_.reserve(n);
 }
 
+void IvocVect::exports_moved() const {
+    hoc_execerror(hoc_object_name(obj_),
+                  "cannot be reallocated or shrunk while exported to a Python buffer");
+}
+
 static Object** v_resize(void* v) {
     Vect* x = (Vect*) v;
     x->resize(int(chkarg(1, 0, dmaxint_)));
@@ -1396,9 +1404,24 @@ static Object** v_set(void* v) {
 }
 
 
+// the size of x after appending the arguments from i on, so that an exported
+// Vector can be checked before anything is changed
+static size_t v_size_after(Vect* x, int i) {
+    size_t n = x->size();
+    for (; ifarg(i); ++i) {
+        if (hoc_argtype(i) == NUMBER) {
+            ++n;
+        } else if (hoc_is_object_arg(i)) {
+            n += vector_arg(i)->size();
+        }
+    }
+    return n;
+}
+
 static Object** v_append(void* v) {
     Vect* x = (Vect*) v;
-    int j, i = 1;
+    int i = 1;
+    x->check_exports(v_size_after(x, i));
     while (ifarg(i)) {
         if (hoc_argtype(i) == NUMBER) {
             x->push_back(*getarg(i));
@@ -1416,37 +1439,25 @@ static Object** v_append(void* v) {
 static Object** v_insert(void* v) {
     // insert all before indx (first arg)
     Vect* x = (Vect*) v;
-    int n, j, m, i = 2;
+    int i = 2;
     int indx = (int) chkarg(1, 0, x->size());
-    m = x->size() - indx;
-    double* z;
-    if (m) {
-        z = new double[m];
-        for (j = 0; j < m; ++j) {
-            z[j] = x->elem(indx + j);
-        }
-    }
-    x->resize(indx);
+    size_t n = x->size();
+    x->check_exports(v_size_after(x, i));
+    std::vector<double> z;
     while (ifarg(i)) {
         if (hoc_argtype(i) == NUMBER) {
-            x->push_back(*getarg(i));
+            z.push_back(*getarg(i));
         } else if (hoc_is_object_arg(i)) {
             Vect* y = vector_arg(i);
             same_err("insrt", x, y);
-            n = x->size();
-            x->buffer_size(n + y->size());
-            x->vec().insert(x->end(), y->begin(), y->end());
+            z.insert(z.end(), y->begin(), y->end());
         }
         i++;
     }
-    if (m) {
-        n = x->size();
-        x->resize(n + m);
-        for (j = 0; j < m; ++j) {
-            x->elem(n + j) = z[j];
-        }
-        delete[] z;
-    }
+    // grow in place, an exported view stays valid
+    x->resize(n + z.size());
+    std::copy_backward(x->begin() + indx, x->begin() + n, x->end());
+    std::copy(z.begin(), z.end(), x->begin() + indx);
     return x->temp_objvar();
 }
 
@@ -1460,6 +1471,7 @@ static Object** v_remove(void* v) {
         end = start;
     }
     n = x->size();
+    x->check_exports(n - (end - start + 1));
     for (i = start, j = end + 1; j < n; ++i, ++j) {
         x->elem(i) = x->elem(j);
     }
@@ -3433,6 +3445,9 @@ static Object** v_resample(void* v) {
 
     for (int i = 0; i < n; i++)
         temp->elem(i) = v1->elem(int(i / f));
+    if (ans->exports_) {
+        ans->exports_moved();
+    }
     ans->vec().swap(temp->vec());
 
     delete temp;
@@ -3470,6 +3485,9 @@ static Object** v_psth(void* v) {
         temp->elem(i) = integral / trials * 1000. / ((fj + bj + 1) * dt);
     }
 
+    if (ans->exports_) {
+        ans->exports_moved();
+    }
     ans->vec().swap(temp->vec());
 
     delete temp;
@@ -3693,6 +3711,14 @@ Object** v_from_python(void* v) {
     return vec->temp_objvar();
 }
 
+Object** v_from_buffer(void* v) {
+    if (!nrnpy_vec_from_buffer_p_) {
+        hoc_execerror("Python not available", 0);
+    }
+    Vect* vec = (*nrnpy_vec_from_buffer_p_)(v);
+    return vec->temp_objvar();
+}
+
 Object** v_to_python(void* v) {
     if (!nrnpy_vec_to_python_p_) {
         hoc_execerror("Python not available", 0);
@@ -3825,6 +3851,7 @@ static Member_ret_obj_func v_retobj_members[] = {{"c", v_c},
                                                  {"play", v_play},
 
                                                  {"from_python", v_from_python},
+                                                 {"from_buffer", v_from_buffer},
                                                  {"to_python", v_to_python},
                                                  {"as_numpy", v_as_numpy},
 
@@ -44,6 +44,7 @@ class IvocVect {
     }
 
     inline void resize(size_t n) {
+        check_exports(n);
         if (n > vec_.size()) {
             notify_freed_val_array(vec_.data(), vec_.size());
         }
@@ -51,12 +52,26 @@ class IvocVect {
     }
 
     inline void resize(size_t n, double fill_value) {
+        check_exports(n);
         if (n > vec_.size()) {
             notify_freed_val_array(vec_.data(), vec_.size());
         }
         vec_.resize(n, fill_value);
     }
 
+    // whether resizing to n would move data exported to a Python buffer, or
+    // shrink the Vector so that an exported view extends past its end
+    inline bool exports_block_resize(size_t n) const {
+        return exports_ && (n > vec_.capacity() || n < vec_.size());
+    }
+    // error if exports_block_resize(n)
+    inline void check_exports(size_t n) const {
+        if (exports_block_resize(n)) {
+            exports_moved();
+        }
+    }
+    [[noreturn]] void exports_moved() const;
+
     inline double& operator[](size_t index) {
         return vec_.at(index);
     }
@@ -78,6 +93,7 @@ class IvocVect {
     }
 
     inline void push_back(double v) {
+        check_exports(vec_.size() + 1);
         vec_.push_back(v);
     }
 
@@ -101,6 +117,7 @@ class IvocVect {
     Object* obj_;  // so far only needed by record and play; not reffed
     char* label_;
     std::vector<double> vec_;  // std::vector holding data
+    int exports_{};            // live Python buffers of vec_, see nrnpy_hoc.cpp
     MUTDEC
 };
 
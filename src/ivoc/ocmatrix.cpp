@@ -24,6 +24,13 @@ static Eigen::Map<Eigen::VectorXd> Vect2VEC(Vect* v1) {
 OcMatrix::OcMatrix(int type)
     : type_(type) {}
 
+void OcMatrix::check_exports(int nrow, int ncol) const {
+    if (exports_ && (nrow != this->nrow() || ncol != this->ncol())) {
+        hoc_execerror(hoc_object_name(obj_),
+                      "cannot change shape while its data are exported to a Python buffer");
+    }
+}
+
 OcMatrix* OcMatrix::instance(int nrow, int ncol, int type) {
     switch (type) {
     default:
@@ -78,6 +85,7 @@ int OcFullMatrix::ncol() const {
 }
 
 void OcFullMatrix::resize(int i, int j) {
+    check_exports(i, j);
     // This is here because we want that new values are initialized to 0
     auto v = Eigen::MatrixXd::Zero(i, j);
     m_.conservativeResizeLike(v);
@@ -90,18 +98,22 @@ void OcFullMatrix::mulv(Vect* vin, Vect* vout) const {
 }
 
 void OcFullMatrix::mulm(Matrix* in, Matrix* out) const {
+    out->check_exports(nrow(), in->ncol());
     out->full()->m_ = m_ * in->full()->m_;
 }
 
 void OcFullMatrix::muls(double s, Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = s * m_;
 }
 
 void OcFullMatrix::add(Matrix* in, Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = m_ + in->full()->m_;
 }
 
 void OcFullMatrix::copy(Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = m_;
 }
 
@@ -110,6 +122,7 @@ void OcFullMatrix::bcopy(Matrix* out, int i0, int j0, int n0, int m0, int i1, in
 }
 
 void OcFullMatrix::transpose(Matrix* out) {
+    out->check_exports(ncol(), nrow());
     if (out->full()->m_ == m_) {
         m_.transposeInPlace();
     } else {
@@ -122,6 +135,7 @@ void OcFullMatrix::symmeigen(Matrix* mout, Vect* vout) const {
     auto v1 = Vect2VEC(vout);
     Eigen::EigenSolver<Eigen::MatrixXd> es(m_);
     v1 = es.eigenvalues().real();
+    mout->check_exports(nrow(), nrow());
     mout->full()->m_ = es.eigenvectors().real();
 }
 
@@ -130,9 +144,11 @@ void OcFullMatrix::svd1(Matrix* u, Matrix* v, Vect* d) const {
     Eigen::JacobiSVD<Eigen::MatrixXd> svd(m_, Eigen::ComputeFullU | Eigen::ComputeFullV);
     v1 = svd.singularValues();
     if (u) {
+        u->check_exports(nrow(), nrow());
         u->full()->m_ = svd.matrixU().transpose();
     }
     if (v) {
+        v->check_exports(ncol(), ncol());
         v->full()->m_ = svd.matrixV().transpose();
     }
 }
@@ -205,14 +221,17 @@ void OcFullMatrix::ident() {
 }
 
 void OcFullMatrix::exp(Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = m_.exp();
 }
 
 void OcFullMatrix::pow(int i, Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = m_.pow(i).eval();
 }
 
 void OcFullMatrix::inverse(Matrix* out) const {
+    out->check_exports(nrow(), ncol());
     out->full()->m_ = m_.inverse();
 }
 
@@ -150,12 +150,15 @@ class OcMatrix {
     }
 
     void unimp() const;
+    // error if a full matrix would change shape while exported to a Python buffer
+    void check_exports(int nrow, int ncol) const;
 
   protected:
     OcMatrix(int type);
 
   public:
     Object* obj_{};
+    int exports_{};  // live Python buffers of a full matrix, see nrnpy_hoc.cpp
 
   private:
     int type_{};
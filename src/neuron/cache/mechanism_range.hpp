@@ -28,6 +28,32 @@ void indices_to_cache(short type, Callable callable) {
     }
 }
 
+/**
+ * @brief Call the given method with each instance of a Memb_list and its Node index.
+ *
+ * The callable is invoked as callable(i, node_index) for i in [0, ml.nodecount). When the
+ * nodeindices of the Memb_list are consecutive the Node index is computed instead of read, so the
+ * loop has no indirection and can be vectorised.
+ */
+template <typename Callable>
+void for_each_node_index(neuron::model_sorted_token const& cache_token,
+                         std::size_t thread_id,
+                         Memb_list const& ml,
+                         Callable callable) {
+    int const base = mechanism::_get::_consecutive_node_index_base(cache_token, thread_id, ml);
+    int const count = ml.nodecount;
+    if (base >= 0) {
+        for (int i = 0; i < count; ++i) {
+            callable(i, base + i);
+        }
+    } else {
+        int const* const ni = ml.nodeindices;
+        for (int i = 0; i < count; ++i) {
+            callable(i, ni[i]);
+        }
+    }
+}
+
 /**
  * @brief Version of Memb_list for use in performance-critical code.
  *
@@ -22,6 +22,25 @@ struct Mechanism {
     std::vector<std::vector<double*>> pdata{};      // raw pointers for use during simulation
     std::vector<std::vector<Datum*>> pdata_hack{};  // temporary storage used when populating pdata;
                                                     // should go away when pdata are SoA
+    /**
+     * @brief layout_generation() of the mechanism storage when this was built.
+     */
+    std::size_t generation{};
+};
+/**
+ * @brief How the nodeindices of a Memb_list map mechanism instances to Nodes.
+ *
+ * If affine, nodeindices[i] == base + stride * i for every instance i. This is
+ * the case, for example, for a density mechanism inserted in all the Nodes of a
+ * NrnThread, when the map is the identity, so loops over the instances can
+ * index the Node data without reading nodeindices. Only valid for the
+ * Memb_list whose nodeindices it was computed from; CVode has its own.
+ */
+struct NodeIndexMap {
+    int const* nodeindices{};
+    int base{};
+    int stride{};
+    bool affine{};
 };
 struct Thread {
     /**
@@ -32,12 +51,31 @@ struct Thread {
      * @brief Offsets into global mechanism storage for this thread (one per mechanism)
      */
     std::vector<std::size_t> mechanism_offset{};
+    /**
+     * @brief Node index maps of the Memb_lists of this thread (one per mechanism)
+     */
+    std::vector<NodeIndexMap> mechanism_node_map{};
 };
 struct Model {
     std::vector<Thread> thread{};
     std::vector<Mechanism> mechanism{};
+    /**
+     * @brief layout_generation() of the Node storage when this was built.
+     */
+    std::size_t node_data_generation{};
 };
 extern std::optional<Model> model;
+/**
+ * @brief The last invalidated cache.
+ *
+ * nrn_ensure_model_data_are_sorted() reuses the entries of the mechanism types
+ * whose instances, and the data their pdata caches point into, did not move.
+ */
+extern std::optional<Model> stale_model;
+/**
+ * @brief Invalidate the cache, keeping it as stale_model.
+ */
+void invalidate();
 }  // namespace neuron::cache
 namespace neuron::container {
 cache::ModelMemoryUsage memory_usage(const std::optional<neuron::cache::Model>& model);
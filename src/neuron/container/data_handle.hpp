@@ -5,6 +5,7 @@
 
 #include <ostream>
 #include <sstream>
+#include <utility>
 
 namespace neuron::container {
 struct do_not_search_t {};
@@ -302,6 +303,21 @@ struct data_handle {
         return !(lhs == rhs);
     }
 
+    /**
+     * @brief Get the start of the underlying storage and the offset into it.
+     *
+     * The pair is only meaningful until the container is next permuted or reallocated, so it is
+     * intended for caches that are rebuilt when the model data are sorted. For a handle wrapping a
+     * raw pointer the storage is that pointer and the offset is zero. For an invalid handle the
+     * storage is null.
+     */
+    [[nodiscard]] std::pair<T*, std::size_t> storage_and_offset() {
+        if (m_offset) {
+            return {container_data(), m_array_dim * m_offset.current_row() + m_array_index};
+        }
+        return {get_ptr_helper(*this), 0};
+    }
+
     /**
      * @brief Get the identifier used by this handle.
      *
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 #include <ostream>
@@ -116,16 +117,45 @@ struct ModelMemoryUsage {
 };
 }  // namespace cache
 
+/** @brief Time spent sorting the model in `nrn_ensure_model_data_are_sorted`. */
+struct SortTiming {
+    /// @brief Number of times the model data were sorted and the cache rebuilt.
+    size_t full{};
+
+    /// @brief Number of times only the changed mechanism types were sorted.
+    size_t incremental{};
+
+    /// @brief Seconds spent in the most recent sort.
+    double last{};
+
+    /// @brief Seconds spent in all sorts.
+    double total{};
+
+    const SortTiming& operator+=(const SortTiming& other) {
+        full += other.full;
+        incremental += other.incremental;
+        last = std::max(last, other.last);
+        total += other.total;
+
+        return *this;
+    }
+};
+
+/** @brief Sort timing of this process, updated by `nrn_ensure_model_data_are_sorted`. */
+extern SortTiming model_sort_timing;
+
 /** @brief Overall SoA datastructures related memory usage. */
 struct MemoryUsage {
     ModelMemoryUsage model{};
     cache::ModelMemoryUsage cache_model{};
     VectorMemoryUsage stable_pointers{};
+    SortTiming sort_timing{};
 
     const MemoryUsage& operator+=(const MemoryUsage& other) {
         model += other.model;
         cache_model += other.cache_model;
         stable_pointers += other.stable_pointers;
+        sort_timing += other.sort_timing;
 
         return *this;
     }
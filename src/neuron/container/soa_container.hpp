@@ -6,6 +6,7 @@
 #include "neuron/container/soa_identifier.hpp"
 
 #include <algorithm>  // std::transform
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <limits>
@@ -772,6 +773,7 @@ struct soa {
             [](auto const& tag, auto& vec, int field_index, int array_dim) {
                 vec.shrink_to_fit();
             });
+        m_layout_generation = next_layout_generation();
     }
 
   private:
@@ -790,6 +792,7 @@ struct soa {
             throw_error("erase() called on a frozen structure");
         }
         mark_as_unsorted_impl<true>();
+        m_layout_generation = next_layout_generation();
         auto const old_size = size();
         assert(i < old_size);
         if (i != old_size - 1) {
@@ -1033,6 +1036,47 @@ struct soa {
         return m_sorted;
     }
 
+    /**
+     * @brief Query which layout of the underlying vectors is current.
+     *
+     * The value changes whenever rows are moved in memory: by a deletion, a
+     * non-trivial permutation, or an insertion or reserve() that reallocates.
+     * Appending rows within the reserved capacity and mark_as_unsorted() do
+     * not change it. Raw pointers into the storage taken while it had a given
+     * value are valid as long as it has that value. Values are not reused,
+     * even by other containers of the same type.
+     */
+    [[nodiscard]] std::size_t layout_generation() const {
+        return m_layout_generation;
+    }
+
+    /**
+     * @brief Reserve capacity for @p n rows.
+     * @param n     The number of rows to make room for.
+     * @param token A non-const token demonstrating that the caller is the only
+     *              party forcing the container to be frozen.
+     *
+     * Appending up to n - size() rows then does not move the existing rows.
+     * This does not change the sorted status of the container.
+     */
+    void reserve(std::size_t n, frozen_token_type& token) {
+        // Lock access to m_frozen_count and m_sorted.
+        std::lock_guard _{m_mut};
+        if (m_frozen_count != 1) {
+            throw_error("reserve() given a token that was not the only valid one");
+        }
+        bool moved{};
+        for_each_vector<detail::may_cause_reallocation::Yes>(
+            [n, &moved](auto const& tag, auto& vec, auto field_index, auto array_dim) {
+                auto const* const old_data = vec.data();
+                vec.reserve(n * array_dim);
+                moved = moved || (old_data && vec.data() != old_data);
+            });
+        if (moved) {
+            m_layout_generation = next_layout_generation();
+        }
+    }
+
     /**
      * @brief Permute the SoA-format data using an arbitrary range of integers.
      * @param permutation The reverse permutation vector to apply.
@@ -1090,6 +1134,7 @@ struct soa {
                     swap(permutation[i], permutation[next]);
                 }
             }
+            m_layout_generation = next_layout_generation();
             // update the indices in the container
             for (auto i = 0ul; i < my_size; ++i) {
                 m_indices[i].set_current_row(i);
@@ -1168,15 +1213,21 @@ struct soa {
         mark_as_unsorted_impl<true>();
         // Append to all of the vectors
         auto const old_size = size();
+        bool moved{};
         for_each_vector<detail::may_cause_reallocation::Yes>(
-            [](auto const& tag, auto& vec, auto field_index, auto array_dim) {
+            [&moved](auto const& tag, auto& vec, auto field_index, auto array_dim) {
                 using Tag = ::std::decay_t<decltype(tag)>;
+                auto const* const old_data = vec.data();
                 if constexpr (detail::has_default_value_v<Tag>) {
                     vec.insert(vec.end(), array_dim, tag.default_value());
                 } else {
                     vec.insert(vec.end(), array_dim, {});
                 }
+                moved = moved || (old_data && vec.data() != old_data);
             });
+        if (moved) {
+            m_layout_generation = next_layout_generation();
+        }
         // Important that this comes after the m_frozen_count check
         owning_identifier<Storage> index{static_cast<Storage&>(*this), old_size};
         // Update the pointer-to-row-number in m_indices so it refers to the
@@ -1587,6 +1638,19 @@ struct soa {
      */
     bool m_sorted{false};
 
+    /**
+     * @brief Return a layout_generation() value not used before.
+     */
+    static std::size_t next_layout_generation() {
+        static std::atomic<std::size_t> generation{};
+        return ++generation;
+    }
+
+    /**
+     * @brief Value for layout_generation().
+     */
+    std::size_t m_layout_generation{next_layout_generation()};
+
     /**
      * @brief Reference count for tokens guaranteeing the container is frozen.
      */
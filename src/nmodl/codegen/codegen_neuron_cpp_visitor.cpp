@@ -1691,6 +1691,8 @@ void CodegenNeuronCppVisitor::print_mechanism_register_regular() {
     }
     if (info.net_receive_node) {
         printer->fmt_line("pnt_receive[mech_type] = nrn_net_receive_{};", info.mod_suffix);
+        printer->fmt_line("pnt_receive_batch[mech_type] = nrn_net_receive_batch_{};",
+                          info.mod_suffix);
         printer->fmt_line("pnt_receive_size[mech_type] = {};", info.num_net_receive_parameters);
     }
 
@@ -2981,6 +2983,17 @@ void CodegenNeuronCppVisitor::print_net_receive() {
     printer->add_newline();
     printer->pop_block();
     printing_net_receive = false;
+
+    // same events for many instances, see CVode.queue_mode
+    printer->add_newline(2);
+    printer->fmt_push_block(
+        "static void nrn_net_receive_batch_{}(Point_process** _pnts, double** _args, int _cnt, "
+        "double flag)",
+        info.mod_suffix);
+    printer->push_block("for (int _i = 0; _i < _cnt; ++_i)");
+    printer->fmt_line("nrn_net_receive_{}(_pnts[_i], _args[_i], flag);", info.mod_suffix);
+    printer->pop_block();
+    printer->pop_block();
 }
 
 void CodegenNeuronCppVisitor::print_net_init() {
@@ -1175,6 +1175,14 @@ static const char *_mechanism[] = {\n\
     }
     if (net_receive_) {
         Lappendstr(defs_list, "static void _net_receive(Point_process*, double*, double);\n");
+        /* same events for many instances, see CVode.queue_mode */
+        Lappendstr(defs_list,
+                   "static void _net_receive_batch(Point_process** _pnts, double** _args, int "
+                   "_cnt, double _lflag) {\n"
+                   "  for (int _i = 0; _i < _cnt; ++_i) {\n"
+                   "    _net_receive(_pnts[_i], _args[_i], _lflag);\n"
+                   "  }\n"
+                   "}\n");
         if (for_netcons_) {
             Lappendstr(defs_list, "extern int _nrn_netcon_args(void*, double***);\n");
         }
@@ -1364,6 +1372,7 @@ located in a section and is not associated with an integrator\n");
         }
         if (net_receive_) {
             Lappendstr(defs_list, "pnt_receive[_mechtype] = _net_receive;\n");
+            Lappendstr(defs_list, "pnt_receive_batch[_mechtype] = _net_receive_batch;\n");
             if (net_init_q1_) {
                 Lappendstr(defs_list, "pnt_receive_init[_mechtype] = _net_init;\n");
             }
@@ -4,6 +4,10 @@ namespace neuron {
 
 extern int interleave_permute_type;
 
+/// @brief With interleave_permute_type 1, solve the cells of a thread in
+/// lockstep, one simd loop per level of nodes, instead of one cell at a time.
+extern int interleave_simd;
+
 /// @brief Select node ordering for optimum gaussian elimination
 /// @param type
 ///    0  cell together (Section construction order)
@@ -0,0 +1,304 @@
+/*
+** calqueue.hpp:  Calendar queue for event-sets or priority queues.
+**
+** Drop-in alternative to SPTree (same member functions) used by TQueue when
+** nrn_use_calendar_queue_ is set (see CVode.queue_mode). Like sptree.hpp, it
+** assumes that the application provides leftlink, rightlink and key for T.
+**
+** Based on:
+**     Calendar Queues: A Fast O(1) Priority Queue Implementation for
+**         the Simulation Event Set Problem
+**             by R. Brown, Comm. ACM 31(10), Oct 1988, 1220-1227.
+**
+** Items are hashed into a power of two number of buckets ("days") of width
+** `width_` by their virtual bucket number floor(key / width_). Each bucket is
+** a doubly linked list sorted by key (leftlink is the predecessor, rightlink
+** the successor) in which items with equal keys are kept in insertion order,
+** as with SPTree::enqueue. The number of buckets follows the number of items
+** and the width is re-estimated from the spacing of the earliest items
+** whenever the queue is resized, which gives O(1) amortized enqueue and
+** dequeue for the usual event time distributions.
+**
+** No locking is done here. TQueue serializes access when it owns a mutex.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+class CalQueue {
+  public:
+    CalQueue();
+
+    // Is this CalQueue empty?
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    // Number of items in the queue.
+    std::size_t size() const {
+        return size_;
+    }
+
+    // Number of resize operations so far (for statistics).
+    int get_nresize() const {
+        return nresize_;
+    }
+
+    // Insert item in the queue, after all other items with the same key.
+    void enqueue(T* n);
+
+    // Return and remove the item with the lowest key.
+    T* dequeue();
+
+    // Return the item with the lowest key (nullptr if empty).
+    T* first();
+
+    // Remove item `n` from the queue. `n` must be in the queue and its key
+    // must not have been changed since it was enqueued.
+    void remove(T* n);
+
+    // Find an item with the given key.
+    T* find(double key);
+
+    // Apply the function `f` to each item in ascending order.
+    // The integer argument is unused and will always be `0`. If n is given,
+    // start at that item, otherwise start from the head.
+    void apply_all(void (*f)(const T*, int), T* n) const;
+
+  private:
+    struct Bucket {
+        T* head{};
+        T* tail{};
+    };
+
+    // Virtual bucket number of a key. Monotone in key, so comparing virtual
+    // bucket numbers never contradicts comparing keys.
+    std::int64_t vbucket(double k) const {
+        constexpr double vbmax = 4611686018427387904.;  // 2^62
+        double x = std::floor(k * inv_width_);
+        x = std::min(std::max(x, -vbmax), vbmax);
+        return static_cast<std::int64_t>(x);
+    }
+
+    Bucket& bucket(std::int64_t vb) {
+        return buckets_[static_cast<std::size_t>(vb) & mask_];
+    }
+
+    // Link `n` into its bucket, after all items with key <= n->key.
+    void link(T* n);
+
+    // Unlink `n` from its bucket.
+    void unlink(T* n);
+
+    // Rehash all items into `nbucket` buckets, re-estimating the width.
+    void resize(std::size_t nbucket);
+
+    std::vector<Bucket> buckets_;
+    std::size_t mask_{};
+    std::size_t size_{};
+    double width_{1.0};
+    double inv_width_{1.0};
+    // Invariant: no item has a virtual bucket number below last_vb_.
+    std::int64_t last_vb_{};
+    int nresize_{};
+
+    static constexpr std::size_t min_nbucket = 16;
+};
+
+template <typename T>
+CalQueue<T>::CalQueue()
+    : buckets_(min_nbucket)
+    , mask_(min_nbucket - 1) {}
+
+template <typename T>
+void CalQueue<T>::link(T* n) {
+    Bucket& b = bucket(vbucket(n->key));
+    // Events mostly arrive in increasing time order, so search from the tail.
+    T* prev = b.tail;
+    while (prev && prev->key > n->key) {
+        prev = prev->leftlink;
+    }
+    n->leftlink = prev;
+    if (prev) {
+        n->rightlink = prev->rightlink;
+        prev->rightlink = n;
+    } else {
+        n->rightlink = b.head;
+        b.head = n;
+    }
+    if (n->rightlink) {
+        n->rightlink->leftlink = n;
+    } else {
+        b.tail = n;
+    }
+}
+
+template <typename T>
+void CalQueue<T>::unlink(T* n) {
+    Bucket& b = bucket(vbucket(n->key));
+    if (n->leftlink) {
+        n->leftlink->rightlink = n->rightlink;
+    } else {
+        b.head = n->rightlink;
+    }
+    if (n->rightlink) {
+        n->rightlink->leftlink = n->leftlink;
+    } else {
+        b.tail = n->leftlink;
+    }
+    n->leftlink = nullptr;
+    n->rightlink = nullptr;
+}
+
+template <typename T>
+void CalQueue<T>::enqueue(T* n) {
+    std::int64_t vb = vbucket(n->key);
+    if (size_ == 0 || vb < last_vb_) {
+        last_vb_ = vb;
+    }
+    link(n);
+    if (++size_ > 2 * buckets_.size()) {
+        resize(2 * buckets_.size());
+    }
+}
+
+template <typename T>
+T* CalQueue<T>::first() {
+    if (size_ == 0) {
+        return nullptr;
+    }
+    // Scan one year of days starting at the day of the last minimum.
+    std::int64_t vb = last_vb_;
+    for (std::size_t i = 0; i < buckets_.size(); ++i, ++vb) {
+        T* h = bucket(vb).head;
+        if (h && vbucket(h->key) <= vb) {
+            last_vb_ = vb;
+            return h;
+        }
+    }
+    // Sparse queue: nothing within a year, so search the bucket heads directly.
+    T* min = nullptr;
+    for (const Bucket& b: buckets_) {
+        if (b.head && (!min || b.head->key < min->key)) {
+            min = b.head;
+        }
+    }
+    last_vb_ = vbucket(min->key);
+    return min;
+}
+
+template <typename T>
+T* CalQueue<T>::dequeue() {
+    T* n = first();
+    if (n) {
+        unlink(n);
+        if (--size_ < buckets_.size() / 2 && buckets_.size() > min_nbucket) {
+            resize(buckets_.size() / 2);
+        }
+    }
+    return n;
+}
+
+template <typename T>
+void CalQueue<T>::remove(T* n) {
+    unlink(n);
+    --size_;
+}
+
+template <typename T>
+T* CalQueue<T>::find(double key) {
+    for (T* n = bucket(vbucket(key)).head; n; n = n->rightlink) {
+        if (n->key == key) {
+            return n;
+        }
+        if (n->key > key) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+void CalQueue<T>::apply_all(void (*f)(const T*, int), T* n) const {
+    // Only for printing and saving state, so no need to be fast. Items with
+    // equal keys are in the same bucket, so a stable sort keeps their order.
+    std::vector<T*> items;
+    items.reserve(size_);
+    for (const Bucket& b: buckets_) {
+        for (T* x = b.head; x; x = x->rightlink) {
+            items.push_back(x);
+        }
+    }
+    std::stable_sort(items.begin(), items.end(), [](const T* a, const T* b) {
+        return a->key < b->key;
+    });
+    auto it = items.begin();
+    if (n) {
+        it = std::find(items.begin(), items.end(), n);
+    }
+    for (; it != items.end(); ++it) {
+        f(*it, 0);
+    }
+}
+
+template <typename T>
+void CalQueue<T>::resize(std::size_t nbucket) {
+    ++nresize_;
+    // Collect items, keeping the order of equal keys (they share a bucket).
+    std::vector<T*> items;
+    items.reserve(size_);
+    for (const Bucket& b: buckets_) {
+        for (T* x = b.head; x; x = x->rightlink) {
+            items.push_back(x);
+        }
+    }
+
+    // Brown's heuristic: the new width is three times the average separation
+    // of a sample of the earliest items, ignoring separations more than twice
+    // the average.
+    constexpr std::size_t nsample_max = 25;
+    std::size_t nsample = std::min(items.size(), nsample_max);
+    if (nsample > 1) {
+        std::vector<T*> earliest(nsample);
+        std::partial_sort_copy(items.begin(),
+                               items.end(),
+                               earliest.begin(),
+                               earliest.end(),
+                               [](const T* a, const T* b) { return a->key < b->key; });
+        double total = earliest.back()->key - earliest.front()->key;
+        double avg = total / double(nsample - 1);
+        double sum = 0.;
+        int cnt = 0;
+        for (std::size_t i = 1; i < nsample; ++i) {
+            double sep = earliest[i]->key - earliest[i - 1]->key;
+            if (sep <= 2. * avg) {
+                sum += sep;
+                ++cnt;
+            }
+        }
+        double w = cnt ? 3. * sum / cnt : 0.;
+        // All sampled items simultaneous (or overflow): keep the old width.
+        if (w > 0. && std::isfinite(w)) {
+            width_ = w;
+            inv_width_ = 1. / w;
+        }
+    }
+
+    buckets_.assign(nbucket, Bucket{});
+    mask_ = nbucket - 1;
+    for (T* x: items) {
+        link(x);
+    }
+    if (!items.empty()) {
+        auto min = std::min_element(items.begin(), items.end(), [](const T* a, const T* b) {
+            return a->key < b->key;
+        });
+        last_vb_ = vbucket((*min)->key);
+    }
+}
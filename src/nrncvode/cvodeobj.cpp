@@ -50,6 +50,7 @@ static void static_mutex_for_at_time(bool b) {
 #include "cvodes/cvodes_impl.h"
 #include "cvodes/cvdense.h"
 #include "cvodes/cvdiag.h"
+#include "cvodes/cvspgmr.h"
 #include "shared/dense.h"
 #include "ida/ida.h"
 #include "nonvintblock.h"
@@ -78,6 +79,8 @@ extern N_Vector N_VNew_NrnParallelLD(int comm, long int local_length, long int g
 
 extern bool nrn_use_fifo_queue_;
 extern bool nrn_use_bin_queue_;
+extern bool nrn_use_calendar_queue_;
+extern bool nrn_use_batch_receive_;
 
 #undef SUCCESS
 #define SUCCESS CV_SUCCESS
@@ -129,7 +132,14 @@ static double queue_mode(void* v) {
         }
 #endif
     }
-    return double(nrn_use_bin_queue_ + 2 * nrn_use_selfqueue_);
+    if (ifarg(3)) {
+        nrn_use_calendar_queue_ = chkarg(3, 0, 1) ? true : false;
+    }
+    if (ifarg(4)) {
+        nrn_use_batch_receive_ = chkarg(4, 0, 1) ? true : false;
+    }
+    return double(nrn_use_bin_queue_ + 2 * nrn_use_selfqueue_ + 4 * nrn_use_calendar_queue_ +
+                  8 * nrn_use_batch_receive_);
     return 0.;
 }
 
@@ -245,7 +255,7 @@ static double maxstep(void* v) {
 static double jacobian(void* v) {
     NetCvode* d = (NetCvode*) v;
     if (ifarg(1)) {
-        d->jacobian((int) chkarg(1, 0, 2));
+        d->jacobian((int) chkarg(1, 0, 3));
     }
     hoc_return_type_code = HocReturnType::integer;
     return double(d->jacobian());
@@ -674,6 +684,27 @@ static int msolve_lvardt(CVodeMem cv_mem,
                          N_Vector ycur,
                          N_Vector fcur);
 static void mfree(CVodeMem cv_mem);
+static int spgmr_psetup(realtype t,
+                        N_Vector y,
+                        N_Vector fy,
+                        booleantype jok,
+                        booleantype* jcurPtr,
+                        realtype gamma,
+                        void* P_data,
+                        N_Vector tmp1,
+                        N_Vector tmp2,
+                        N_Vector tmp3);
+static int spgmr_psolve(realtype t,
+                        N_Vector y,
+                        N_Vector fy,
+                        N_Vector r,
+                        N_Vector z,
+                        realtype gamma,
+                        realtype delta,
+                        int lr,
+                        void* P_data,
+                        N_Vector tmp);
+static void spgmr_check(int err, const char* fn);
 static void f_gvardt(realtype t, N_Vector y, N_Vector ydot, void* f_data);
 static void f_lvardt(realtype t, N_Vector y, N_Vector ydot, void* f_data);
 static CVRhsFn pf_;
@@ -711,6 +742,7 @@ void Cvode::cvode_constructor() {
     tstop_end_ = 0.;
     use_daspk_ = false;
     daspk_ = nullptr;
+    use_spgmr_ = false;
 
     mem_ = nullptr;
     y_ = nullptr;
@@ -1424,6 +1456,20 @@ void Cvode::statistics() {
         daspk_->statistics();
         return;
     }
+    // only if matmeth set up CVSpgmr, jacobian() may have been changed since
+    if (use_spgmr_) {
+        long int nli, npe, nps, ncfl, njv;
+        spgmr_check(CVSpgmrGetNumLinIters(mem_, &nli), "CVSpgmrGetNumLinIters");
+        spgmr_check(CVSpgmrGetNumPrecEvals(mem_, &npe), "CVSpgmrGetNumPrecEvals");
+        spgmr_check(CVSpgmrGetNumPrecSolves(mem_, &nps), "CVSpgmrGetNumPrecSolves");
+        spgmr_check(CVSpgmrGetNumConvFails(mem_, &ncfl), "CVSpgmrGetNumConvFails");
+        spgmr_check(CVSpgmrGetNumJtimesEvals(mem_, &njv), "CVSpgmrGetNumJtimesEvals");
+        Printf("   %ld krylov iterations, %ld J*v products, %ld convergence failures\n",
+               nli,
+               njv,
+               ncfl);
+        Printf("   %ld preconditioner setups, %ld preconditioner solves\n", npe, nps);
+    }
 #else
     Printf("\nCVode Statistics.. \n\n");
     Printf("internal steps = %d\nfunction evaluations = %d\n", iopt_[NST], iopt_[NFE]);
@@ -1439,6 +1485,7 @@ void Cvode::statistics() {
 }
 
 void Cvode::matmeth() {
+    use_spgmr_ = false;
     switch (ncv_->jacobian()) {
     case 1:
         CVDense(mem_, neq_);
@@ -1446,6 +1493,14 @@ void Cvode::matmeth() {
     case 2:
         CVDiag(mem_);
         break;
+    case 3:
+        // Newton-Krylov, with our linear solver as the preconditioner.
+        spgmr_check(CVSpgmr(mem_, PREC_LEFT, 0), "CVSpgmr");
+        spgmr_check(CVSpgmrSetPrecSetupFn(mem_, spgmr_psetup), "CVSpgmrSetPrecSetupFn");
+        spgmr_check(CVSpgmrSetPrecSolveFn(mem_, spgmr_psolve), "CVSpgmrSetPrecSolveFn");
+        spgmr_check(CVSpgmrSetPrecData(mem_, mem_), "CVSpgmrSetPrecData");
+        use_spgmr_ = true;
+        break;
     default:
         // free previous method
         if (((CVodeMem) mem_)->cv_lfree) {
@@ -1568,6 +1623,55 @@ static void mfree(CVodeMem) {
     //	printf("mfree\n");
 }
 
+// jacobian(3): CVSpgmr iterates on (I - gamma*J)x = b with difference quotient
+// J*v products and uses msetup/msolve, i.e. the tree matrix and the
+// mechanism ode_matsol approximations, to solve P*z = r.
+static int spgmr_psetup(realtype,
+                        N_Vector y,
+                        N_Vector fy,
+                        booleantype,
+                        booleantype* jcurPtr,
+                        realtype,
+                        void* P_data,
+                        N_Vector,
+                        N_Vector,
+                        N_Vector) {
+    return msetup(static_cast<CVodeMem>(P_data), 0, y, fy, jcurPtr, nullptr, nullptr, nullptr);
+}
+
+static int spgmr_psolve(realtype,
+                        N_Vector y,
+                        N_Vector fy,
+                        N_Vector r,
+                        N_Vector z,
+                        realtype,
+                        realtype,
+                        int,
+                        void* P_data,
+                        N_Vector) {
+    auto* const m = static_cast<CVodeMem>(P_data);
+    auto* const cv =
+        static_cast<std::pair<Cvode*, neuron::model_sorted_token const&>*>(m->cv_f_data)->first;
+    N_VScale(1., r, z);
+    if (cv->nth_) {
+        return msolve_lvardt(m, z, nullptr, y, fy);
+    }
+    return msolve(m, z, nullptr, y, fy);
+}
+
+static void spgmr_check(int err, const char* fn) {
+    switch (err) {
+    case CVSPGMR_SUCCESS:
+        return;
+    case CVSPGMR_MEM_FAIL:
+        hoc_execerror(fn, "could not allocate memory");
+    case CVSPGMR_ILL_INPUT:
+        hoc_execerror(fn, "illegal input");
+    default:
+        hoc_execerror(fn, "failed");
+    }
+}
+
 static realtype f_t_;
 static N_Vector f_y_;
 static N_Vector f_ydot_;
@@ -268,6 +268,7 @@ class Cvode {
 
   private:
     int prior2init_;
+    bool use_spgmr_;  // matmeth attached CVSpgmr to mem_, jacobian(3)
 #if NRNMPI
   public:
     bool use_partrans_;
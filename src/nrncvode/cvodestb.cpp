@@ -85,12 +85,24 @@ void fixed_play_continuous(NrnThread* nt) {
     }
 }
 
+void fixed_record_prepare(int nstep) {
+    if (net_cvode_instance) {
+        net_cvode_instance->fixed_record_prepare(nstep);
+    }
+}
+
 void fixed_record_continuous(neuron::model_sorted_token const& cache_token, NrnThread& nt) {
     if (net_cvode_instance) {
         net_cvode_instance->fixed_record_continuous(cache_token, nt);
     }
 }
 
+void fixed_record_check() {
+    if (net_cvode_instance) {
+        net_cvode_instance->fixed_record_check();
+    }
+}
+
 void nrn_solver_prepare() {
     if (net_cvode_instance) {
         net_cvode_instance->solver_prepare();
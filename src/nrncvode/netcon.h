@@ -49,6 +49,7 @@ using SelfEventPPTable = std::unordered_map<long, Point_process*>;
 #define PlayRecordEventType 6
 // the above will in turn steer to proper PlayRecord type
 #define NetParEventType 7
+#define NetConDelayGroupType 8
 
 #if DISCRETE_EVENT_OBSERVER
 class DiscreteEvent: public Observer {
@@ -123,6 +124,40 @@ class NetCon: public DiscreteEvent {
     static unsigned long netcon_deliver_;
 };
 
+// The NetCons of a PreSyn that have the same delay and whose targets are in
+// the same thread. A spike is then one event per group instead of one per
+// NetCon. The group is a slice of the PreSyn delay_group_targets_.
+class NetConDelayGroup: public DiscreteEvent {
+  public:
+    NetConDelayGroup(PreSyn* src, NrnThread* nt, double delay, std::size_t begin, std::size_t end)
+        : src_{src}
+        , nt_{nt}
+        , delay_{delay}
+        , begin_{begin}
+        , end_{end} {}
+    void deliver(double, NetCvode*, NrnThread*) override;
+    void pr(const char*, double t, NetCvode*) override;
+    int pgvts_op(int& i) override {
+        i = 1;
+        return 2;
+    }
+    void pgvts_deliver(double t, NetCvode*) override;
+    NrnThread* thread() override {
+        return nt_;
+    }
+    int type() override {
+        return NetConDelayGroupType;
+    }
+    // put the NetCon events of the group on the queue instead
+    void fanout(double, NetCvode*);
+
+    PreSyn* src_;
+    NrnThread* nt_;
+    double delay_;
+    std::size_t begin_;
+    std::size_t end_;
+};
+
 typedef std::unordered_map<void*, NetCon*> NetConSaveWeightTable;
 typedef std::unordered_map<long, NetCon*> NetConSaveIndexTable;
 
@@ -290,8 +325,14 @@ class PreSyn: public ConditionEvent {
     void init();
     double mindelay();
     void fanout(double, NetCvode*, NrnThread*);  // used by bbsavestate
+    void setup_delay_groups();
+    void forget_delay_group_target(NetCon*);
 
     NetConPList dil_;
+    // when use_delay_groups_, the NetCon in (thread, delay) order and the
+    // groups of equal thread and delay in that order
+    std::vector<NetCon*> delay_group_targets_;
+    std::vector<NetConDelayGroup> delay_groups_;
     double threshold_;
     double delay_;
     neuron::container::data_handle<double> thvar_{};
@@ -304,6 +345,7 @@ class PreSyn: public ConditionEvent {
     hoc_Item* hi_th_;  // in the netcvode psl_th_
     long hi_index_;    // for SaveState read and write
     int use_min_delay_;
+    bool use_delay_groups_;
     int rec_id_;
     int output_index_;
     int gid_;
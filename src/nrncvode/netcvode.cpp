@@ -2,6 +2,8 @@
 
 // define to 0 if do not wish use_min_delay_ to ever be 1
 #define USE_MIN_DELAY 1
+// define to 0 if do not wish use_delay_groups_ to ever be true
+#define USE_DELAY_GROUPS 1
 
 #include <nrnmpi.h>
 #include "cabcode.h"
@@ -36,9 +38,11 @@
 #include "nrniv_mf.h"
 #include "nrnste.h"
 #include "profile.h"
+#include "recordingset.h"
 #include "utils/profile/profiler_interface.h"
 #include "utils/formatting.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstdlib>
@@ -223,6 +227,8 @@ extern void nrn_multisend_advance();
 bool nrn_use_fifo_queue_;
 
 bool nrn_use_bin_queue_;
+// deliver the NetCon events of a fixed step bin grouped by mechanism type
+bool nrn_use_batch_receive_;
 
 #if NRNMPI
 // for compressed info during spike exchange
@@ -397,11 +403,6 @@ class MaxStateItem {
     double amax_;
 };
 
-struct InterThreadEvent {
-    DiscreteEvent* de_;
-    double t_;
-};
-
 typedef std::vector<WatchCondition*> WatchList;
 using SelfEventPool = MutexPool<SelfEvent>;
 typedef std::vector<TQItem*> TQList;
@@ -632,6 +633,9 @@ static double nc_setpost(void* v) {
 #endif
         d->target_ = nullptr;
     }
+    if (d->src_) {
+        d->src_->use_delay_groups_ = false;
+    }
     int cnt = 1;
     if (tar) {
         cnt = pnt_receive_size[tar->prop->_type];
@@ -777,6 +781,7 @@ static void steer_val(void* v) {
         d->chksrc();
         hoc_pushpx(&d->delay_);
         d->src_->use_min_delay_ = 0;
+        d->src_->use_delay_groups_ = false;
     } else if (strcmp(s->name, "weight") == 0) {
         int index = 0;
         if (hoc_stack_type_is_ndim()) {
@@ -984,27 +989,22 @@ Object** NetCvode::netconlist() {
     return po;
 }
 
-#define ITE_SIZE 10
 NetCvodeThreadData::NetCvodeThreadData() {
     tpool_ = new TQItemPool(1000, 1);
     // tqe_ accessed only by thread i so no locking
-    tqe_ = new TQueue(tpool_, 0);
+    tqe_ = new TQueue(tpool_, 0, nrn_use_calendar_queue_);
     sepool_ = new SelfEventPool(1000, 1);
     selfqueue_ = nullptr;
     psl_thr_ = nullptr;
     tq_ = nullptr;
     lcv_ = nullptr;
-    ite_size_ = ITE_SIZE;
-    ite_cnt_ = 0;
     unreffed_event_cnt_ = 0;
     immediate_deliver_ = -1e100;
-    inter_thread_events_ = new InterThreadEvent[ite_size_];
+    ite_lanes_.resize(std::max(nrn_nthread, 1) + 1);
     nlcv_ = 0;
-    MUTCONSTRUCT(1)
 }
 
 NetCvodeThreadData::~NetCvodeThreadData() {
-    delete[] std::exchange(inter_thread_events_, nullptr);
     if (psl_thr_) {
         hoc_l_freelist(&psl_thr_);
     }
@@ -1022,12 +1022,17 @@ NetCvodeThreadData::~NetCvodeThreadData() {
         }
         delete[] std::exchange(lcv_, nullptr);
     }
-    MUTDESTRUCT
 }
 
-void NetCvodeThreadData::interthread_send(double td, DiscreteEvent* db, NrnThread* nt) {
+void NetCvodeThreadData::interthread_send(double td,
+                                          DiscreteEvent* db,
+                                          NrnThread* nt,
+                                          NrnThread* src) {
     // bin_event(td, db, nt);
-    MUTLOCK
+    // Only the job of the source thread sends from it, so senders never share
+    // a lane. The lane after those of the threads is for the interpreter.
+    const int lane = src ? src->id : nrn_nthread;
+    assert(lane < int(ite_lanes_.size()));
 #if PRINT_EVENT
     if (net_cvode_instance->print_event_) {
         Printf("interthread send td=%.15g DE type=%d thread=%d target=%d %s\n",
@@ -1038,55 +1043,47 @@ void NetCvodeThreadData::interthread_send(double td, DiscreteEvent* db, NrnThrea
                (db->type() == 2) ? hoc_object_name(((NetCon*) (db))->target_->ob) : "?");
     }
 #endif
-    if (ite_cnt_ >= ite_size_) {
-        ite_size_ *= 2;
-        InterThreadEvent* in = new InterThreadEvent[ite_size_];
-        for (int i = 0; i < ite_cnt_; ++i) {
-            in[i].de_ = inter_thread_events_[i].de_;
-            in[i].t_ = inter_thread_events_[i].t_;
-        }
-        delete[] std::exchange(inter_thread_events_, in);
-    }
-    InterThreadEvent& ite = inter_thread_events_[ite_cnt_++];
-    ite.de_ = db;
-    ite.t_ = td;
-    // race since each NetCvodeThreadData has its own lock and enqueueing_
-    // is a NetCvode instance variable. enqueuing_ is not logically
-    // needed but can avoid a nrn_multithread_job call in allthread_least_t
-    // which does nothing if there are no interthread events.
-    // int& b = net_cvode_instance->enqueueing_;
-    // if (!b) { b = 1; }
-    MUTUNLOCK
-    // have decided to lock net_cvode_instance and set it
+    {
+        InterThreadLane& l = ite_lanes_[lane];
+        std::lock_guard<std::mutex> lock(l.mut_);
+        l.events_.push_back({db, td});
+    }
     net_cvode_instance->set_enqueueing();
 }
 
 void NetCvodeThreadData::enqueue(NetCvode* nc, NrnThread* nt) {
-    int i;
-    MUTLOCK
-    for (i = 0; i < ite_cnt_; ++i) {
-        InterThreadEvent& ite = inter_thread_events_[i];
-#if PRINT_EVENT
-        if (net_cvode_instance->print_event_) {
-            Printf("interthread enqueue td=%.15g DE type=%d thread=%d target=%d %s\n",
-                   ite.t_,
-                   ite.de_->type(),
-                   nt->id,
-                   (ite.de_->type() == 2) ? PP2NT(((NetCon*) (ite.de_))->target_)->id : -1,
-                   (ite.de_->type() == 2) ? hoc_object_name(((NetCon*) (ite.de_))->target_->ob)
-                                          : "?");
+    // Lanes are taken in source thread order, so the order of events with the
+    // same delivery time does not depend on the timing of the senders. The
+    // senders may be running, so a lane is swapped out under its lock and
+    // binned after the lock is released.
+    for (auto& lane: ite_lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(lane.mut_);
+            ite_drain_.swap(lane.events_);
         }
+        for (const auto& ite: ite_drain_) {
+#if PRINT_EVENT
+            if (net_cvode_instance->print_event_) {
+                Printf("interthread enqueue td=%.15g DE type=%d thread=%d target=%d %s\n",
+                       ite.t_,
+                       ite.de_->type(),
+                       nt->id,
+                       (ite.de_->type() == 2) ? PP2NT(((NetCon*) (ite.de_))->target_)->id : -1,
+                       (ite.de_->type() == 2)
+                           ? hoc_object_name(((NetCon*) (ite.de_))->target_->ob)
+                           : "?");
+            }
 #endif
-        nc->bin_event(ite.t_, ite.de_, nt);
+            nc->bin_event(ite.t_, ite.de_, nt);
+        }
+        ite_drain_.clear();
     }
-    ite_cnt_ = 0;
-    MUTUNLOCK
 }
 
 NetCvode::NetCvode(bool single) {
     use_long_double_ = 0;
     empty_ = true;  // no equations (only artificial cells).
-    MUTCONSTRUCT(0);
+    enqueueing_ = false;
     maxorder_ = 5;
     maxstep_ = 1e9;
     minstep_ = 0.;
@@ -1135,7 +1132,6 @@ NetCvode::NetCvode(bool single) {
 }
 
 NetCvode::~NetCvode() {
-    MUTDESTRUCT
     if (net_cvode_instance == (NetCvode*) this) {
         net_cvode_instance = nullptr;
     }
@@ -1410,6 +1406,7 @@ void NetCvode::alloc_list() {
             NetCvodeThreadData& d = p[id];
             d.nlcv_ = nt.ncell;
             d.lcv_ = new Cvode[d.nlcv_];
+            // a splay tree, re_init changes the times of its items in place
             d.tq_ = new TQueue(d.tpool_);
             for (i = 0; i < d.nlcv_; ++i) {
                 TQItem* ti = d.tq_->insert(0., d.lcv_ + i);
@@ -2551,7 +2548,7 @@ void NetCvode::hoc_event(double tt, const char* stmt, Object* ppobj, int reinit,
         if (nrn_nthread > 1 && (!cvode_active_ || localstep())) {
             if (ppobj) {
                 int i = PP2NT(ob2pntproc(ppobj))->id;
-                p[i].interthread_send(tt, HocEvent::alloc(stmt, ppobj, reinit, pyact), nt + i);
+                p[i].interthread_send(tt, HocEvent::alloc(stmt, ppobj, reinit, pyact), nt + i, nullptr);
                 nrn_interthread_enqueue(nt + i);
             } else {
                 HocEvent* he = HocEvent::alloc(stmt, nullptr, 0, pyact);
@@ -2563,7 +2560,7 @@ void NetCvode::hoc_event(double tt, const char* stmt, Object* ppobj, int reinit,
                 // to the callers of the multithread_job functions
                 // to do the right thing.
                 for (int i = 0; i < nrn_nthread; ++i) {
-                    p[i].interthread_send(tt, he, nt + i);
+                    p[i].interthread_send(tt, he, nt + i, nullptr);
                 }
                 nrn_multithread_job(nrn_interthread_enqueue);
             }
@@ -2700,19 +2697,18 @@ void NetCvode::clear_events() {
     HocEvent::reclaim();
     allthread_hocevents_->clear();
     nrn_allthread_handle = nullptr;
-    if (!MUTCONSTRUCTED) {
-        MUTCONSTRUCT(1);
-    }
-    enqueueing_ = 0;
+    enqueueing_ = false;
     for (i = 0; i < nrn_nthread; ++i) {
         NetCvodeThreadData& d = p[i];
-        delete std::exchange(d.tqe_, new TQueue(p[i].tpool_));
+        delete std::exchange(d.tqe_, new TQueue(p[i].tpool_, 0, nrn_use_calendar_queue_));
         d.unreffed_event_cnt_ = 0;
         if (d.sepool_) {
             d.sepool_->free_all();
         }
         d.immediate_deliver_ = -1e100;
-        d.ite_cnt_ = 0;
+        for (auto& lane: d.ite_lanes_) {
+            lane.events_.clear();
+        }
         if (nrn_use_selfqueue_) {
             if (!d.selfqueue_) {
                 d.selfqueue_ = new SelfQueue(d.tpool_, 0);
@@ -2779,6 +2775,7 @@ void NetCvode::init_events() {
                     ps->use_min_delay_ = false;
                 }
             }
+            ps->setup_delay_groups();
         }
     }
     // iterate over all NetCon in creation order to call
@@ -2896,6 +2893,17 @@ static void event_info_callback(const TQItem* q, int) {
             }
         }
         break;
+    case NetConDelayGroupType:
+        if (event_info_type_ == NetConType) {
+            auto* g = static_cast<NetConDelayGroup*>(d);
+            for (std::size_t i = g->end_; i > g->begin_; --i) {
+                if (NetCon* nc = g->src_->delay_group_targets_[i - 1]) {
+                    event_info_tvec_->push_back(q->t_);
+                    event_info_list_->append(nc->obj_);
+                }
+            }
+        }
+        break;
     }
 }
 
@@ -3023,7 +3031,15 @@ void PreSyn::send(double tt, NetCvode* ns, NrnThread* nt) {
             if (nt->id == i) {
                 ns->bin_event(tt + delay_, this, nt);
             } else {
-                ns->p[i].interthread_send(tt + delay_, this, nrn_threads + i);
+                ns->p[i].interthread_send(tt + delay_, this, nrn_threads + i, nt);
+            }
+        }
+    } else if (use_delay_groups_) {
+        for (auto& g: delay_groups_) {
+            if (g.nt_ == nt) {
+                ns->bin_event(tt + g.delay_, &g, nt);
+            } else {
+                ns->p[g.nt_->id].interthread_send(tt + g.delay_, &g, g.nt_, nt);
             }
         }
     } else {
@@ -3034,7 +3050,7 @@ void PreSyn::send(double tt, NetCvode* ns, NrnThread* nt) {
                 if (nt == n) {
                     ns->bin_event(tt + d->delay_, d, n);
                 } else {
-                    ns->p[n->id].interthread_send(tt + d->delay_, d, n);
+                    ns->p[n->id].interthread_send(tt + d->delay_, d, n, nt);
                 }
             }
         }
@@ -3124,6 +3140,127 @@ NrnThread* PreSyn::thread() {
     return nt_;
 }
 
+// Decide whether spikes are sent as one event per group of NetCon with the
+// same target thread and delay. Only worthwhile when the delays are not all
+// the same (see use_min_delay_) and there are on average at least two NetCon
+// per group.
+void PreSyn::setup_delay_groups() {
+    use_delay_groups_ = false;
+    delay_group_targets_.clear();
+    delay_groups_.clear();
+#if USE_DELAY_GROUPS
+    if (use_min_delay_ || dil_.size() <= 2) {
+        return;
+    }
+    // inactive NetCon are kept, they may be activated during the run
+    for (const auto& d: dil_) {
+        if (d->target_) {
+            delay_group_targets_.push_back(d);
+        }
+    }
+    // stable so that the NetCon of a group are delivered in dil_ order
+    std::stable_sort(delay_group_targets_.begin(),
+                     delay_group_targets_.end(),
+                     [](const NetCon* a, const NetCon* b) {
+                         int ia = PP2NT(a->target_)->id;
+                         int ib = PP2NT(b->target_)->id;
+                         return ia != ib ? ia < ib : a->delay_ < b->delay_;
+                     });
+    const std::size_t n = delay_group_targets_.size();
+    for (std::size_t i = 0; i < n;) {
+        NetCon* d = delay_group_targets_[i];
+        NrnThread* nt = PP2NT(d->target_);
+        std::size_t j = i + 1;
+        while (j < n && PP2NT(delay_group_targets_[j]->target_) == nt &&
+               delay_group_targets_[j]->delay_ == d->delay_) {
+            ++j;
+        }
+        delay_groups_.emplace_back(this, nt, d->delay_, i, j);
+        i = j;
+    }
+    if (2 * delay_groups_.size() > n) {
+        delay_group_targets_.clear();
+        delay_groups_.clear();
+        return;
+    }
+    use_delay_groups_ = true;
+#endif  // USE_DELAY_GROUPS
+}
+
+// A deleted NetCon may still be in a group whose event is on a queue.
+void PreSyn::forget_delay_group_target(NetCon* d) {
+    std::replace(delay_group_targets_.begin(), delay_group_targets_.end(), d, (NetCon*) nullptr);
+}
+
+// Groups may be out of date if NetCon were changed during the run, so the
+// same checks as in PreSyn::deliver are made.
+void NetConDelayGroup::deliver(double tt, NetCvode* ns, NrnThread* nt) {
+    assert(nt == nt_);
+    for (std::size_t i = begin_; i < end_; ++i) {
+        NetCon* d = src_->delay_group_targets_[i];
+        if (d && d->active_ && d->target_ && PP2NT(d->target_) == nt) {
+            STATISTICS(deliver_cnt_);
+            d->deliver(tt, ns, nt);
+        }
+    }
+}
+
+void NetConDelayGroup::pgvts_deliver(double tt, NetCvode* ns) {
+    for (std::size_t i = begin_; i < end_; ++i) {
+        NetCon* d = src_->delay_group_targets_[i];
+        if (d && d->active_ && d->target_) {
+            d->pgvts_deliver(tt, ns);
+        }
+    }
+}
+
+void NetConDelayGroup::fanout(double td, NetCvode* ns) {
+    for (std::size_t i = begin_; i < end_; ++i) {
+        NetCon* d = src_->delay_group_targets_[i];
+        if (d && d->active_ && d->target_ && PP2NT(d->target_) == nt_) {
+            ns->bin_event(td, d, nt_);
+        }
+    }
+}
+
+void NetConDelayGroup::pr(const char* s, double tt, NetCvode* ns) {
+    Printf("%s NetConDelayGroup src=%s delay=%g thread=%d ncon=%zu %.15g\n",
+           s,
+           src_->osrc_ ? hoc_object_name(src_->osrc_) : secname(src_->ssrc_),
+           delay_,
+           nt_->id,
+           end_ - begin_,
+           tt);
+}
+
+static std::vector<TQItem*>* delay_group_items_;
+static void delay_group_callback(const TQItem* q, int) {
+    if (static_cast<DiscreteEvent*>(q->data_)->type() == NetConDelayGroupType) {
+        delay_group_items_->push_back(const_cast<TQItem*>(q));
+    }
+}
+
+// Replace the NetConDelayGroup events of the thread's queue by the NetCon
+// events they stand for. Used before saving or transferring the queue.
+void nrn_fanout_delay_group_events(NrnThread* nt) {
+    NetCvode* ns = net_cvode_instance;
+    if (!ns || nt->id >= ns->pcnt_) {
+        return;
+    }
+    nrn_interthread_enqueue(nt);
+    std::vector<TQItem*> items;
+    delay_group_items_ = &items;
+    TQueue* tq = ns->p[nt->id].tqe_;
+    tq->forall_callback(delay_group_callback);
+    delay_group_items_ = nullptr;
+    for (TQItem* q: items) {
+        double td = q->t_;
+        auto* g = static_cast<NetConDelayGroup*>(q->data_);
+        tq->remove(q);
+        g->fanout(td, ns);
+    }
+}
+
 void PreSyn::pgvts_deliver(double tt, NetCvode* ns) {
     NrnThread* nt = 0;
     assert(0);
@@ -4134,6 +4271,7 @@ void NetCvode::record_init() {
     for (auto& item: *prl_) {
         item->record_init();
     }
+    RecordingSet::record_init_all();
 }
 
 void NetCvode::play_init() {
@@ -4707,6 +4845,7 @@ NetCon::NetCon(PreSyn* src, Object* target) {
     if (src_) {
         src_->dil_.push_back(this);
         src_->use_min_delay_ = 0;
+        src_->use_delay_groups_ = false;
     }
     if (target == nullptr) {
         target_ = nullptr;
@@ -4750,6 +4889,7 @@ NetCon::~NetCon() {
 
 void NetCon::rmsrc() {
     if (src_) {
+        src_->forget_delay_group_target(this);
         for (size_t i = 0; i < src_->dil_.size(); ++i) {
             if (src_->dil_[i] == this) {
                 src_->dil_.erase(src_->dil_.begin() + i);
@@ -4771,6 +4911,7 @@ void NetCon::replace_src(PreSyn* p) {
     if (src_) {
         src_->dil_.push_back(this);
         src_->use_min_delay_ = 0;
+        src_->use_delay_groups_ = false;
     }
 }
 
@@ -4924,6 +5065,10 @@ void NetCvode::p_construct(int n) {
     }
     for (i = 0; i < n; ++i) {
         p[i].unreffed_event_cnt_ = 0;
+        // one lane per thread that can send events and one for the interpreter
+        if (int(p[i].ite_lanes_.size()) < nrn_nthread + 1) {
+            p[i].ite_lanes_.resize(nrn_nthread + 1);
+        }
     }
 }
 
@@ -4939,6 +5084,7 @@ PreSyn::PreSyn(neuron::container::data_handle<double> src, Object* osrc, Section
     ssrc_ = ssrc;
     threshold_ = 10.;
     use_min_delay_ = 0;
+    use_delay_groups_ = false;
     tvec_ = nullptr;
     idvec_ = nullptr;
     stmt_ = nullptr;
@@ -5521,6 +5667,13 @@ void Cvode::check_deliver(NrnThread* nt) {
     }
 }
 
+// RecordingSet grows on the main thread, before the jobs that record nstep steps
+void NetCvode::fixed_record_prepare(int nstep) {
+    if (RecordingSet::any()) {
+        RecordingSet::prepare_all(nstep);
+    }
+}
+
 void NetCvode::fixed_record_continuous(neuron::model_sorted_token const& cache_token,
                                        NrnThread& nt) {
     nrn_ba(cache_token, nt, BEFORE_STEP);
@@ -5529,6 +5682,16 @@ void NetCvode::fixed_record_continuous(neuron::model_sorted_token const& cache_t
             pr->continuous(nt._t);
         }
     }
+    if (RecordingSet::any()) {
+        RecordingSet::continuous_all(nt, nt._t);
+    }
+}
+
+// and reports there the errors of the jobs
+void NetCvode::fixed_record_check() {
+    if (RecordingSet::any()) {
+        RecordingSet::check_overflow_all();
+    }
 }
 
 void NetCvode::fixed_play_continuous(NrnThread* nt) {
@@ -5991,15 +6154,19 @@ tryagain:
             p[tid].enqueue(this, nt);
         }
 #endif
-        while ((q = p[tid].tqe_->dequeue_bin()) != 0) {
-            DiscreteEvent* db = (DiscreteEvent*) q->data_;
+        if (nrn_use_batch_receive_) {
+            deliver_bin_batched(nt);
+        } else {
+            while ((q = p[tid].tqe_->dequeue_bin()) != 0) {
+                DiscreteEvent* db = (DiscreteEvent*) q->data_;
 #if PRINT_EVENT
-            if (print_event_) {
-                db->pr("binq deliver", nt_t, this);
-            }
+                if (print_event_) {
+                    db->pr("binq deliver", nt_t, this);
+                }
 #endif
-            p[tid].tqe_->release(q);
-            db->deliver(nt->_t, this, nt);
+                p[tid].tqe_->release(q);
+                db->deliver(nt->_t, this, nt);
+            }
         }
         //		assert(int(tm/nt->_dt)%1000 == p[tid].tqe_->nshift_);
     }
@@ -6015,6 +6182,120 @@ tryagain:
     nt->_t = tsav;
 }
 
+// Empties the current bin like the loop in deliver_net_events but, instead
+// of calling NET_RECEIVE once per event, collects the NetCon events (also
+// those of a PreSyn or NetConDelayGroup) and delivers them with one call per
+// mechanism type. Any other event delivers the NetCon events collected so
+// far before it is delivered itself, so only NetCon events of the same bin
+// are reordered, and the stable sort keeps their order per target.
+void NetCvode::deliver_bin_batched(NrnThread* nt) {
+    NetCvodeThreadData& d = p[nt->id];
+    auto& batch = d.receive_batch_;
+    TQItem* q;
+    while ((q = d.tqe_->dequeue_bin()) != 0) {
+        DiscreteEvent* db = (DiscreteEvent*) q->data_;
+#if PRINT_EVENT
+        if (print_event_) {
+            db->pr("binq deliver", nt_t, this);
+        }
+#endif
+        d.tqe_->release(q);
+        switch (db->type()) {
+        case NetConType:
+            batch.push_back(static_cast<NetCon*>(db));
+            break;
+        case NetConDelayGroupType: {
+            auto* g = static_cast<NetConDelayGroup*>(db);
+            assert(nt == g->nt_);
+            for (std::size_t i = g->begin_; i < g->end_; ++i) {
+                NetCon* nc = g->src_->delay_group_targets_[i];
+                if (nc && nc->active_ && nc->target_ && PP2NT(nc->target_) == nt) {
+                    STATISTICS(deliver_cnt_);
+                    batch.push_back(nc);
+                }
+            }
+            break;
+        }
+        case PreSynType: {
+            auto* ps = static_cast<PreSyn*>(db);
+            if (ps->qthresh_) {
+                deliver_receive_batch(nt);
+                ps->deliver(nt->_t, this, nt);
+                break;
+            }
+            STATISTICS(PreSyn::presyn_deliver_netcon_);
+            for (const auto& nc: ps->dil_) {
+                if (nc->active_ && nc->target_ && PP2NT(nc->target_) == nt) {
+                    double dtt = nc->delay_ - ps->delay_;
+                    if (dtt == 0.) {
+                        STATISTICS(PreSyn::presyn_deliver_direct_);
+                        STATISTICS(deliver_cnt_);
+                        batch.push_back(nc);
+                    } else if (dtt < 0.) {
+                        hoc_execerror("internal error: Source delay is > NetCon delay", 0);
+                    } else {
+                        STATISTICS(PreSyn::presyn_deliver_ncsend_);
+                        event(nt->_t + dtt, nc, nt);
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            deliver_receive_batch(nt);
+            db->deliver(nt->_t, this, nt);
+        }
+    }
+    deliver_receive_batch(nt);
+}
+
+void NetCvode::deliver_receive_batch(NrnThread* nt) {
+    NetCvodeThreadData& d = p[nt->id];
+    auto& batch = d.receive_batch_;
+    if (batch.empty()) {
+        return;
+    }
+    std::stable_sort(batch.begin(), batch.end(), [](NetCon* a, NetCon* b) {
+        return a->target_->prop->_type < b->target_->prop->_type;
+    });
+    for (auto first = batch.begin(); first != batch.end();) {
+        int type = (*first)->target_->prop->_type;
+        auto last = std::find_if(first, batch.end(), [type](NetCon* nc) {
+            return nc->target_->prop->_type != type;
+        });
+        if (!pnt_receive_batch[type] || (nrn_use_selfqueue_ && nrn_is_artificial_[type])) {
+            // earlier self events have to be delivered per target first
+            for (auto it = first; it != last; ++it) {
+                (*it)->deliver(nt->_t, this, nt);
+            }
+            first = last;
+            continue;
+        }
+        std::string ss("net-receive-");
+        ss += memb_func[type].sym->name;
+        nrn::Instrumentor::phase p_get_pnt_receive(ss.c_str());
+        d.batch_pnts_.clear();
+        d.batch_args_.clear();
+        for (auto it = first; it != last; ++it) {
+            assert(PP2NT((*it)->target_) == nt);
+            STATISTICS(NetCon::netcon_deliver_);
+            d.batch_pnts_.push_back((*it)->target_);
+            d.batch_args_.push_back((*it)->weight_);
+        }
+        (*pnt_receive_batch[type])(d.batch_pnts_.data(),
+                                   d.batch_args_.data(),
+                                   int(d.batch_pnts_.size()),
+                                   0.);
+        if (errno) {
+            if (nrn_errno_check(type)) {
+                hoc_warning("errno set during NetCon deliver to NET_RECEIVE", (char*) 0);
+            }
+        }
+        first = last;
+    }
+    batch.clear();
+}
+
 void NetCvode::playrec_add(PlayRecord* pr) {  // called by PlayRecord constructor
                                               // printf("NetCvode::playrec_add %p\n", pr);
     playrec_change_cnt_ = 0;
@@ -6803,21 +7084,21 @@ void* nrn_interthread_enqueue(NrnThread* nt) {
 }
 
 void NetCvode::set_enqueueing() {
-    MUTLOCK
-    enqueueing_ = 1;
-    MUTUNLOCK
+    // Read first so that the senders do not keep taking the cache line from
+    // each other. The flag is read after the job is joined, relaxed is enough.
+    if (!enqueueing_.load(std::memory_order_relaxed)) {
+        enqueueing_.store(true, std::memory_order_relaxed);
+    }
 }
 
 double NetCvode::allthread_least_t(int& tid) {
     // reduce (take minimum) of p[i].tqe_->least_t()
     double tt, min = 1e50;
-    // setting enqueueing_ in interthread_send was a race. Logically it is not
-    // needed. It is not clear if higher performance would result in having
-    // a MUTEX for the NetCvode instance but that is the current implementation
-    // instead of commenting out the enqueuing related lines.
-    if (enqueueing_) {
+    // enqueueing_ is not logically needed but avoids a nrn_multithread_job
+    // that would do nothing if there are no interthread events.
+    if (enqueueing_.load(std::memory_order_relaxed)) {
         nrn_multithread_job(nrn_interthread_enqueue);
-        enqueueing_ = 0;
+        enqueueing_.store(false, std::memory_order_relaxed);
     }
     for (int id = 0; id < pcnt_; ++id) {
         tt = p[id].tqe_->least_t();
@@ -8,7 +8,9 @@
 #include "neuron/container/data_handle.hpp"
 #include "tqueue.hpp"
 
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -17,6 +19,7 @@ class PreSyn;
 class HocDataPaths;
 using PreSynTable = std::unordered_map<neuron::container::data_handle<double>, PreSyn*>;
 class NetCon;
+struct Point_process;
 class DiscreteEvent;
 class SelfEvent;
 using SelfEventPool = MutexPool<SelfEvent>;
@@ -38,13 +41,33 @@ class HocEvent;
 typedef std::vector<HocEvent*> HocEventList;
 struct BAMech;
 struct Section;
-struct InterThreadEvent;
+
+struct InterThreadEvent {
+    DiscreteEvent* de_;
+    double t_;
+};
+
+// Events sent to a thread from one source thread. Only the job of that thread
+// appends to it, but the destination takes the events during its own jobs,
+// possibly while the source sends, so both sides hold mut_. A lane has one
+// sender, so the lock is not contended by other senders.
+struct alignas(64) InterThreadLane {
+    InterThreadLane() = default;
+    // for resizing the vector of lanes, which happens only between runs
+    InterThreadLane(InterThreadLane&& other) noexcept
+        : events_{std::move(other.events_)} {}
+    std::mutex mut_;
+    std::vector<InterThreadEvent> events_;
+};
 
 class NetCvodeThreadData {
   public:
     NetCvodeThreadData();
     virtual ~NetCvodeThreadData();
-    void interthread_send(double, DiscreteEvent*, NrnThread*);
+    /** Send an event to thread nt from the job of thread src, or from the
+     *  interpreter if src is nullptr.
+     */
+    void interthread_send(double, DiscreteEvent*, NrnThread* nt, NrnThread* src);
     void enqueue(NetCvode*, NrnThread*);
     TQueue* tq_;  // for lvardt
     Cvode* lcv_;  // for lvardt
@@ -52,12 +75,14 @@ class NetCvodeThreadData {
     hoc_Item* psl_thr_;  // for presyns with fixed step threshold checking
     SelfEventPool* sepool_;
     TQItemPool* tpool_;
-    InterThreadEvent* inter_thread_events_;
+    std::vector<InterThreadLane> ite_lanes_;  // indexed by the source thread
+    std::vector<InterThreadEvent> ite_drain_;  // a lane's events, taken by enqueue
+    // NetCon events of one bin, delivered by mechanism type
+    std::vector<NetCon*> receive_batch_;
+    std::vector<Point_process*> batch_pnts_;
+    std::vector<double*> batch_args_;
     SelfQueue* selfqueue_;
-    MUTDEC
     int nlcv_;
-    int ite_cnt_;
-    int ite_size_;
     int unreffed_event_cnt_;
     double immediate_deliver_;
 };
@@ -104,6 +129,8 @@ class NetCvode {
     void presyn_disconnect(PreSyn*);
     void check_thresh(NrnThread*);
     void deliver_net_events(NrnThread*);          // for default staggered time step method
+    void deliver_bin_batched(NrnThread*);         // bin queue of deliver_net_events
+    void deliver_receive_batch(NrnThread*);
     void deliver_events(double til, NrnThread*);  // for initialization events
     void solver_prepare();
     void clear_events();
@@ -132,7 +159,9 @@ class NetCvode {
     void vec_remove();
     void record_init();
     void play_init();
+    void fixed_record_prepare(int nstep);
     void fixed_record_continuous(neuron::model_sorted_token const&, NrnThread& nt);
+    void fixed_record_check();
     void fixed_play_continuous(NrnThread*);
     static double eps(double x) {
         return eps_ * std::abs(x);
@@ -247,11 +276,10 @@ class NetCvode {
     HTListList wl_list_;  // nrn_nthread of these for faster deliver_net_events when many cvode
     int pcnt_;
     NetCvodeThreadData* p;
-    int enqueueing_;
+    std::atomic<bool> enqueueing_;
     int use_long_double_;
 
   public:
-    MUTDEC  // only for enqueueing_ so far.
     void set_enqueueing();
     double allthread_least_t(int& tid);
     int solve_when_threads(double);
@@ -13,6 +13,7 @@
 #include "membfunc.h"
 #include "nonvintblock.h"
 #include "nrndigest.h"
+#include "recordingset.h"
 
 #include <cerrno>
 #include <numeric>
@@ -1103,6 +1104,9 @@ void Cvode::record_continuous() {
         record_continuous_thread(nth_);
     } else {
         auto const sorted_token = nrn_ensure_model_data_are_sorted();
+        if (RecordingSet::any()) {
+            RecordingSet::prepare_all(1);
+        }
         for (int i = 0; i < nrn_nthread; ++i) {
             NrnThread* nt = nrn_threads + i;
             CvodeThreadData& z = ctd_[i];
@@ -1114,6 +1118,12 @@ void Cvode::record_continuous() {
                     item->continuous(t_);
                 }
             }
+            if (RecordingSet::any()) {
+                RecordingSet::continuous_all(*nt, t_);
+            }
+        }
+        if (RecordingSet::any()) {
+            RecordingSet::check_overflow_all();
         }
     }
 }
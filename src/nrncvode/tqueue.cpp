@@ -37,12 +37,17 @@ of struct _spblk, we are really using TQItem
 #define cnt       cnt_
 #define key       t_
 #include <sptree.hpp>
+#include <calqueue.hpp>
 
 // extern double dt;
 #define nt_dt nrn_threads->_dt
 
 void (*nrn_binq_enqueue_error_handler)(double, TQItem*);
 
+// see CVode.queue_mode. Selects the backend of the NetCvodeThreadData::tqe_
+// event queues constructed afterwards.
+bool nrn_use_calendar_queue_;
+
 static void prnt(const TQItem* b, int level) {
     int i;
     for (i = 0; i < level; ++i) {
@@ -56,11 +61,17 @@ static void prnt(const TQItem* b, int level) {
            fmt::ptr(b->data_));
 }
 
-TQueue::TQueue(TQItemPool* tp, int mkmut) {
+TQueue::TQueue(TQItemPool* tp, int mkmut, bool calendar) {
     MUTCONSTRUCT(mkmut)
     tpool_ = tp;
     nshift_ = 0;
-    sptree_ = new SPTree<TQItem>();
+    if (calendar) {
+        sptree_ = nullptr;
+        calq_ = new CalQueue<TQItem>();
+    } else {
+        sptree_ = new SPTree<TQItem>();
+        calq_ = nullptr;
+    }
     binq_ = new BinQ;
     least_ = 0;
 
@@ -72,10 +83,11 @@ TQueue::TQueue(TQItemPool* tp, int mkmut) {
 
 TQueue::~TQueue() {
     TQItem *q, *q2;
-    while ((q = sptree_->dequeue()) != nullptr) {
+    while ((q = q_dequeue()) != nullptr) {
         deleteitem(q);
     }
     delete sptree_;
+    delete calq_;
     for (q = binq_->first(); q; q = q2) {
         q2 = binq_->next(q);
         remove(q);
@@ -88,12 +100,52 @@ void TQueue::deleteitem(TQItem* i) {
     tpool_->hpfree(i);
 }
 
+bool TQueue::q_empty() const {
+    return calq_ ? calq_->empty() : sptree_->empty();
+}
+
+void TQueue::q_enqueue(TQItem* i) {
+    if (calq_) {
+        calq_->enqueue(i);
+    } else {
+        sptree_->enqueue(i);
+    }
+}
+
+TQItem* TQueue::q_dequeue() {
+    return calq_ ? calq_->dequeue() : sptree_->dequeue();
+}
+
+TQItem* TQueue::q_first() {
+    return calq_ ? calq_->first() : sptree_->first();
+}
+
+void TQueue::q_remove(TQItem* i) {
+    if (calq_) {
+        calq_->remove(i);
+    } else {
+        sptree_->remove(i);
+    }
+}
+
+TQItem* TQueue::q_find(double t) {
+    return calq_ ? calq_->find(t) : sptree_->find(t);
+}
+
+void TQueue::q_apply_all(void (*f)(const TQItem*, int)) {
+    if (calq_) {
+        calq_->apply_all(f, nullptr);
+    } else {
+        sptree_->apply_all(f, nullptr);
+    }
+}
+
 void TQueue::print() {
     MUTLOCK
     if (least_) {
         prnt(least_, 0);
     }
-    sptree_->apply_all(prnt, nullptr);
+    q_apply_all(prnt);
     for (TQItem* q = binq_->first(); q; q = binq_->next(q)) {
         prnt(q, 0);
     }
@@ -105,7 +157,7 @@ void TQueue::forall_callback(void (*f)(const TQItem*, int)) {
     if (least_) {
         f(least_, 0);
     }
-    sptree_->apply_all(f, nullptr);
+    q_apply_all(f);
     for (TQItem* q = binq_->first(); q; q = binq_->next(q)) {
         f(q, 0);
     }
@@ -118,7 +170,7 @@ void TQueue::check(const char* mes) {}
 // Assume not using bin queue.
 TQItem* TQueue::second_least(double t) {
     assert(least_);
-    TQItem* b = sptree_->first();
+    TQItem* b = q_first();
     if (b && b->t_ == t) {
         return b;
     }
@@ -135,11 +187,11 @@ void TQueue::move_least_nolock(double tnew) {
     TQItem* b = least();
     if (b) {
         b->t_ = tnew;
-        TQItem* nl = sptree_->first();
+        TQItem* nl = q_first();
         if (nl) {
             if (tnew > nl->t_) {
-                least_ = sptree_->dequeue();
-                sptree_->enqueue(b);
+                least_ = q_dequeue();
+                q_enqueue(b);
             }
         }
     }
@@ -151,14 +203,14 @@ void TQueue::move(TQItem* i, double tnew) {
     if (i == least_) {
         move_least_nolock(tnew);
     } else if (tnew < least_->t_) {
-        sptree_->remove(i);
+        q_remove(i);
         i->t_ = tnew;
-        sptree_->enqueue(least_);
+        q_enqueue(least_);
         least_ = i;
     } else {
-        sptree_->remove(i);
+        q_remove(i);
         i->t_ = tnew;
-        sptree_->enqueue(i);
+        q_enqueue(i);
     }
     MUTUNLOCK
 }
@@ -171,7 +223,11 @@ void TQueue::statistics() {
            nrem,
            nleast);
     Printf("calls to find=%lu\n", nfind);
-    Printf("comparisons=%d\n", sptree_->get_enqcmps());
+    if (calq_) {
+        Printf("calendar queue resizes=%d\n", calq_->get_nresize());
+    } else {
+        Printf("comparisons=%d\n", sptree_->get_enqcmps());
+    }
 #else
     Printf("Turn on COLLECT_TQueue_STATISTICS_ in tqueue.hpp\n");
 #endif
@@ -196,11 +252,11 @@ TQItem* TQueue::insert(double t, void* d) {
     i->cnt_ = -1;
     if (t < least_t_nolock()) {
         if (least()) {
-            sptree_->enqueue(least());
+            q_enqueue(least());
         }
         least_ = i;
     } else {
-        sptree_->enqueue(i);
+        q_enqueue(i);
     }
     MUTUNLOCK
     return i;
@@ -227,15 +283,15 @@ void TQueue::remove(TQItem* q) {
     STAT(nrem);
     if (q) {
         if (q == least_) {
-            if (!sptree_->empty()) {
-                least_ = sptree_->dequeue();
+            if (!q_empty()) {
+                least_ = q_dequeue();
             } else {
                 least_ = nullptr;
             }
         } else if (q->cnt_ >= 0) {
             binq_->remove(q);
         } else {
-            sptree_->remove(q);
+            q_remove(q);
         }
         tpool_->hpfree(q);
     }
@@ -248,8 +304,8 @@ TQItem* TQueue::atomic_dq(double tt) {
     if (least_ && least_->t_ <= tt) {
         q = least_;
         STAT(nrem);
-        if (!sptree_->empty()) {
-            least_ = sptree_->dequeue();
+        if (!q_empty()) {
+            least_ = q_dequeue();
         } else {
             least_ = nullptr;
         }
@@ -261,12 +317,12 @@ TQItem* TQueue::atomic_dq(double tt) {
 TQItem* TQueue::find(double t) {
     TQItem* q;
     MUTLOCK
-    // search only in the  splay tree. if this is a bug then fix it.
+    // search only in the splay tree (or calendar queue). if this is a bug then fix it.
     STAT(nfind)
     if (t == least_t_nolock()) {
         q = least();
     } else {
-        q = sptree_->find(t);
+        q = q_find(t);
     }
     MUTUNLOCK
     return (q);
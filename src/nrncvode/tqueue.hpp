@@ -20,10 +20,17 @@ using TQItemPool = MutexPool<TQItem>;
 // and forall_callback does the splay tree first and then the bin (so
 // not in time order)
 // The bin part assumes a fixed step method.
+// A TQueue constructed with calendar = true uses a calendar queue
+// (calqueue.hpp) instead of the splay tree. Its items must only change time
+// through move(), never by assigning t_.
 
 #define COLLECT_TQueue_STATISTICS 1
 template <typename T>
 class SPTree;
+template <typename T>
+class CalQueue;
+
+extern bool nrn_use_calendar_queue_;
 
 // helper class for the TQueue (SplayTBinQueue).
 class BinQ {
@@ -62,7 +69,7 @@ class BinQ {
 
 class TQueue {
   public:
-    TQueue(TQItemPool*, int mkmut = 0);
+    TQueue(TQItemPool*, int mkmut = 0, bool calendar = false);
     virtual ~TQueue();
 
     TQItem* least() {
@@ -123,6 +130,9 @@ class TQueue {
     BinQ* binq() {
         return binq_;
     }
+    bool uses_calendar_queue() const {
+        return calq_ != nullptr;
+    }
 
   private:
     double least_t_nolock() {
@@ -133,7 +143,17 @@ class TQueue {
         }
     }
     void move_least_nolock(double tnew);
+    // All items other than least_ and the bin items are in exactly one of
+    // sptree_ or calq_ (the other is nullptr).
+    bool q_empty() const;
+    void q_enqueue(TQItem*);
+    TQItem* q_dequeue();
+    TQItem* q_first();
+    void q_remove(TQItem*);
+    TQItem* q_find(double);
+    void q_apply_all(void (*)(const TQItem*, int));
     SPTree<TQItem>* sptree_;
+    CalQueue<TQItem>* calq_;
     BinQ* binq_;
     TQItem* least_;
     TQItemPool* tpool_;
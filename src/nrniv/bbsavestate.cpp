@@ -206,6 +206,7 @@ extern Section** secorder;
 extern ReceiveFunc* pnt_receive;
 extern NetCvode* net_cvode_instance;
 extern TQueue* net_cvode_instance_event_queue(NrnThread*);
+extern void nrn_fanout_delay_group_events(NrnThread*);
 extern cTemplate** nrn_pnt_template_;
 extern void nrn_netcon_event(NetCon*, double);
 extern double t;
@@ -822,6 +823,7 @@ void bbss_save_done(void* bbss) {
 
 static void bbss_remove_delivered() {
     TQueue* tq = net_cvode_instance_event_queue(nrn_threads);
+    nrn_fanout_delay_group_events(nrn_threads);
 
     // PreSyn and NetCon spikes are on the queue. To determine the spikes
     // that have already been delivered the PreSyn items that have
@@ -1417,6 +1419,7 @@ void BBSaveState::mk_pp2de() {
         }
     }
     TQueue* tq = net_cvode_instance_event_queue(nrn_threads);
+    nrn_fanout_delay_group_events(nrn_threads);
     callback_mode = 0;
     tq->forall_callback(tqcallback);
 }
@@ -2405,6 +2408,7 @@ static void scatteritems() {
     // reused by bbss_queuecheck and the error in that context will
     // be analyzed there.
     // assert(tq->least_t() > nrn_threads->_t);
+    nrn_fanout_delay_group_events(nrn_threads);
     callback_mode = 1;
     tq->forall_callback(tqcallback);
     // space inefficient but simple support analogous to pc.all2all
@@ -13,7 +13,7 @@ extern void Graph_reg(), HBox_reg(), VBox_reg(), GUIMath_reg(), PWManager_reg(),
     Random_reg(), Shape_reg(), PlotShape_reg(), PPShape_reg(), RangeVarPlot_reg(),
     SectionBrowser_reg(), MechanismStandard_reg(), MechanismType_reg(), NetCon_reg(),
     LinearMechanism_reg(), KSChan_reg(), Impedance_reg(), SaveState_reg(), BBSaveState_reg(),
-    FInitializeHandler_reg(), StateTransitionEvent_reg(), nrnpython_reg(),
+    FInitializeHandler_reg(), StateTransitionEvent_reg(), RecordingSet_reg(), nrnpython_reg(),
 #if USEDASPK
     Daspk_reg(),
 #endif
@@ -68,6 +68,7 @@ void hoc_class_registration(void) {
       BBSaveState_reg,
       FInitializeHandler_reg,
       StateTransitionEvent_reg,
+      RecordingSet_reg,
       nrnpython_reg,
       NMODLRandom_reg,
 #if USEDASPK
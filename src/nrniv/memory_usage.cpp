@@ -23,6 +23,7 @@ cache::ModelMemoryUsage memory_usage(const neuron::cache::Model& model) {
     VectorMemoryUsage thread(model.thread);
     for (const auto& t: model.thread) {
         thread += VectorMemoryUsage(t.mechanism_offset);
+        thread += VectorMemoryUsage(t.mechanism_node_map);
     }
 
     VectorMemoryUsage mechanism(model.mechanism);
@@ -43,10 +44,16 @@ cache::ModelMemoryUsage memory_usage(const neuron::cache::Model& model) {
     return {thread, mechanism};
 }
 
+SortTiming model_sort_timing{};
+
 MemoryUsage local_memory_usage() {
+    // the stale cache is kept until the next sort
+    auto cache_model = memory_usage(neuron::cache::model);
+    cache_model += memory_usage(neuron::cache::stale_model);
     return MemoryUsage{memory_usage(model()),
-                       memory_usage(neuron::cache::model),
-                       detail::compute_defer_delete_storage_size()};
+                       cache_model,
+                       detail::compute_defer_delete_storage_size(),
+                       model_sort_timing};
 }
 
 namespace detail {
@@ -130,6 +137,13 @@ std::string format_memory_usage(const MemoryUsage& usage) {
     os << "  convenient            " << format_memory(summary.convenient) << "\n";
     os << "  oversized             " << format_memory(summary.oversized) << "\n";
     os << "  leaked                " << format_memory(summary.leaked) << "\n";
+    os << "\n";
+    os << "Model sorting\n";
+    os << "  full                  " << fmt::format("{:6d}", usage.sort_timing.full) << "\n";
+    os << "  incremental           " << fmt::format("{:6d}", usage.sort_timing.incremental)
+       << "\n";
+    os << "  last                  " << fmt::format("{:9.6f} s", usage.sort_timing.last) << "\n";
+    os << "  total                 " << fmt::format("{:9.6f} s", usage.sort_timing.total) << "\n";
 
 
     return os.str();
@@ -346,16 +346,16 @@ double nrn_multisend_receive_time(int type) {  // and others
         break;
     case 8:  // exchange method properties
              // bit 0: 0 allgather, 1 multisend (MPI_ISend)
-             // bit 1: unused, legacy
+             // bit 1: 1 sparse exchange (MPI neighbour collectives)
              // bit 2: n_multisend_interval, 0 means one interval, 1 means 2
              // bit 3: number of phases, 0 means 1 phase, 1 means 2
-             // bit 4: unused (1 used to mean althash used)
+             // bit 4: 1 node aware Allgather (shared memory window per node)
              // bit 5: 1 means enqueue separated into two parts for timeing
     {
         int method = use_multisend_ ? 1 : 0;
-        int p = method + 4 * (n_multisend_interval == 2 ? 1 : 0) + 8 * use_phase2_ +
-                16 * (0)  // no hash selection, just std::unordered_map
-                + 32 * ENQUEUE;
+        int p = method + 2 * (use_sparse_exchange_ ? 1 : 0) +
+                4 * (n_multisend_interval == 2 ? 1 : 0) + 8 * use_phase2_ +
+                16 * (use_node_exchange_ ? 1 : 0) + 32 * ENQUEUE;
         rt = double(p);
     } break;
     case 12:  // greatest length multisend
@@ -564,6 +564,7 @@ void nrn_multisend_cleanup_presyn(PreSyn* ps) {
 }
 
 static void nrn_multisend_cleanup() {
+    sparse_exchange_ready_ = false;
     for (const auto& iter: gid2out_) {
         nrn_multisend_cleanup_presyn(iter.second);
     }
@@ -614,12 +615,16 @@ static void ensure_ntarget_gt_3(Multisend_Send* bs) {
 
 #include "multisend_setup.cpp"
 
+static void sparse_exchange_setup();
+
 void nrn_multisend_setup() {
     nrn_multisend_cleanup();
-    if (!use_multisend_) {
+    if (!use_multisend_ && !use_sparse_exchange_) {
         return;
     }
-    nrnmpi_multisend_comm();
+    if (use_multisend_) {
+        nrnmpi_multisend_comm();
+    }
     // if (nrnmpi_myid == 0) printf("nrn_multisend_setup()\n");
     // although we only care about the set of hosts that gid2out_
     // sends spikes to (source centric). We do not want to send
@@ -636,6 +641,11 @@ void nrn_multisend_setup() {
     // completely new algorithm does one and two phase.
     setup_presyn_multisend_lists();
 
+    if (use_sparse_exchange_) {
+        sparse_exchange_setup();
+        return;
+    }
+
     if (!multisend_receive_buffer[0]) {
         multisend_receive_buffer[0] = new Multisend_ReceiveBuffer();
     }
@@ -644,6 +654,125 @@ void nrn_multisend_setup() {
     }
 }
 
+/*
+Sparse exchange (xchng_meth bit 1). Uses the same (one phase) target host
+lists as multisend, but spikes are accumulated in spikeout_ as for the
+Allgather method and, once per minimum delay interval, each rank sends its
+spikes only to the ranks that have a NetCon for the spike's gid. The
+exchange is done with MPI neighbour collectives over a distributed graph
+communicator created here, so a rank only receives spikes it may need and
+only communicates with its neighbours in the network connectivity graph.
+*/
+static std::vector<int> sparse_dest_;        // ranks this rank sends spikes to
+static std::vector<int> sparse_dest_index_;  // rank -> index into sparse_dest_ (or -1)
+static std::vector<int> sparse_scnt_;  // spikes per destination
+static std::vector<int> sparse_fill_;  // fill position per destination in sparse_sbuf_
+static std::vector<NRNMPI_Spike> sparse_sbuf_;
+
+static void sparse_exchange_setup() {
+#if nrn_spikebuf_size > 0
+    hoc_execerror("The sparse spike exchange method requires nrn_spikebuf_size == 0", nullptr);
+#endif
+    int np = nrnmpi_numprocs;
+    // is_dest[i] is 1 if rank i has a target for some output gid of this rank.
+    std::vector<int> is_dest(np, 0);
+    for (const auto& iter: gid2out_) {
+        PreSyn* ps = iter.second;
+        if (ps->output_index_ >= 0 && ps->bgp.multisend_send_) {
+            Multisend_Send* bs = ps->bgp.multisend_send_;
+            for (int i = 0; i < bs->ntarget_hosts_; ++i) {
+                is_dest[bs->target_hosts_[i]] = 1;
+            }
+        }
+    }
+    // and the transpose tells which ranks will send to this rank.
+    std::vector<int> is_src(np, 0);
+    nrnmpi_int_alltoall(is_dest.data(), is_src.data(), 1);
+
+    std::vector<int> srcs;
+    sparse_dest_.clear();
+    sparse_dest_index_.assign(np, -1);
+    for (int i = 0; i < np; ++i) {
+        if (is_dest[i]) {
+            sparse_dest_index_[i] = int(sparse_dest_.size());
+            sparse_dest_.push_back(i);
+        }
+        if (is_src[i]) {
+            srcs.push_back(i);
+        }
+    }
+    sparse_scnt_.assign(sparse_dest_.size(), 0);
+    sparse_fill_.assign(sparse_dest_.size(), 0);
+    nrnmpi_spike_graph_create(int(srcs.size()),
+                              srcs.data(),
+                              int(sparse_dest_.size()),
+                              sparse_dest_.data());
+    sparse_exchange_ready_ = true;
+}
+
+static void nrn_spike_exchange_sparse(NrnThread* nt) {
+    nsend_ += nout_;
+    if (nsendmax_ < nout_) {
+        nsendmax_ = nout_;
+    }
+    double wt = nrnmpi_wtime();
+    // count spikes per destination, then pack in destination order
+    std::fill(sparse_scnt_.begin(), sparse_scnt_.end(), 0);
+    for (int i = 0; i < nout_; ++i) {
+        const auto iter = gid2out_.find(spikeout_[i].gid);
+        nrn_assert(iter != gid2out_.end());
+        // As with multisend, an output gid created after the last
+        // ParallelContext.set_maxstep has no target list.
+        Multisend_Send* bs = iter->second->bgp.multisend_send_;
+        if (!bs) {
+            continue;
+        }
+        for (int j = 0; j < bs->ntarget_hosts_; ++j) {
+            ++sparse_scnt_[sparse_dest_index_[bs->target_hosts_[j]]];
+        }
+    }
+    int ntotal = 0;
+    for (std::size_t k = 0; k < sparse_scnt_.size(); ++k) {
+        sparse_fill_[k] = ntotal;
+        ntotal += sparse_scnt_[k];
+    }
+    if (sparse_sbuf_.size() < std::size_t(ntotal)) {
+        sparse_sbuf_.resize(ntotal);
+    }
+    for (int i = 0; i < nout_; ++i) {
+        Multisend_Send* bs = gid2out_.find(spikeout_[i].gid)->second->bgp.multisend_send_;
+        if (!bs) {
+            continue;
+        }
+        for (int j = 0; j < bs->ntarget_hosts_; ++j) {
+            sparse_sbuf_[sparse_fill_[sparse_dest_index_[bs->target_hosts_[j]]]++] = spikeout_[i];
+        }
+    }
+    nout_ = 0;
+    if (nrnmpi_step_wait_ >= 0.) {
+        double w = nrnmpi_wtime();
+        nrnmpi_barrier();
+        nrnmpi_step_wait_ += nrnmpi_wtime() - w;
+    }
+    int n = nrnmpi_spike_exchange_graph(sparse_scnt_.data(),
+                                        sparse_sbuf_.data(),
+                                        &spikein_,
+                                        &icapacity_);
+    wt_ = nrnmpi_wtime() - wt;
+    wt = nrnmpi_wtime();
+    errno = 0;
+    nrecv_ += n;
+    for (int i = 0; i < n; ++i) {
+        auto iter = gid2in_.find(spikein_[i].gid);
+        if (iter != gid2in_.end()) {
+            PreSyn* ps = iter->second;
+            ps->send(spikein_[i].spiketime, net_cvode_instance, nt);
+            ++nrecv_useful_;
+        }
+    }
+    wt1_ = nrnmpi_wtime() - wt;
+}
+
 #ifdef USENCS
 
 // give me data on which gids of this node send out APs
@@ -194,6 +194,12 @@ static void nrn_spike_exchange_compressed(NrnThread*);
 
 #if NRNMPI
 bool use_multisend_;  // false: allgather, true: multisend (MPI_ISend)
+// true: neighbour collectives to the target ranks only (see multisend.cpp)
+static bool use_sparse_exchange_;
+// true: node aware Allgather in a shared memory window per node (see mpispike.cpp)
+static bool use_node_exchange_;
+static bool sparse_exchange_ready_;
+static void nrn_spike_exchange_sparse(NrnThread*);
 static void nrn_multisend_setup();
 static void nrn_multisend_init();
 static void nrn_multisend_receive(NrnThread*);
@@ -502,6 +508,10 @@ void nrn_spike_exchange_init() {
     if (use_multisend_) {
         nrn_multisend_init();
     }
+    if (use_sparse_exchange_ && !sparse_exchange_ready_) {
+        // method changed since the last ParallelContext.set_maxstep
+        nrn_multisend_setup();
+    }
 #endif
 
     if (n_npe_ != nrn_nthread) {
@@ -561,6 +571,10 @@ void nrn_spike_exchange(NrnThread* nt) {
         nrn_multisend_receive(nt);
         return;
     }
+    if (use_sparse_exchange_) {
+        nrn_spike_exchange_sparse(nt);
+        return;
+    }
 #endif
     if (use_compress_) {
         nrn_spike_exchange_compressed(nt);
@@ -1454,6 +1468,12 @@ The situation that needs to be captured by xchng_meth is
 
 0: Allgather
 1: multisend implemented as MPI_ISend
+2: sparse exchange, i.e. spikes sent once per interval only to the ranks
+   that have targets for them, using MPI neighbour collectives
+   (ignored if bit 0 is set)
+16: node aware Allgather, i.e. the ranks of a node gather their spikes in
+   shared memory and only one rank per node takes part in the internode
+   Allgather (ignored if bit 0 or 1 is set)
 
 n_multisend_interval 1 or 2 per minimum interprocessor NetCon delay
  that concept valid for all methods
@@ -1488,7 +1508,26 @@ int nrnmpi_spike_compress(int nspike, bool gid_compress, int xchng_meth) {
     if (nspike >= 0) {  // otherwise don't set any multisend properties
         n_multisend_interval = (xchng_meth & 4) ? 2 : 1;
         use_multisend_ = (xchng_meth & 1) == 1;
+        use_sparse_exchange_ = !use_multisend_ && (xchng_meth & 2) == 2;
         use_phase2_ = (xchng_meth & 8) ? 1 : 0;
+        bool node_exchange = !use_multisend_ && !use_sparse_exchange_ && (xchng_meth & 16);
+        use_node_exchange_ = nrnmpi_spike_node_create(node_exchange ? 1 : 0) > 0;
+        if (node_exchange && !use_node_exchange_ && nrnmpi_myid == 0) {
+            Printf("Notice: no two ranks share a node, the node aware exchange is not used.\n");
+        }
+        if (use_sparse_exchange_) {
+            // one phase target lists, exchanged once per interval
+            n_multisend_interval = 1;
+            use_phase2_ = 0;
+            if (nspike > 0) {
+                if (nrnmpi_myid == 0) {
+                    Printf(
+                        "Notice: spike compression is not used with the sparse spike "
+                        "exchange method.\n");
+                }
+                nspike = 0;
+            }
+        }
         if (use_multisend_) {
             assert(NRNMPI);
         }
@@ -31,6 +31,7 @@ extern NrnMappingInfo mapinfo;
 extern NetCvode* net_cvode_instance;
 extern char* pnt_map;
 extern void* nrn_interthread_enqueue(NrnThread*);
+extern void nrn_fanout_delay_group_events(NrnThread*);
 
 /** Populate function pointers by mapping function pointers for callback */
 void map_coreneuron_callbacks(void* handle) {
@@ -1054,6 +1055,8 @@ NrnCoreTransferEvents* nrn2core_transfer_tqueue(int tid) {
     auto& cg = cellgroups_[tid];
     // make sure all buffered interthread events are on the queue
     nrn_interthread_enqueue(&nt);
+    // CoreNEURON only knows NetCon and PreSyn spikes
+    nrn_fanout_delay_group_events(&nt);
 
     // Iterate over all tqueue items to record info needed for transfer to
     // coreneuron. The atomic_dq removes items from the queue but misses
@@ -22,7 +22,7 @@ extern NetCvode* net_cvode_instance;
 extern void (*nrnthread_v_transfer_)(NrnThread*);
 
 int chkpnt;
-const char* bbcore_write_version = "1.8";  // Include ArrayDims
+const char* bbcore_write_version = "1.9";  // Align arrays after chkpnt lines
 
 /// create directory with given path
 void create_dir_path(const std::string& path) {
@@ -295,20 +295,33 @@ void write_nrnthread(const char* path, NrnThread& nt, CellGroup& cg) {
 }
 
 
+// Arrays start at a multiple of chkpnt_align bytes from the beginning of the
+// file so that CoreNEURON can use them directly from a memory mapping.
+// The chkpnt line is padded with blanks to get there.
+static constexpr long chkpnt_align = 64;
+
+void writechkpnt_(int n, FILE* f) {
+    long pos = ftell(f);
+    assert(pos >= 0);
+    int len = fprintf(f, "chkpnt %d", n);
+    int pad = int((chkpnt_align - (pos + len + 1) % chkpnt_align) % chkpnt_align);
+    fprintf(f, "%*s\n", pad, "");
+}
+
 void writeint_(int* p, size_t size, FILE* f) {
-    fprintf(f, "chkpnt %d\n", chkpnt++);
+    writechkpnt_(chkpnt++, f);
     size_t n = fwrite(p, sizeof(int), size, f);
     assert(n == size);
 }
 
 void writedbl_(double* p, size_t size, FILE* f) {
-    fprintf(f, "chkpnt %d\n", chkpnt++);
+    writechkpnt_(chkpnt++, f);
     size_t n = fwrite(p, sizeof(double), size, f);
     assert(n == size);
 }
 
 void write_uint32vec(std::vector<uint32_t>& vec, FILE* f) {
-    fprintf(f, "chkpnt %d\n", chkpnt++);
+    writechkpnt_(chkpnt++, f);
     size_t n = fwrite(vec.data(), sizeof(uint32_t), vec.size(), f);
     assert(n == vec.size());
 }
@@ -27,6 +27,7 @@ extern int chkpnt;
 void write_memb_mech_types(const char* fname);
 void write_globals(const char* fname);
 void write_nrnthread(const char* fname, NrnThread& nt, CellGroup& cg);
+void writechkpnt_(int n, FILE* f);
 void writeint_(int* p, size_t size, FILE* f);
 void writedbl_(double* p, size_t size, FILE* f);
 
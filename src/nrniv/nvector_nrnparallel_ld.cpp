@@ -127,6 +127,10 @@ N_Vector N_VNewEmpty_NrnParallelLD(MPI_Comm comm, long int local_length, long in
     ops->nvinvtest = N_VInvTest_NrnParallelLD;
     ops->nvconstrmask = N_VConstrMask_NrnParallelLD;
     ops->nvminquotient = N_VMinQuotient_NrnParallelLD;
+    ops->nvlinearcombination = NULL;
+    ops->nvscaleaddmulti = NULL;
+    ops->nvlinearsumvectorarray = NULL;
+    ops->nvscalevectorarray = NULL;
 
     /* Create content */
     content = (N_VectorContent_NrnParallelLD) malloc(sizeof(struct _N_VectorContent_NrnParallelLD));
@@ -229,6 +233,10 @@ N_Vector N_VCloneEmpty_NrnParallelLD(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvlinearcombination = w->ops->nvlinearcombination;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
+    ops->nvlinearsumvectorarray = w->ops->nvlinearsumvectorarray;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
 
     /* Create content */
     content = (N_VectorContent_NrnParallelLD) malloc(sizeof(struct _N_VectorContent_NrnParallelLD));
@@ -112,6 +112,10 @@ N_Vector N_VNewEmpty_NrnSerialLD(long int length) {
     ops->nvinvtest = N_VInvTest_NrnSerialLD;
     ops->nvconstrmask = N_VConstrMask_NrnSerialLD;
     ops->nvminquotient = N_VMinQuotient_NrnSerialLD;
+    ops->nvlinearcombination = NULL;
+    ops->nvscaleaddmulti = NULL;
+    ops->nvlinearsumvectorarray = NULL;
+    ops->nvscalevectorarray = NULL;
 
     /* Create content */
     content = (N_VectorContent_NrnSerialLD) malloc(sizeof(struct _N_VectorContent_NrnSerialLD));
@@ -213,6 +217,10 @@ N_Vector N_VCloneEmpty_NrnSerialLD(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvlinearcombination = w->ops->nvlinearcombination;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
+    ops->nvlinearsumvectorarray = w->ops->nvlinearsumvectorarray;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
 
     /* Create content */
     content = (N_VectorContent_NrnSerialLD) malloc(sizeof(struct _N_VectorContent_NrnSerialLD));
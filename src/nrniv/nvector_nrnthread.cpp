@@ -18,6 +18,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 
 #include "shared/nvector_serial.h"
 #include "nvector_nrnthread.h"
@@ -53,6 +54,12 @@ static realtype b_;
 static realtype c_;
 static realtype retval;
 static booleantype bretval;
+/* fused operations */
+static int nvec_;
+static realtype* carr_;
+static N_Vector* Xarr_;
+static N_Vector* Yarr_;
+static N_Vector* Zarr_;
 #define xpass    x_ = x;
 #define ypass    y_ = y;
 #define zpass    z_ = z;
@@ -61,6 +68,11 @@ static booleantype bretval;
 #define apass    a_ = a;
 #define bpass    b_ = b;
 #define cpass    c_ = c;
+#define nvecpass nvec_ = nvec;
+#define carrpass carr_ = c;
+#define Xarrpass Xarr_ = X;
+#define Yarrpass Yarr_ = Y;
+#define Zarrpass Zarr_ = Z;
 #define xarg(i)  NV_SUBVEC_NT(x_, i)
 #define yarg(i)  NV_SUBVEC_NT(y_, i)
 #define zarg(i)  NV_SUBVEC_NT(z_, i)
@@ -149,6 +161,10 @@ N_Vector N_VNewEmpty_NrnThread(long int length, int nthread, long int* sizes) {
     ops->nvinvtest = N_VInvTest_NrnThread;
     ops->nvconstrmask = N_VConstrMask_NrnThread;
     ops->nvminquotient = N_VMinQuotient_NrnThread;
+    ops->nvlinearcombination = N_VLinearCombination_NrnThread;
+    ops->nvscaleaddmulti = N_VScaleAddMulti_NrnThread;
+    ops->nvlinearsumvectorarray = N_VLinearSumVectorArray_NrnThread;
+    ops->nvscalevectorarray = N_VScaleVectorArray_NrnThread;
 
     /* Create content */
     content = (N_VectorContent_NrnThread) malloc(sizeof(struct _N_VectorContent_NrnThread));
@@ -259,6 +275,10 @@ N_Vector N_VCloneEmpty_NrnThread(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvlinearcombination = w->ops->nvlinearcombination;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
+    ops->nvlinearsumvectorarray = w->ops->nvlinearsumvectorarray;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
 
     /* Create content */
     content = (N_VectorContent_NrnThread) malloc(sizeof(struct _N_VectorContent_NrnThread));
@@ -783,3 +803,68 @@ realtype N_VMinQuotient_NrnThread(N_Vector x, N_Vector y) /* num, denom */
     mydebug2("vminquotient %.20g\n", retval);
     return (retval);
 }
+
+/* The fused operations do all their single operations in one thread job,
+   each thread with the serial fused operation on its subvectors. */
+
+/* the subvectors of thread i of the nvec_ vectors of V */
+static N_Vector* subvecs(N_Vector* V, int i, std::vector<N_Vector>& sub) {
+    sub.resize(nvec_);
+    for (int k = 0; k < nvec_; ++k) {
+        sub[k] = NV_SUBVEC_NT(V[k], i);
+    }
+    return sub.data();
+}
+static thread_local std::vector<N_Vector> xsub_, ysub_, zsub_;
+
+static void* vlinearcombination(NrnThread* nt) {
+    int i = nt->id;
+    N_VLinearCombination_Serial(nvec_, carr_, subvecs(Xarr_, i, xsub_), zarg(i));
+    return nullptr;
+}
+void N_VLinearCombination_NrnThread(int nvec, realtype* c, N_Vector* X, N_Vector z) {
+    nvecpass carrpass Xarrpass zpass nrn_multithread_job(vlinearcombination);
+    mydebug("vlinearcombination\n");
+}
+
+static void* vscaleaddmulti(NrnThread* nt) {
+    int i = nt->id;
+    N_VScaleAddMulti_Serial(
+        nvec_, carr_, xarg(i), subvecs(Yarr_, i, ysub_), subvecs(Zarr_, i, zsub_));
+    return nullptr;
+}
+void N_VScaleAddMulti_NrnThread(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_Vector* Z) {
+    carr_ = a;
+    nvecpass xpass Yarrpass Zarrpass nrn_multithread_job(vscaleaddmulti);
+    mydebug("vscaleaddmulti\n");
+}
+
+static void* vlinearsumvectorarray(NrnThread* nt) {
+    int i = nt->id;
+    N_VLinearSumVectorArray_Serial(nvec_,
+                                   aarg,
+                                   subvecs(Xarr_, i, xsub_),
+                                   barg,
+                                   subvecs(Yarr_, i, ysub_),
+                                   subvecs(Zarr_, i, zsub_));
+    return nullptr;
+}
+void N_VLinearSumVectorArray_NrnThread(int nvec,
+                                       realtype a,
+                                       N_Vector* X,
+                                       realtype b,
+                                       N_Vector* Y,
+                                       N_Vector* Z) {
+    nvecpass apass Xarrpass bpass Yarrpass Zarrpass nrn_multithread_job(vlinearsumvectorarray);
+    mydebug("vlinearsumvectorarray\n");
+}
+
+static void* vscalevectorarray(NrnThread* nt) {
+    int i = nt->id;
+    N_VScaleVectorArray_Serial(nvec_, carr_, subvecs(Xarr_, i, xsub_), subvecs(Zarr_, i, zsub_));
+    return nullptr;
+}
+void N_VScaleVectorArray_NrnThread(int nvec, realtype* c, N_Vector* X, N_Vector* Z) {
+    nvecpass carrpass Xarrpass Zarrpass nrn_multithread_job(vscalevectorarray);
+    mydebug("vscalevectorarray\n");
+}
@@ -287,3 +287,12 @@ void N_VCompare_NrnThread(realtype c, N_Vector x, N_Vector z);
 booleantype N_VInvTest_NrnThread(N_Vector x, N_Vector z);
 booleantype N_VConstrMask_NrnThread(N_Vector c, N_Vector x, N_Vector m);
 realtype N_VMinQuotient_NrnThread(N_Vector num, N_Vector denom);
+void N_VLinearCombination_NrnThread(int nvec, realtype* c, N_Vector* X, N_Vector z);
+void N_VScaleAddMulti_NrnThread(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_Vector* Z);
+void N_VLinearSumVectorArray_NrnThread(int nvec,
+                                       realtype a,
+                                       N_Vector* X,
+                                       realtype b,
+                                       N_Vector* Y,
+                                       N_Vector* Z);
+void N_VScaleVectorArray_NrnThread(int nvec, realtype* c, N_Vector* X, N_Vector* Z);
@@ -150,6 +150,10 @@ N_Vector N_VNewEmpty_NrnThreadLD(long int length, int nthread, long int* sizes)
     ops->nvinvtest = N_VInvTest_NrnThreadLD;
     ops->nvconstrmask = N_VConstrMask_NrnThreadLD;
     ops->nvminquotient = N_VMinQuotient_NrnThreadLD;
+    ops->nvlinearcombination = NULL;
+    ops->nvscaleaddmulti = NULL;
+    ops->nvlinearsumvectorarray = NULL;
+    ops->nvscalevectorarray = NULL;
 
     /* Create content */
     content = (N_VectorContent_NrnThreadLD) malloc(sizeof(struct _N_VectorContent_NrnThreadLD));
@@ -260,6 +264,10 @@ N_Vector N_VCloneEmpty_NrnThreadLD(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvlinearcombination = w->ops->nvlinearcombination;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
+    ops->nvlinearsumvectorarray = w->ops->nvlinearsumvectorarray;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
 
     /* Create content */
     content = (N_VectorContent_NrnThreadLD) malloc(sizeof(struct _N_VectorContent_NrnThreadLD));
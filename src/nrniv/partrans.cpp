@@ -13,7 +13,10 @@
 #include <mymath.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <complex>
+#include <limits>
+#include <tuple>
 #include <unordered_map>  // Replaces NrnHash for MapSgid2Int
 #include <utility>
 #include <vector>
@@ -68,6 +71,7 @@ static void sgid_alltoallv(Data<sgid_t>& s, Data<sgid_t>& r) {
 #endif  // not NRNLONGSGID
 
 extern const char* bbcore_write_version;
+extern void writechkpnt_(int n, FILE* f);
 // see lengthy comment in ../nrnoc/fadvance.cpp
 // nrnmpi_v_transfer requires existence of nrnthread_v_transfer even if there
 // is only one thread.
@@ -144,11 +148,47 @@ extern void (*nrnthread_v_transfer_)(NrnThread*);  // before nonvint and BEFORE
 extern void (*nrnthread_vi_compute_)(NrnThread*);
 extern void (*nrnmpi_v_transfer_)();  // before nrnthread_v_transfer and after update. Called by
                                       // thread 0.
+extern void (*nrnmpi_v_transfer_post_)();  // split phase nrnmpi_v_transfer_ for one thread
+extern void (*nrnmpi_v_transfer_wait_)();  // set while the posted transfer is pending
+extern int nrnmpi_v_transfer_type_;        // lowest mechanism type owning a target
 extern void (*nrn_mk_transfer_thread_data_)();
+extern void (*nrn_mk_transfer_tables_)();  // after the model data are sorted
 #if NRNMPI
 extern double nrnmpi_transfer_wait_;
 #endif
 
+// The copies of a transfer compiled from data handles into (storage, index)
+// form. The copies are grouped by source and target storage and sorted by
+// index within a group, so each group is a plain gather/scatter loop without
+// the per value indirection through the handles. Rebuilt by mk_transfer_tables
+// whenever the model data are sorted. Not valid if a handle could not be
+// resolved, in which case the copies go through the handles (and report the
+// error).
+struct TransferTable {
+    struct Group {
+        double* src;
+        double* tgt;
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<Group> groups;
+    std::vector<int> src_index;
+    std::vector<int> tgt_index;
+    bool valid = false;
+
+    void copy() const {
+        const int* const si = src_index.data();
+        const int* const ti = tgt_index.data();
+        for (const auto& g: groups) {
+            const double* const src = g.src;
+            double* const tgt = g.tgt;
+            for (std::size_t k = g.begin; k < g.end; ++k) {
+                tgt[ti[k]] = src[si[k]];
+            }
+        }
+    }
+};
+
 struct TransferThreadData {
     int cnt;
     std::vector<neuron::container::data_handle<double>> tv;  // pointers to the
@@ -156,6 +196,7 @@ struct TransferThreadData {
     std::vector<neuron::container::data_handle<double>> sv;  // pointers to the
                                                              // ParallelContext.source_var (or into
                                                              // MPI target buffer)
+    TransferTable table;  // tv[i] = sv[i] in (storage, index) form
 };
 static TransferThreadData* transfer_thread_data_;
 static int n_transfer_thread_data_;
@@ -180,6 +221,7 @@ static std::vector<neuron::container::data_handle<double>> poutsrc_;  // prior t
                                                                       // to proper place in
                                                                       // outsrc_buf_
 static int* poutsrc_indices_;                                         // for recalc pointers
+static TransferTable outsrc_table_;  // outsrc_buf_[i] = *poutsrc_[i] in (storage, index) form
 static int insrc_buf_size_;
 static std::vector<int> insrccnt_;
 static std::vector<int> insrcdspl_;
@@ -425,6 +467,84 @@ static std::unordered_map<Node*, double*> mk_svibuf() {
     return ndvi2pd;
 }
 
+// Storage and index of a copy source or target. insrc_buf_ and the
+// source_vi_buf_ values are raw pointers into buffers owned here.
+static std::pair<double*, std::size_t> storage_and_index(
+    neuron::container::data_handle<double>& dh) {
+    auto const sto = dh.storage_and_offset();
+    double* const p = sto.first;
+    if (dh.refers_to_a_modern_data_structure() || !p) {
+        return sto;
+    }
+    if (insrc_buf_ && p >= insrc_buf_ && p < insrc_buf_ + insrc_buf_size_) {
+        return {insrc_buf_, std::size_t(p - insrc_buf_)};
+    }
+    for (auto& svb: source_vi_buf_) {
+        double* const val = svb.val.data();
+        if (p >= val && p < val + svb.cnt) {
+            return {val, std::size_t(p - val)};
+        }
+    }
+    return sto;
+}
+
+struct TransferCopy {
+    double* src;
+    double* tgt;
+    std::size_t src_index;
+    std::size_t tgt_index;
+};
+
+static void fill_transfer_table(TransferTable& tt, std::vector<TransferCopy>& copies) {
+    tt.groups.clear();
+    tt.src_index.clear();
+    tt.tgt_index.clear();
+    tt.valid = false;
+    for (const auto& c: copies) {
+        if (!c.src || !c.tgt || c.src_index > std::numeric_limits<int>::max() ||
+            c.tgt_index > std::numeric_limits<int>::max()) {
+            return;
+        }
+    }
+    std::sort(copies.begin(), copies.end(), [](const TransferCopy& a, const TransferCopy& b) {
+        return std::tie(a.src, a.tgt, a.tgt_index) < std::tie(b.src, b.tgt, b.tgt_index);
+    });
+    tt.src_index.reserve(copies.size());
+    tt.tgt_index.reserve(copies.size());
+    for (std::size_t k = 0; k < copies.size(); ++k) {
+        const auto& c = copies[k];
+        if (tt.groups.empty() || tt.groups.back().src != c.src || tt.groups.back().tgt != c.tgt) {
+            tt.groups.push_back({c.src, c.tgt, k, k});
+        }
+        tt.src_index.push_back(int(c.src_index));
+        tt.tgt_index.push_back(int(c.tgt_index));
+        tt.groups.back().end = k + 1;
+    }
+    tt.valid = true;
+}
+
+// Called at the end of mk_ttd and, as nrn_mk_transfer_tables_, whenever the
+// model data have been sorted.
+static void mk_transfer_tables() {
+    std::vector<TransferCopy> copies;
+    copies.reserve(outsrc_buf_size_);
+    for (int i = 0; i < outsrc_buf_size_; ++i) {
+        auto const [src, si] = storage_and_index(poutsrc_[i]);
+        copies.push_back({src, outsrc_buf_, si, std::size_t(i)});
+    }
+    fill_transfer_table(outsrc_table_, copies);
+    for (int tid = 0; tid < n_transfer_thread_data_; ++tid) {
+        TransferThreadData& ttd = transfer_thread_data_[tid];
+        copies.clear();
+        for (int i = 0; i < ttd.cnt; ++i) {
+            auto const [src, si] = storage_and_index(ttd.sv[i]);
+            auto const [tgt, ti] = storage_and_index(ttd.tv[i]);
+            copies.push_back({src, tgt, si, ti});
+        }
+        fill_transfer_table(ttd.table, copies);
+    }
+}
+
 static void mk_ttd() {
     int i, j, tid, n;
     auto ndvi2pd = mk_svibuf();
@@ -440,6 +560,7 @@ static void mk_ttd() {
         if (nrnmpi_numprocs > 1 && max_targets_) {
             nrnthread_v_transfer_ = thread_transfer;
         }
+        mk_transfer_tables();
         return;
     }
     n = targets_.size();
@@ -527,6 +648,7 @@ static void mk_ttd() {
         }
     }
     nrnthread_v_transfer_ = thread_transfer;
+    mk_transfer_tables();
 }
 
 static void thread_vi_compute(NrnThread* _nt) {
@@ -545,11 +667,36 @@ static void thread_vi_compute(NrnThread* _nt) {
     }
 }
 
-static void mpi_transfer() {
-    int i, n = outsrc_buf_size_;
-    for (i = 0; i < n; ++i) {
+#if NRNMPI
+static void* transfer_request_;
+
+static void mpi_transfer_wait() {
+    nrnmpi_v_transfer_wait_ = nullptr;
+    double wt = nrnmpi_wtime();
+    nrnmpi_wait(&transfer_request_);
+    nrnmpi_transfer_wait_ += nrnmpi_wtime() - wt;
+    errno = 0;
+}
+#endif
+
+static void gather_outsrc() {
+    if (outsrc_table_.valid) {
+        outsrc_table_.copy();
+        return;
+    }
+    int n = outsrc_buf_size_;
+    for (int i = 0; i < n; ++i) {
         outsrc_buf_[i] = *poutsrc_[i];
     }
+}
+
+static void mpi_transfer() {
+#if NRNMPI
+    if (nrnmpi_v_transfer_wait_) {  // outsrc_buf_ may still be in use
+        (*nrnmpi_v_transfer_wait_)();
+    }
+#endif
+    gather_outsrc();
 #if NRNMPI
     if (nrnmpi_numprocs > 1) {
         double wt = nrnmpi_wtime();
@@ -575,6 +722,30 @@ static void mpi_transfer() {
     // insrc_buf_ will get transferred to targets by thread_transfer
 }
 
+// Same as mpi_transfer but only starts the exchange. nonvint completes it with
+// nrnmpi_v_transfer_wait_ before the first mechanism that may own a target.
+// The sparse exchange is not split.
+static void mpi_transfer_post() {
+#if NRNMPI
+    if (nrn_sparse_partrans > 0) {
+        mpi_transfer();
+        return;
+    }
+    if (nrnmpi_v_transfer_wait_) {
+        (*nrnmpi_v_transfer_wait_)();
+    }
+    gather_outsrc();
+    nrnmpi_dbl_ialltoallv(outsrc_buf_,
+                          outsrccnt_.data(),
+                          outsrcdspl_.data(),
+                          insrc_buf_,
+                          insrccnt_.data(),
+                          insrcdspl_.data(),
+                          &transfer_request_);
+    nrnmpi_v_transfer_wait_ = mpi_transfer_wait;
+#endif
+}
+
 static void thread_transfer(NrnThread* _nt) {
     if (!is_setup_) {
         hoc_execerror("ParallelContext.setup_transfer()", "needs to be called.");
@@ -600,6 +771,10 @@ static void thread_transfer(NrnThread* _nt) {
     // do the transfer.
     assert(n_transfer_thread_data_ == nrn_nthread);
     TransferThreadData& ttd = transfer_thread_data_[_nt->id];
+    if (ttd.table.valid) {
+        ttd.table.copy();
+        return;
+    }
     for (int i = 0; i < ttd.cnt; ++i) {
         *(ttd.tv[i]) = *(ttd.sv[i]);
     }
@@ -628,10 +803,14 @@ void nrnmpi_setup_transfer() {
 #endif
     int nhost = nrnmpi_numprocs;
     is_setup_ = true;
+    if (nrnmpi_v_transfer_wait_) {
+        (*nrnmpi_v_transfer_wait_)();
+    }
     delete_imped_info();
     delete[] std::exchange(insrc_buf_, nullptr);
     delete[] std::exchange(outsrc_buf_, nullptr);
     outsrc_buf_size_ = 0;
+    outsrc_table_ = {};
     sid2insrc_.clear();
     poutsrc_.clear();
     delete[] std::exchange(poutsrc_indices_, nullptr);
@@ -757,18 +936,32 @@ void nrnmpi_setup_transfer() {
         // from sid2insrc_, mk_ttd can construct the right pointer to the source.
 
         nrnmpi_v_transfer_ = mpi_transfer;
+        nrnmpi_v_transfer_post_ = mpi_transfer_post;
+        // states of mechanisms before the first one owning a target can be
+        // computed while the transfer is in flight. A target_var without a
+        // point process could be anything.
+        nrnmpi_v_transfer_type_ = n_memb_func;
+        for (auto* pp: target_pntlist_) {
+            int type = pp ? pp->prop->_type : 0;
+            nrnmpi_v_transfer_type_ = std::min(nrnmpi_v_transfer_type_, type);
+        }
     }
 #endif  // NRNMPI
     nrn_mk_transfer_thread_data_ = mk_ttd;
+    nrn_mk_transfer_tables_ = mk_transfer_tables;
     if (!v_structure_change) {
         mk_ttd();
     }
 }
 
 void nrn_partrans_clear() {
+    if (nrnmpi_v_transfer_wait_) {
+        (*nrnmpi_v_transfer_wait_)();
+    }
     nrnthread_v_transfer_ = nullptr;
     nrnthread_vi_compute_ = nullptr;
     nrnmpi_v_transfer_ = nullptr;
+    nrnmpi_v_transfer_post_ = nullptr;
     sgid2srcindex_.clear();
     sgids_.resize(0);
     visources_.resize(0);
@@ -781,11 +974,13 @@ void nrn_partrans_clear() {
     delete[] std::exchange(insrc_buf_, nullptr);
     delete[] std::exchange(outsrc_buf_, nullptr);
     outsrc_buf_size_ = 0;
+    outsrc_table_ = {};
     sid2insrc_.clear();
     poutsrc_.clear();
     delete[] std::exchange(poutsrc_indices_, nullptr);
     non_vsrc_update_info_.clear();
     nrn_mk_transfer_thread_data_ = nullptr;
+    nrn_mk_transfer_tables_ = nullptr;
 }
 
 // assume one thread and no extracellular
@@ -1011,7 +1206,7 @@ size_t nrnbbcore_gap_write(const char* path, int* group_ids) {
         fprintf(f, "%d nsrc\n", nsrc);
 
         int chkpnt = 0;
-#define CHKPNT fprintf(f, "chkpnt %d\n", chkpnt++);
+#define CHKPNT writechkpnt_(chkpnt++, f);
 
         if (!g.src_sid.empty()) {
             CHKPNT fwrite(g.src_sid.data(), nsrc, sizeof(sgid_t), f);
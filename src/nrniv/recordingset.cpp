@@ -0,0 +1,373 @@
+#include <../../nrnconf.h>
+/*
+ record many variables per time step into one block.
+    rs = new RecordingSet([every [, float32]])
+    col = rs.add(&var)
+    col = rs.add(PtrVector)
+    rs.reserve(nrow)
+    val = rs.get(row, col)
+    rs.column(col, Vector)
+    rs.tvec(Vector)
+*/
+#include "classreg.h"
+#include "code.h"
+#include "oc2iv.h"
+#include "ocptrvector.h"
+#include "recordingset.h"
+#include "ivocvect.h"
+#include "membfunc.h"
+#include "multicore.h"
+#include "netcvode.h"
+#include "section.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+extern int cvode_active_;
+extern NetCvode* net_cvode_instance;
+extern double t;
+
+std::vector<RecordingSet*> RecordingSet::all_;
+
+RecordingSet::RecordingSet(int every, bool float32)
+    : every_{every}
+    , float32_{float32} {
+    all_.push_back(this);
+}
+
+RecordingSet::~RecordingSet() {
+    all_.erase(std::find(all_.begin(), all_.end(), this));
+}
+
+std::size_t RecordingSet::add(neuron::container::data_handle<double> dh) {
+    // the row layout changes, nothing is recorded until the next record_init
+    parts_.clear();
+    t_.clear();
+    handles_.push_back(std::move(dh));
+    return handles_.size() - 1;
+}
+
+std::size_t RecordingSet::add(OcPtrVector const& pv) {
+    parts_.clear();
+    t_.clear();
+    std::size_t const first = handles_.size();
+    handles_.insert(handles_.end(), pv.pd_.begin(), pv.pd_.end());
+    return first;
+}
+
+void RecordingSet::reserve(std::size_t nrow) {
+    t_.reserve(nrow);
+    grow(nrow);
+}
+
+void RecordingSet::remove_all() {
+    check_exports();
+    handles_.clear();
+    parts_.clear();
+    t_.clear();
+    dblock_ = {};
+    fblock_ = {};
+    capacity_ = 0;
+}
+
+std::size_t RecordingSet::nrow() const {
+    if (parts_.empty()) {
+        return 0;
+    }
+    // thread 0 records t, the others count only if they have columns
+    std::size_t n = parts_[0].nrow;
+    for (auto const& part: parts_) {
+        if (!part.pd.empty()) {
+            n = std::min(n, part.nrow);
+        }
+    }
+    return n;
+}
+
+void* RecordingSet::data() {
+    if (float32_) {
+        return fblock_.data();
+    }
+    return dblock_.data();
+}
+
+double RecordingSet::get(std::size_t row, std::size_t col) const {
+    std::size_t const i = row * handles_.size() + col;
+    return float32_ ? double(fblock_[i]) : dblock_[i];
+}
+
+void RecordingSet::check_exports() const {
+    if (exports_) {
+        hoc_execerror("RecordingSet",
+                      "block cannot be reallocated while exported to a Python buffer");
+    }
+}
+
+void RecordingSet::grow(std::size_t nrow) {
+    std::unique_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+    if (nrn_nthread > 1) {
+        lock.lock();
+    }
+    std::size_t const cap = capacity_;
+    if (nrow <= cap && (float32_ ? fblock_.size() : dblock_.size()) == cap * handles_.size()) {
+        return;
+    }
+    std::size_t const n = std::max(nrow, cap) * handles_.size();
+    if (exports_) {
+        if (lock.owns_lock()) {
+            lock.unlock();
+        }
+        check_exports();
+    }
+    if (float32_) {
+        fblock_.resize(n);
+    } else {
+        dblock_.resize(n);
+    }
+    capacity_ = std::max(nrow, cap);
+}
+
+// Thread of each handle. Data not in a thread, e.g. &t or a GLOBAL, goes to
+// thread 0, which is an error with more than one thread except for &t.
+static std::vector<int> handle_threads(
+    std::vector<neuron::container::data_handle<double>> const& handles) {
+    std::vector<int> ith(handles.size(), 0);
+    if (nrn_nthread == 1) {
+        return ith;
+    }
+    // one pass over the nodes instead of NetCvode::owned_by_thread per handle
+    std::unordered_map<double const*, int> owner;
+    for (int it = 0; it < nrn_nthread; ++it) {
+        NrnThread& nt = nrn_threads[it];
+        for (int in = 0; in < nt.end; ++in) {
+            Node* nd = nt._v_node[in];
+            owner.emplace(static_cast<double const*>(nd->v_handle()), it);
+            for (Prop* p = nd->prop; p; p = p->next) {
+                for (int i = 0; i < p->param_num_vars(); ++i) {
+                    for (int j = 0; j < p->param_array_dimension(i); ++j) {
+                        owner.emplace(&p->param(i, j), it);
+                    }
+                }
+            }
+            if (nd->extnode) {
+                for (int i = 0; i < nrn_nlayer_extracellular; ++i) {
+                    owner.emplace(nd->extnode->v + i, it);
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        auto const* pd = static_cast<double const*>(handles[i]);
+        if (auto const found = owner.find(pd); found != owner.end()) {
+            ith[i] = found->second;
+        } else if (pd != &t) {
+            hoc_execerr_ext("RecordingSet column %zu: unable to associate it with a thread", i);
+        }
+    }
+    return ith;
+}
+
+void RecordingSet::record_init() {
+    if (cvode_active_ && net_cvode_instance->is_local()) {
+        hoc_execerror("RecordingSet does not support the local variable time step method",
+                      nullptr);
+    }
+    for (std::size_t i = 0; i < handles_.size(); ++i) {
+        if (!handles_[i]) {
+            hoc_execerr_ext("RecordingSet column %zu recording from invalid data reference.", i);
+        }
+    }
+    auto const ith = handle_threads(handles_);
+    parts_.assign(nrn_nthread, Part{});
+    for (std::size_t i = 0; i < handles_.size(); ++i) {
+        Part& part = parts_[ith[i]];
+        part.pd.push_back(handles_[i]);
+        part.col.push_back(i);
+    }
+    t_.clear();
+    overflow_ = false;
+    grow(capacity_);  // a column may have been added since the block was sized
+}
+
+void RecordingSet::prepare(int nstep) {
+    if (parts_.empty() || exports_) {
+        return;  // an exported block stays, write drops the rows that do not fit
+    }
+    std::size_t const cap = capacity_;
+    std::size_t const need = parts_[0].nrow + (std::size_t(nstep) + every_ - 1) / every_;
+    if (need > cap) {
+        grow(std::max({std::size_t(16), 2 * cap, need}));
+    }
+}
+
+template <typename T>
+bool RecordingSet::write(Part& part, std::vector<T>& block) {
+    std::size_t const row = part.nrow;
+    std::shared_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+    if (nrn_nthread > 1) {
+        lock.lock();
+    }
+    // capacity_ changes only under the exclusive lock
+    while (row >= capacity_) {
+        if (exports_) {
+            // no hoc error on a worker thread, check_overflow raises it
+            overflow_ = true;
+            return false;
+        }
+        // a step that was not announced by prepare_all
+        if (lock.owns_lock()) {
+            lock.unlock();
+        }
+        grow(std::max(std::size_t(16), 2 * row));
+        if (nrn_nthread > 1) {
+            lock.lock();
+        }
+    }
+    T* const dst = block.data() + row * handles_.size();
+    auto* const pd = part.pd.data();
+    auto const* const col = part.col.data();
+    std::size_t const n = part.pd.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        dst[col[k]] = static_cast<T>(*pd[k]);
+    }
+    return true;
+}
+
+void RecordingSet::continuous(NrnThread& nt, double tt) {
+    if (std::size_t(nt.id) >= parts_.size()) {
+        return;  // not initialized since a column was added or the threads changed
+    }
+    Part& part = parts_[nt.id];
+    if (part.pd.empty() && nt.id != 0) {
+        return;
+    }
+    if (part.step++ % every_) {
+        return;
+    }
+    if (!(float32_ ? write(part, fblock_) : write(part, dblock_))) {
+        return;
+    }
+    if (nt.id == 0) {
+        t_.push_back(tt);
+    }
+    ++part.nrow;
+}
+
+void RecordingSet::check_overflow() {
+    if (overflow_.exchange(false)) {
+        check_exports();
+    }
+}
+
+void RecordingSet::record_init_all() {
+    for (auto* rs: all_) {
+        rs->record_init();
+    }
+}
+
+void RecordingSet::prepare_all(int nstep) {
+    for (auto* rs: all_) {
+        rs->prepare(nstep);
+    }
+}
+
+void RecordingSet::continuous_all(NrnThread& nt, double tt) {
+    for (auto* rs: all_) {
+        rs->continuous(nt, tt);
+    }
+}
+
+void RecordingSet::check_overflow_all() {
+    for (auto* rs: all_) {
+        rs->check_overflow();
+    }
+}
+
+static RecordingSet* rs_(void* v) {
+    return static_cast<RecordingSet*>(v);
+}
+
+static double add(void* v) {
+    hoc_return_type_code = HocReturnType::integer;
+    if (hoc_is_object_arg(1)) {
+        Object* ob = *hoc_objgetarg(1);
+        check_obj_type(ob, "PtrVector");
+        return double(rs_(v)->add(*static_cast<OcPtrVector*>(ob->u.this_pointer)));
+    }
+    return double(rs_(v)->add(hoc_hgetarg<double>(1)));
+}
+
+static double reserve(void* v) {
+    rs_(v)->reserve(std::size_t(chkarg(1, 0., 2e9)));
+    return 0.;
+}
+
+static double ncol(void* v) {
+    hoc_return_type_code = HocReturnType::integer;
+    return double(rs_(v)->ncol());
+}
+
+static double nrow(void* v) {
+    hoc_return_type_code = HocReturnType::integer;
+    return double(rs_(v)->nrow());
+}
+
+static double get(void* v) {
+    RecordingSet* rs = rs_(v);
+    auto const row = std::size_t(chkarg(1, 0., double(rs->nrow()) - 1.));
+    auto const col = std::size_t(chkarg(2, 0., double(rs->ncol()) - 1.));
+    return rs->get(row, col);
+}
+
+static double column(void* v) {
+    hoc_return_type_code = HocReturnType::integer;
+    RecordingSet* rs = rs_(v);
+    auto const col = std::size_t(chkarg(1, 0., double(rs->ncol()) - 1.));
+    Vect* dest = vector_arg(2);
+    std::size_t const n = rs->nrow();
+    dest->resize(n);
+    for (std::size_t row = 0; row < n; ++row) {
+        dest->elem(row) = rs->get(row, col);
+    }
+    return double(n);
+}
+
+static double tvec(void* v) {
+    hoc_return_type_code = HocReturnType::integer;
+    RecordingSet* rs = rs_(v);
+    Vect* dest = vector_arg(1);
+    std::size_t const n = rs->nrow();
+    dest->resize(n);
+    std::copy(rs->t().begin(), rs->t().begin() + n, dest->data());
+    return double(n);
+}
+
+static double remove_all(void* v) {
+    rs_(v)->remove_all();
+    return 0.;
+}
+
+static Member_func members[] = {{"add", add},
+                                {"reserve", reserve},
+                                {"ncol", ncol},
+                                {"nrow", nrow},
+                                {"get", get},
+                                {"column", column},
+                                {"tvec", tvec},
+                                {"remove_all", remove_all},
+                                {nullptr, nullptr}};
+
+static void* cons(Object*) {
+    int every = ifarg(1) ? int(chkarg(1, 1., 1e9)) : 1;
+    bool float32 = ifarg(2) ? bool(chkarg(2, 0., 1.)) : false;
+    return new RecordingSet(every, float32);
+}
+
+static void destruct(void* v) {
+    delete rs_(v);
+}
+
+void RecordingSet_reg() {
+    class2oc("RecordingSet", cons, destruct, members, nullptr, nullptr);
+}
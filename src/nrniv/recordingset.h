@@ -0,0 +1,98 @@
+#pragma once
+#include "neuron/container/data_handle.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <shared_mutex>
+#include <vector>
+
+struct NrnThread;
+struct OcPtrVector;
+
+/**
+ * @brief Records many variables per time step into one contiguous block.
+ *
+ * The block is row-major with one row per recorded step and one column per
+ * variable, i.e. a C ordered (nrow, ncol) array from Python. Where
+ * Vector.record has a PlayRecord and a Vector per variable, here the values of
+ * a step are copied in one loop over the handles owned by each thread. Every
+ * every-th step is recorded, as float if float32.
+ *
+ * The block grows by doubling unless reserve() was called with enough rows.
+ * The main thread grows it before the step jobs for the rows they will record
+ * (prepare_all), so the threads normally only write their columns of a row.
+ * While the block is exported to Python it must not move, so rows that do not fit are
+ * not recorded and check_overflow_all reports the error after the jobs.
+ */
+class RecordingSet {
+  public:
+    RecordingSet(int every, bool float32);
+    ~RecordingSet();
+
+    /** Add a column, returns its index. */
+    std::size_t add(neuron::container::data_handle<double> dh);
+    /** Add a column for each element of the PtrVector, returns the index of the first. */
+    std::size_t add(OcPtrVector const& pv);
+    void reserve(std::size_t nrow);
+    void remove_all();
+
+    [[nodiscard]] std::size_t ncol() const {
+        return handles_.size();
+    }
+    /** Number of rows recorded by all the threads. */
+    [[nodiscard]] std::size_t nrow() const;
+    [[nodiscard]] bool float32() const {
+        return float32_;
+    }
+    /** Start of the block, double or float. Moves when the block grows, which
+     *  is an error while it is exported. */
+    [[nodiscard]] void* data();
+    [[nodiscard]] double get(std::size_t row, std::size_t col) const;
+    [[nodiscard]] std::vector<double> const& t() const {
+        return t_;
+    }
+
+    void record_init();
+    void prepare(int nstep);
+    void continuous(NrnThread& nt, double t);
+    void check_overflow();
+
+    int exports_{};  // live Python buffers of the block, see nrnpy_hoc.cpp
+
+    static void record_init_all();
+    /** On the main thread, before steps that record with continuous_all. */
+    static void prepare_all(int nstep);
+    static void continuous_all(NrnThread& nt, double t);
+    /** On the main thread, after the steps. */
+    static void check_overflow_all();
+    [[nodiscard]] static bool any() {
+        return !all_.empty();
+    }
+
+  private:
+    // the columns recorded by one thread
+    struct Part {
+        std::vector<neuron::container::data_handle<double>> pd;
+        std::vector<std::size_t> col;
+        std::size_t nrow = 0;
+        int step = 0;
+    };
+
+    template <typename T>
+    bool write(Part& part, std::vector<T>& block);
+    void grow(std::size_t nrow);
+    void check_exports() const;
+
+    int every_;
+    bool float32_;
+    std::vector<neuron::container::data_handle<double>> handles_;
+    std::vector<Part> parts_;
+    std::vector<double> dblock_;
+    std::vector<float> fblock_;
+    std::atomic<std::size_t> capacity_{0};  // rows
+    std::vector<double> t_;
+    std::shared_mutex mutex_;
+    std::atomic<bool> overflow_{false};  // a row did not fit the exported block
+
+    static std::vector<RecordingSet*> all_;
+};
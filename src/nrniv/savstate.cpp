@@ -23,6 +23,7 @@ extern Section** secorder;
 extern ReceiveFunc* pnt_receive;
 extern NetCvode* net_cvode_instance;
 extern TQueue* net_cvode_instance_event_queue(NrnThread*);
+extern void nrn_fanout_delay_group_events(NrnThread*);
 extern std::vector<PreSyn*>* net_cvode_instance_psl();
 extern std::vector<PlayRecord*>* net_cvode_instance_prl();
 extern double t;
@@ -944,6 +945,10 @@ void SaveState::savenet() {
             ++i;
         }
     }
+    // only NetCon and PreSyn spikes can be saved
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        nrn_fanout_delay_group_events(nt);
+    }
     alloc_tq();
     tqcnt_ = 0;
     for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
@@ -20,8 +20,10 @@
 #include "mpispike.h"
 #include <mpi.h>
 
+#include <cstring>
 #include <limits>
 #include <string>
+#include <vector>
 
 #define nrn_mpi_assert(arg) nrn_assert(arg == MPI_SUCCESS)
 
@@ -97,6 +99,196 @@ static void make_spikebuf_type(int* nout_) {
 }
 #endif
 
+/*
+Node aware spike exchange (xchng_meth bit 4). The ranks that share memory
+(MPI_COMM_TYPE_SHARED) copy their contribution into a window shared by the
+node. One leader per node then exchanges, in place in the shared window, the
+contributions of its node with the other leaders and every rank copies the
+result from the shared window. Only the leaders send internode messages. The
+result is the same, and in the same rank order, as MPI_Allgather(v) over
+nrnmpi_comm.
+The contributions are stored in node order, i.e. the ranks of the first node,
+then those of the second node, etc. Two halves of the window are used
+alternately so that a rank may write its contribution to the next exchange
+while slower ranks of the node are still copying the result of this one.
+*/
+static MPI_Comm node_comm = MPI_COMM_NULL;
+static MPI_Comm node_leader_comm = MPI_COMM_NULL;
+static MPI_Win node_win = MPI_WIN_NULL;
+static char* node_buf;
+static MPI_Aint node_half_size;
+static int node_parity;
+static int node_rank;
+static int node_size;
+static int node_index;                // index of this node in node order
+static std::vector<int> node_order;   // global rank of each contribution in node order
+static std::vector<int> node_first;   // node order index of the first rank of each node
+static std::vector<int> node_offset;  // byte offset of each contribution in node order
+static std::vector<int> node_bcnt;    // byte count and displacement of each node
+static std::vector<int> node_bdispl;
+static std::vector<int> node_ucnt;  // for the fixed size allgather
+static std::vector<int> node_udispl;
+
+static void node_win_free() {
+    if (node_win != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(node_win);
+        MPI_Win_free(&node_win);
+        node_buf = nullptr;
+        node_half_size = 0;
+    }
+}
+
+// Collective over node_comm, all the ranks of the node must ask for the same
+// size (in bytes) which is the case as it only depends on the global counts.
+static void node_reserve(MPI_Aint size) {
+    if (size <= node_half_size) {
+        return;
+    }
+    node_win_free();
+    node_half_size = size + size / 2 + 1024;
+    nrn_mpi_assert(MPI_Win_allocate_shared(node_rank == 0 ? 2 * node_half_size : 0,
+                                           1,
+                                           MPI_INFO_NULL,
+                                           node_comm,
+                                           &node_buf,
+                                           &node_win));
+    if (node_rank != 0) {
+        MPI_Aint sz;
+        int disp_unit;
+        nrn_mpi_assert(MPI_Win_shared_query(node_win, 0, &sz, &disp_unit, &node_buf));
+    }
+    // passive target epoch so that MPI_Win_sync can be used
+    nrn_mpi_assert(MPI_Win_lock_all(MPI_MODE_NOCHECK, node_win));
+}
+
+static void node_sync() {
+    MPI_Win_sync(node_win);
+    MPI_Barrier(node_comm);
+    MPI_Win_sync(node_win);
+}
+
+/*
+Returns the maximum number of ranks per node, or 0 if the node aware exchange
+is not used (off, or no two ranks share a node). Collective over nrnmpi_comm.
+*/
+int nrnmpi_spike_node_create(int on) {
+    if (on && node_comm != MPI_COMM_NULL) {
+        return node_size;
+    }
+    node_win_free();
+    if (node_leader_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&node_leader_comm);
+    }
+    if (node_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&node_comm);
+    }
+    if (!on) {
+        return 0;
+    }
+    int nhost = nrnmpi_numprocs;
+    nrn_mpi_assert(MPI_Comm_split_type(
+        nrnmpi_comm, MPI_COMM_TYPE_SHARED, nrnmpi_myid, MPI_INFO_NULL, &node_comm));
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    int mx;
+    MPI_Allreduce(&node_size, &mx, 1, MPI_INT, MPI_MAX, nrnmpi_comm);
+    if (mx < 2) {
+        MPI_Comm_free(&node_comm);
+        return 0;
+    }
+    // the leader is the lowest global rank of the node
+    nrn_mpi_assert(MPI_Comm_split(
+        nrnmpi_comm, node_rank == 0 ? 0 : MPI_UNDEFINED, nrnmpi_myid, &node_leader_comm));
+    std::vector<int> members(node_size);
+    MPI_Allgather(&nrnmpi_myid, 1, MPI_INT, members.data(), 1, MPI_INT, node_comm);
+    int nnode = 0;
+    std::vector<int> nrank;
+    node_order.resize(nhost);
+    if (node_rank == 0) {
+        MPI_Comm_size(node_leader_comm, &nnode);
+        MPI_Comm_rank(node_leader_comm, &node_index);
+        nrank.resize(nnode);
+        node_first.resize(nnode + 1);
+        MPI_Allgather(&node_size, 1, MPI_INT, nrank.data(), 1, MPI_INT, node_leader_comm);
+        node_first[0] = 0;
+        for (int i = 0; i < nnode; ++i) {
+            node_first[i + 1] = node_first[i] + nrank[i];
+        }
+        MPI_Allgatherv(members.data(),
+                       node_size,
+                       MPI_INT,
+                       node_order.data(),
+                       nrank.data(),
+                       node_first.data(),
+                       MPI_INT,
+                       node_leader_comm);
+    }
+    MPI_Bcast(&nnode, 1, MPI_INT, 0, node_comm);
+    MPI_Bcast(&node_index, 1, MPI_INT, 0, node_comm);
+    node_first.resize(nnode + 1);
+    MPI_Bcast(node_first.data(), nnode + 1, MPI_INT, 0, node_comm);
+    MPI_Bcast(node_order.data(), nhost, MPI_INT, 0, node_comm);
+    node_offset.resize(nhost + 1);
+    node_bcnt.resize(nnode);
+    node_bdispl.resize(nnode);
+    node_ucnt.assign(nhost, 1);
+    node_udispl.resize(nhost);
+    for (int i = 0; i < nhost; ++i) {
+        node_udispl[i] = i;
+    }
+    node_parity = 0;
+    return mx;
+}
+
+// Same as MPI_Allgatherv(sendbuf, cnt[myid], T, recvbuf, cnt, displ, T,
+// nrnmpi_comm) where T is a contiguous type of elsize bytes.
+static void node_allgatherv(const void* sendbuf,
+                            void* recvbuf,
+                            const int* cnt,
+                            const int* displ,
+                            int elsize) {
+    int nhost = nrnmpi_numprocs;
+    int total = 0;
+    for (int k = 0; k < nhost; ++k) {
+        node_offset[k] = total;
+        total += cnt[node_order[k]] * elsize;
+    }
+    node_offset[nhost] = total;
+    node_reserve(total);
+    char* buf = node_buf + node_parity * node_half_size;
+    node_parity = 1 - node_parity;
+    int k = node_first[node_index] + node_rank;
+    std::memcpy(buf + node_offset[k], sendbuf, std::size_t(cnt[nrnmpi_myid]) * elsize);
+    node_sync();
+    if (node_rank == 0) {
+        int nnode = node_bcnt.size();
+        for (int i = 0; i < nnode; ++i) {
+            node_bdispl[i] = node_offset[node_first[i]];
+            node_bcnt[i] = node_offset[node_first[i + 1]] - node_bdispl[i];
+        }
+        nrn_mpi_assert(MPI_Allgatherv(MPI_IN_PLACE,
+                                      0,
+                                      MPI_DATATYPE_NULL,
+                                      buf,
+                                      node_bcnt.data(),
+                                      node_bdispl.data(),
+                                      MPI_BYTE,
+                                      node_leader_comm));
+    }
+    node_sync();
+    for (k = 0; k < nhost; ++k) {
+        int r = node_order[k];
+        std::memcpy(static_cast<char*>(recvbuf) + std::size_t(displ[r]) * elsize,
+                    buf + node_offset[k],
+                    node_offset[k + 1] - node_offset[k]);
+    }
+}
+
+// Same as MPI_Allgather(sendbuf, size, MPI_BYTE, recvbuf, size, MPI_BYTE, nrnmpi_comm)
+static void node_allgather(const void* sendbuf, void* recvbuf, int size) {
+    node_allgatherv(sendbuf, recvbuf, node_ucnt.data(), node_udispl.data(), size);
+}
+
 int nrnmpi_spike_exchange(int* ovfl,
                           int* nout_,
                           int* nin_,
@@ -115,7 +307,11 @@ int nrnmpi_spike_exchange(int* ovfl,
     }
     nrnbbs_context_wait();
 #if nrn_spikebuf_size == 0
-    MPI_Allgather(nout_, 1, MPI_INT, nin_, 1, MPI_INT, nrnmpi_comm);
+    if (node_comm != MPI_COMM_NULL) {
+        node_allgather(nout_, nin_, sizeof(int));
+    } else {
+        MPI_Allgather(nout_, 1, MPI_INT, nin_, 1, MPI_INT, nrnmpi_comm);
+    }
     n = nin_[0];
     for (i = 1; i < np; ++i) {
         displs[i] = n;
@@ -128,8 +324,12 @@ int nrnmpi_spike_exchange(int* ovfl,
             *spikein_ = (NRNMPI_Spike*) hoc_Emalloc(*icapacity_ * sizeof(NRNMPI_Spike));
             hoc_malchk();
         }
-        MPI_Allgatherv(
-            spikeout_, *nout_, spike_type, *spikein_, nin_, displs, spike_type, nrnmpi_comm);
+        if (node_comm != MPI_COMM_NULL) {
+            node_allgatherv(spikeout_, *spikein_, nin_, displs, sizeof(NRNMPI_Spike));
+        } else {
+            MPI_Allgatherv(
+                spikeout_, *nout_, spike_type, *spikein_, nin_, displs, spike_type, nrnmpi_comm);
+        }
     }
 #else
     MPI_Allgather(spbufout_, 1, spikebuf_type, spbufin_, 1, spikebuf_type, nrnmpi_comm);
@@ -207,7 +407,12 @@ int nrnmpi_spike_exchange_compressed(int localgid_size,
     }
     nrnbbs_context_wait();
 
-    MPI_Allgather(spfixout, ag_send_size, MPI_BYTE, spfixin, ag_send_size, MPI_BYTE, nrnmpi_comm);
+    if (node_comm != MPI_COMM_NULL) {
+        node_allgather(spfixout, spfixin, ag_send_size);
+    } else {
+        MPI_Allgather(
+            spfixout, ag_send_size, MPI_BYTE, spfixin, ag_send_size, MPI_BYTE, nrnmpi_comm);
+    }
     novfl = 0;
     ntot = 0;
     bstot = 0;
@@ -242,19 +447,101 @@ int nrnmpi_spike_exchange_compressed(int localgid_size,
         completely separate from the spfixin since the latter
         dynamically changes its size during a run.
         */
-        MPI_Allgatherv(spfixout + ag_send_size,
-                       bs,
-                       MPI_BYTE,
-                       *spfixin_ovfl,
-                       byteovfl,
-                       displs,
-                       MPI_BYTE,
-                       nrnmpi_comm);
+        if (node_comm != MPI_COMM_NULL) {
+            node_allgatherv(spfixout + ag_send_size, *spfixin_ovfl, byteovfl, displs, 1);
+        } else {
+            MPI_Allgatherv(spfixout + ag_send_size,
+                           bs,
+                           MPI_BYTE,
+                           *spfixin_ovfl,
+                           byteovfl,
+                           displs,
+                           MPI_BYTE,
+                           nrnmpi_comm);
+        }
     }
     *ovfl = novfl;
     return ntot;
 }
 
+/*
+Sparse spike exchange over a distributed graph communicator whose edges are
+the (source rank, target rank) pairs for which the target rank has at least
+one NetCon with a source gid on the source rank. The graph is created once
+per nrn_multisend_setup (i.e. ParallelContext.set_maxstep) and the exchange
+is a pair of neighbour collectives per minimum delay interval: the spike
+counts and then the spikes themselves.
+*/
+static MPI_Comm spike_graph_comm = MPI_COMM_NULL;
+static int spike_graph_nsrc;
+static int spike_graph_ndest;
+static int* spike_graph_rcnt;
+static int* spike_graph_rdispl;
+static int* spike_graph_sdispl;
+
+void nrnmpi_spike_graph_create(int nsrc, int* srcs, int ndest, int* dests) {
+    if (spike_graph_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&spike_graph_comm);
+    }
+    nrn_mpi_assert(MPI_Dist_graph_create_adjacent(nrnmpi_comm,
+                                                  nsrc,
+                                                  srcs,
+                                                  MPI_UNWEIGHTED,
+                                                  ndest,
+                                                  dests,
+                                                  MPI_UNWEIGHTED,
+                                                  MPI_INFO_NULL,
+                                                  0,
+                                                  &spike_graph_comm));
+    spike_graph_nsrc = nsrc;
+    spike_graph_ndest = ndest;
+    free(spike_graph_rcnt);
+    free(spike_graph_rdispl);
+    free(spike_graph_sdispl);
+    spike_graph_rcnt = (int*) hoc_Emalloc((nsrc + 1) * sizeof(int));
+    spike_graph_rdispl = (int*) hoc_Emalloc((nsrc + 1) * sizeof(int));
+    spike_graph_sdispl = (int*) hoc_Emalloc((ndest + 1) * sizeof(int));
+    hoc_malchk();
+}
+
+int nrnmpi_spike_exchange_graph(int* scnt,
+                                NRNMPI_Spike* spikeout,
+                                NRNMPI_Spike** spikein,
+                                int* icapacity) {
+    // scnt and spikeout are in the order of the dests arg of
+    // nrnmpi_spike_graph_create.
+    nrn_assert(spike_graph_comm != MPI_COMM_NULL);
+    nrnbbs_context_wait();
+    nrn_mpi_assert(
+        MPI_Neighbor_alltoall(scnt, 1, MPI_INT, spike_graph_rcnt, 1, MPI_INT, spike_graph_comm));
+    int n = 0;
+    for (int i = 0; i < spike_graph_nsrc; ++i) {
+        spike_graph_rdispl[i] = n;
+        n += spike_graph_rcnt[i];
+    }
+    int ns = 0;
+    for (int i = 0; i < spike_graph_ndest; ++i) {
+        spike_graph_sdispl[i] = ns;
+        ns += scnt[i];
+    }
+    if (*icapacity < n) {
+        *icapacity = n + 10;
+        free(*spikein);
+        *spikein = (NRNMPI_Spike*) hoc_Emalloc(*icapacity * sizeof(NRNMPI_Spike));
+        hoc_malchk();
+    }
+    nrn_mpi_assert(MPI_Neighbor_alltoallv(spikeout,
+                                          scnt,
+                                          spike_graph_sdispl,
+                                          spike_type,
+                                          *spikein,
+                                          spike_graph_rcnt,
+                                          spike_graph_rdispl,
+                                          spike_type,
+                                          spike_graph_comm));
+    return n;
+}
+
 double nrnmpi_mindelay(double m) {
     double result;
     if (!nrnmpi_use) {
@@ -431,6 +718,26 @@ extern void nrnmpi_dbl_alltoallv(const double* s,
     MPI_Alltoallv(s, scnt, sdispl, MPI_DOUBLE, r, rcnt, rdispl, MPI_DOUBLE, nrnmpi_comm);
 }
 
+/* posts the exchange, complete with nrnmpi_wait before touching s or r */
+extern void nrnmpi_dbl_ialltoallv(const double* s,
+                                  const int* scnt,
+                                  const int* sdispl,
+                                  double* r,
+                                  int* rcnt,
+                                  int* rdispl,
+                                  void** request) {
+    MPI_Ialltoallv(s,
+                   scnt,
+                   sdispl,
+                   MPI_DOUBLE,
+                   r,
+                   rcnt,
+                   rdispl,
+                   MPI_DOUBLE,
+                   nrnmpi_comm,
+                   (MPI_Request*) request);
+}
+
 extern void nrnmpi_char_alltoallv(char* s,
                                   int* scnt,
                                   int* sdispl,
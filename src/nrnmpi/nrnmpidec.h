@@ -77,6 +77,9 @@ extern void nrnmpi_print_memory_stats(neuron::container::MemoryStats const& stat
 /* from mpispike.cpp */
 extern void nrnmpi_spike_initialize();
 extern int nrnmpi_spike_exchange(int* ovfl, int* nout, int* nin, NRNMPI_Spike* spikeout, NRNMPI_Spike** spikein, int* icapacity_);
+extern void nrnmpi_spike_graph_create(int nsrc, int* srcs, int ndest, int* dests);
+extern int nrnmpi_spike_exchange_graph(int* scnt, NRNMPI_Spike* spikeout, NRNMPI_Spike** spikein, int* icapacity);
+extern int nrnmpi_spike_node_create(int on);
 extern int nrnmpi_spike_exchange_compressed(int localgid_size, int ag_send_size, int ag_send_nspike, int* ovfl_capacity, int* ovfl, unsigned char* spfixout, unsigned char* spfixin, unsigned char** spfixin_ovfl, int* nin_);
 extern double nrnmpi_mindelay(double maxdel);
 extern int nrnmpi_int_allmax(int i);
@@ -101,6 +104,7 @@ extern void nrnmpi_dbl_allgatherv(double* s, double* r, int* n, int* dspl);
 extern void nrnmpi_dbl_allgatherv_inplace(double* srcdest, int* n, int* dspl);
 extern void nrnmpi_dbl_alltoallv(const double* s, const int* scnt, const int* sdispl, double* r, int* rcnt, int* rdispl);
 extern void nrnmpi_dbl_alltoallv_sparse(double* s, int* scnt, int* sdispl, double* r, int* rcnt, int* rdispl);
+extern void nrnmpi_dbl_ialltoallv(const double* s, const int* scnt, const int* sdispl, double* r, int* rcnt, int* rdispl, void** request);
 extern void nrnmpi_char_alltoallv(char* s, int* scnt, int* sdispl, char* r, int* rcnt, int* rdispl);
 extern void nrnmpi_dbl_broadcast(double* buf, int cnt, int root);
 extern void nrnmpi_int_broadcast(int* buf, int cnt, int root);
@@ -39,12 +39,10 @@ It used to be static but is now a thread data variable
 void nrn_cap_jacob(neuron::model_sorted_token const& sorted_token, NrnThread* _nt, Memb_list* ml) {
     neuron::cache::MechanismRange<nparm, ndparm> ml_cache{sorted_token, *_nt, *ml, ml->type()};
     auto* const vec_d = _nt->node_d_storage();
-    int count = ml->nodecount;
     double cfac = .001 * _nt->cj;
-    int* ni = ml->nodeindices;
-    for (int i = 0; i < count; i++) {
-        vec_d[ni[i]] += cfac * ml_cache.fpfield<cm_index>(i);
-    }
+    neuron::cache::for_each_node_index(sorted_token, _nt->id, *ml, [&](int i, int ni) {
+        vec_d[ni] += cfac * ml_cache.fpfield<cm_index>(i);
+    });
 }
 
 static void cap_init(neuron::model_sorted_token const& sorted_token,
@@ -63,15 +61,13 @@ void nrn_capacity_current(neuron::model_sorted_token const& sorted_token,
                           Memb_list* ml) {
     neuron::cache::MechanismRange<nparm, ndparm> ml_cache{sorted_token, *_nt, *ml, ml->type()};
     auto* const vec_rhs = _nt->node_rhs_storage();
-    int count = ml->nodecount;
     double cfac = .001 * _nt->cj;
     /* since rhs is dvm for a full or half implicit step */
     /* (nrn_update_2d() replaces dvi by dvi-dvx) */
     /* no need to distinguish secondorder */
-    int* ni = ml->nodeindices;
-    for (int i = 0; i < count; i++) {
-        ml_cache.fpfield<i_cap_index>(i) = cfac * ml_cache.fpfield<cm_index>(i) * vec_rhs[ni[i]];
-    }
+    neuron::cache::for_each_node_index(sorted_token, _nt->id, *ml, [&](int i, int ni) {
+        ml_cache.fpfield<i_cap_index>(i) = cfac * ml_cache.fpfield<cm_index>(i) * vec_rhs[ni];
+    });
 }
 
 
@@ -80,12 +76,10 @@ void nrn_mul_capacity(neuron::model_sorted_token const& sorted_token,
                       Memb_list* ml) {
     neuron::cache::MechanismRange<nparm, ndparm> ml_cache{sorted_token, *_nt, *ml, ml->type()};
     auto* const vec_rhs = _nt->node_rhs_storage();
-    int count = ml->nodecount;
     double cfac = .001 * _nt->cj;
-    int* ni = ml->nodeindices;
-    for (int i = 0; i < count; i++) {
-        vec_rhs[ni[i]] *= cfac * ml_cache.fpfield<cm_index>(i);
-    }
+    neuron::cache::for_each_node_index(sorted_token, _nt->id, *ml, [&](int i, int ni) {
+        vec_rhs[ni] *= cfac * ml_cache.fpfield<cm_index>(i);
+    });
 }
 
 void nrn_div_capacity(neuron::model_sorted_token const& sorted_token,
@@ -93,17 +87,14 @@ void nrn_div_capacity(neuron::model_sorted_token const& sorted_token,
                       Memb_list* ml) {
     neuron::cache::MechanismRange<nparm, ndparm> ml_cache{sorted_token, *_nt, *ml, ml->type()};
     auto* const vec_rhs = _nt->node_rhs_storage();
-    int count = ml->nodecount;
-    Node** vnode = ml->nodelist;
-    int* ni = ml->nodeindices;
-    for (int i = 0; i < count; i++) {
-        ml_cache.fpfield<i_cap_index>(i) = vec_rhs[ni[i]];
-        vec_rhs[ni[i]] /= 1.e-3 * ml_cache.fpfield<cm_index>(i);
-    }
+    neuron::cache::for_each_node_index(sorted_token, _nt->id, *ml, [&](int i, int ni) {
+        ml_cache.fpfield<i_cap_index>(i) = vec_rhs[ni];
+        vec_rhs[ni] /= 1.e-3 * ml_cache.fpfield<cm_index>(i);
+    });
     if (auto const vec_sav_rhs = _nt->node_sav_rhs_storage(); vec_sav_rhs) {
-        for (int i = 0; i < count; ++i) {
-            vec_sav_rhs[vnode[i]->v_node_index] += ml_cache.fpfield<i_cap_index>(i);
-        }
+        neuron::cache::for_each_node_index(sorted_token, _nt->id, *ml, [&](int i, int ni) {
+            vec_sav_rhs[ni] += ml_cache.fpfield<i_cap_index>(i);
+        });
     }
 }
 
@@ -7,14 +7,9 @@
 #include <cstddef>
 #include <optional>
 
-namespace {
-void invalidate_cache() {
-    neuron::cache::model.reset();
-}
-}  // namespace
 namespace neuron {
 Model::Model() {
-    m_node_data.set_unsorted_callback(invalidate_cache);
+    m_node_data.set_unsorted_callback(cache::invalidate);
     // needs some re-organisation if we ever want to support multiple Model instances
     assert(!container::detail::defer_delete_storage);
     container::detail::defer_delete_storage = &m_ptrs_for_deferred_deletion;
@@ -42,13 +37,13 @@ std::unique_ptr<container::utils::storage_info> Model::find_container_info(void
 }
 
 void Model::set_unsorted_callback(container::Mechanism::storage& mech_data) {
-    mech_data.set_unsorted_callback(invalidate_cache);
+    mech_data.set_unsorted_callback(cache::invalidate);
     // This is called when a new Mechanism storage struct is created, i.e. when
     // a new Mechanism type is registered. When that happens the cache
     // implicitly becomes invalid, because it does not contain entries for the
     // newly-added Mechanism. If this proves to be a bottleneck then we could
     // handle this more efficiently.
-    invalidate_cache();
+    cache::invalidate();
 }
 }  // namespace neuron
 namespace neuron::detail {
@@ -57,7 +52,14 @@ Model model_data;
 }  // namespace neuron::detail
 namespace neuron::cache {
 std::optional<Model> model{};
+std::optional<Model> stale_model{};
+void invalidate() {
+    if (model) {
+        stale_model = std::move(model);
+        model.reset();
+    }
 }
+}  // namespace neuron::cache
 namespace neuron::container {
 std::ostream& operator<<(std::ostream& os, generic_data_handle const& dh) {
     os << "generic_data_handle{";
@@ -15,6 +15,12 @@
 #include "nrncvode.h"
 #include "spmatrix.h"
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 /*
@@ -133,9 +139,19 @@ thread handling where it was before. Also, writing to the staging area
 is only done by thread 0. Fixed step and global variable step
 logic is limited to the case where an nrnmpi_v_transfer requires
 existence of nrnthread_v_transfer (even if one thread).
+With one thread and nrn_overlap_partrans, the fixed step instead posts the
+interprocessor transfer with (*nrnmpi_v_transfer_post_)() and nonvint
+completes it with (*nrnmpi_v_transfer_wait_)() just before the states of
+the first mechanism whose type is >= nrnmpi_v_transfer_type_, i.e. the
+first that may own a target. So the states of the mechanisms before it
+are computed while the messages are in flight. nrnmpi_v_transfer_wait_
+is non-null only while a posted transfer is pending.
 */
 #if 1 || NRNMPI
 void (*nrnmpi_v_transfer_)(); /* called by thread 0 */
+void (*nrnmpi_v_transfer_post_)(); /* called by thread 0 when only one thread */
+void (*nrnmpi_v_transfer_wait_)();
+int nrnmpi_v_transfer_type_;
 void (*nrnthread_v_transfer_)(NrnThread* nt);
 /* if at least one gap junction has a source voltage with extracellular inserted */
 void (*nrnthread_vi_compute_)(NrnThread* nt);
@@ -179,55 +195,134 @@ void fadvance() {
   batch_save("varname", ...) adds variable names to the list and name
                 will appear in header.
   batch_run(tstop, tstep, "file") saves variables in file every tstep
+  batch_run(tstop, tstep, "file", "comment", binary) with binary nonzero
+                writes frames of native doubles after the header lines
 */
 
-static void batch_out(), batch_open(), batch_close();
+namespace {
+/**
+ * Writes the batch_save frames of a batch_run on its own thread.
+ *
+ * The run loop only copies the values of a frame into a block. A full block
+ * is swapped with the one being written, so formatting and file output
+ * overlap the integration and the run waits only if the writer falls more
+ * than a block behind.
+ */
+class BatchWriter {
+  public:
+    BatchWriter(FILE* f, bool binary, std::size_t nvar)
+        : file_{f}
+        , binary_{binary}
+        , nvar_{nvar} {
+        // about 1MB per block
+        std::size_t const nframe = (std::size_t(1) << 17) / std::max(nvar_, std::size_t(1));
+        fill_.reserve(std::max(nframe, std::size_t(1)) * nvar_);
+        thread_ = std::thread(&BatchWriter::run, this);
+    }
+
+    /** Writes the frames that are left, closes the file. */
+    ~BatchWriter() {
+        hand_over();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        thread_.join();
+        fclose(file_);
+    }
+
+    void frame(std::vector<neuron::container::data_handle<double>>& vars) {
+        for (auto& var: vars) {
+            fill_.push_back(*var);
+        }
+        if (fill_.size() + nvar_ > fill_.capacity()) {
+            hand_over();
+        }
+    }
+
+  private:
+    void hand_over() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return out_.empty(); });
+        out_.swap(fill_);
+        fill_.reserve(out_.capacity());
+        lock.unlock();
+        cond_.notify_all();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cond_.wait(lock, [this] { return stop_ || !out_.empty(); });
+            if (out_.empty()) {
+                return;
+            }
+            lock.unlock();
+            write(out_);
+            lock.lock();
+            out_.clear();
+            cond_.notify_all();
+        }
+    }
 
-static FILE* batch_file;
-static int batch_size;
-static int batch_n;
-static double** batch_var;
+    void write(std::vector<double> const& block) {
+        if (binary_) {
+            fwrite(block.data(), sizeof(double), block.size(), file_);
+            return;
+        }
+        for (std::size_t i = 0; i < block.size(); i += nvar_) {
+            for (std::size_t j = 0; j < nvar_; ++j) {
+                fprintf(file_, " %g", block[i + j]);
+            }
+            fprintf(file_, "\n");
+        }
+    }
+
+    FILE* file_;
+    bool binary_;
+    std::size_t nvar_;
+    std::vector<double> fill_;  // frames being copied by the run loop
+    std::vector<double> out_;   // frames being written, empty when the writer is idle
+    bool stop_{};
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+};
+}  // namespace
 
-static void batch_open(char* name, double tstop, double tstep, const char* comment) {
-    if (batch_file) {
+static void batch_out(), batch_open(const char*, double, double, const char*, bool),
+    batch_close();
+
+static std::unique_ptr<BatchWriter> batch_writer;
+static std::vector<neuron::container::data_handle<double>> batch_var;
+
+static void batch_open(const char* name,
+                       double tstop,
+                       double tstep,
+                       const char* comment,
+                       bool binary) {
+    if (batch_writer) {
         batch_close();
     }
     if (!name) {
         return;
     }
-    batch_file = fopen(name, "w");
-    if (!batch_file) {
+    FILE* f = fopen(name, binary ? "wb" : "w");
+    if (!f) {
         hoc_execerror("Couldn't open batch file", name);
     }
-    fprintf(batch_file,
+    fprintf(f,
             "%s\nbatch_run from t = %g to %g in steps of %g with dt = %g\n",
             comment,
             t,
             tstop,
             tstep,
             dt);
-#if 0
-    fprintf(batch_file, "variable names --\n");
-        if (!batch_var) {
-            batch_var = hoc_newlist();
-        }
-        count = 0;
-        ITERATE(q, batch_varname) {
-            fprintf(batch_file, "%s\n", STR(q));
-            ++count;
-        }
-        if (count != batch_n) {
-            if (batch_var) {
-                free(batch_var);
-            }
-            batch_n = count;
-            batch_var = (double**)ecalloc(batch_n, sizeof(double*));
-        }
-        count = 0;
-        ITERATE(q, batch_varname) {
-            batch_var[count++] = hoc_val_pointer(STR(q));
-        }
-#endif
+    if (binary) {
+        fprintf(f, "frames of %zu native doubles follow\n", batch_var.size());
+    }
+    batch_writer = std::make_unique<BatchWriter>(f, binary, batch_var.size());
 }
 
 void batch_run(void) /* avoid interpreter overhead */
@@ -244,6 +339,7 @@ void batch_run(void) /* avoid interpreter overhead */
         filename = 0;
     }
     auto* comment = ifarg(4) ? hoc_gargstr(4) : "";
+    bool binary = ifarg(5) ? bool(chkarg(5, 0., 1.)) : false;
 
     if (tree_changed) {
         setup_topology();
@@ -251,7 +347,7 @@ void batch_run(void) /* avoid interpreter overhead */
     if (v_structure_change) {
         v_setup_vectors();
     }
-    batch_open(filename, tstop, tstep, comment);
+    batch_open(filename, tstop, tstep, comment, binary);
     batch_out();
     auto const cache_token = nrn_ensure_model_data_are_sorted();
     if (cvode_active_) {
@@ -259,6 +355,22 @@ void batch_run(void) /* avoid interpreter overhead */
             cvode_fadvance(t + tstep);
             batch_out();
         }
+    } else if (!nrnthread_v_transfer_) {
+        // whole frames of steps per nrn_fixed_step_group, as for ParallelContext.psolve
+        int const nframe = int((tstep - dt / 4.) / dt) + 1;
+        tstop -= dt / 4.;
+        while (t < tstop) {
+            int const nleft = int(std::ceil((tstop - t) / dt));
+            int const n = std::min(nframe, nleft);
+            nrn_fixed_step_group(cache_token, n);
+            if (stoprun) {
+                tstopunset;
+                break;
+            }
+            if (n == nframe) {
+                batch_out();
+            }
+        }
     } else {
         tstep -= dt / 4.;
         tstop -= dt / 4.;
@@ -332,6 +444,7 @@ void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
         dt2thread(dt);
     }
     nrn_thread_table_check(cache_token);
+    fixed_record_prepare(1);
     if (nrn_multisplit_setup_) {
         nrn_multithread_job(nrn_ms_treeset_through_triang);
         // remove to avoid possible deadlock where some ranks do a
@@ -356,7 +469,10 @@ void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
            will be done in above call.
         */
         if (nrnthread_v_transfer_) {
-            if (nrnmpi_v_transfer_) {
+            if (nrnmpi_v_transfer_post_ && nrn_overlap_partrans && nrn_nthread == 1) {
+                nrn::Instrumentor::phase p_gap("gap-v-transfer");
+                (*nrnmpi_v_transfer_post_)();
+            } else if (nrnmpi_v_transfer_) {
                 nrn::Instrumentor::phase p_gap("gap-v-transfer");
                 (*nrnmpi_v_transfer_)();
             }
@@ -364,6 +480,7 @@ void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
         }
     }
     t = nrn_threads[0]._t;
+    fixed_record_check();
     if (nrn_allthread_handle) {
         (*nrn_allthread_handle)();
     }
@@ -383,6 +500,7 @@ void nrn_fixed_step_group(neuron::model_sorted_token const& cache_token, int n)
 #endif
     dt2thread(dt);
     nrn_thread_table_check(cache_token);
+    fixed_record_prepare(n);
     if (nrn_multisplit_setup_) {
         int b = 0;
         nrn_multithread_job(nrn_ms_treeset_through_triang);
@@ -431,6 +549,7 @@ void nrn_fixed_step_group(neuron::model_sorted_token const& cache_token, int n)
         }
     }
     t = nrn_threads[0]._t;
+    fixed_record_check();
 }
 
 static void nrn_fixed_step_group_thread(neuron::model_sorted_token const& cache_token,
@@ -734,16 +853,29 @@ void fmatrix(void) {
     return;
 }
 
+static void v_transfer(NrnThread& nt) {
+    nrn::Instrumentor::phase p_gap("gap-v-transfer");
+    if (nrnmpi_v_transfer_wait_) {
+        (*nrnmpi_v_transfer_wait_)();
+    }
+    nrnthread_v_transfer_(&nt);
+}
+
 static void nonvint(neuron::model_sorted_token const& sorted_token, NrnThread& nt) {
-    /* nrnmpi_v_transfer if needed was done earlier */
-    if (nrnthread_v_transfer_) {
-        nrn::Instrumentor::phase p_gap("gap-v-transfer");
-        nrnthread_v_transfer_(&nt);
+    /* nrnmpi_v_transfer if needed was done earlier or has been posted */
+    bool transfer_pending = nrnthread_v_transfer_ != nullptr;
+    if (transfer_pending && !nrnmpi_v_transfer_wait_) {
+        v_transfer(nt);
+        transfer_pending = false;
     }
     nrn::Instrumentor::phase_begin("state-update");
     bool const measure{nt.id == 0 && nrn_mech_wtime_};
     errno = 0;
     for (auto* tml = nt.tml; tml; tml = tml->next) {
+        if (transfer_pending && tml->index >= nrnmpi_v_transfer_type_) {
+            v_transfer(nt);
+            transfer_pending = false;
+        }
         if (memb_func[tml->index].state) {
             std::string mechname("state-");
             mechname += memb_func[tml->index].sym->name;
@@ -759,6 +891,9 @@ static void nonvint(neuron::model_sorted_token const& sorted_token, NrnThread& n
             }
         }
     }
+    if (transfer_pending) {
+        v_transfer(nt);
+    }
     long_difus_solve(sorted_token, 0, nt); /* if any longitudinal diffusion */
     nrn_nonvint_block_fixed_step_solve(nt.id);
     nrn::Instrumentor::phase_end("state-update");
@@ -782,9 +917,11 @@ void frecord_init(void) { /* useful when changing states after an finitialize()
     dt2thread(-1);
     nrn_record_init();
     if (!cvode_active_) {
+        fixed_record_prepare(1);
         for (i = 0; i < nrn_nthread; ++i) {
             fixed_record_continuous(nrn_ensure_model_data_are_sorted(), nrn_threads[i]);
         }
+        fixed_record_check();
     }
     hoc_retpushx(1.);
 }
@@ -919,9 +1056,11 @@ void nrn_finitialize(int setv, double v) {
         }
         state_discon_allowed_ = 1;
         nrn_record_init();
+        fixed_record_prepare(1);
         for (i = 0; i < nrn_nthread; ++i) {
             fixed_record_continuous(sorted_token, nrn_threads[i]);
         }
+        fixed_record_check();
     }
     for (i = 0; i < nrn_nthread; ++i) {
         nrn_deliver_events(nrn_threads + i); /* The record events at t=0 */
@@ -953,34 +1092,21 @@ void finitialize(void) {
 
 
 static void batch_close() {
-    if (batch_file) {
-        fclose(batch_file);
-        batch_file = 0;
-    }
+    batch_writer.reset();
 }
 
 static void batch_out() {
-    if (batch_file) {
-        int i;
-        for (i = 0; i < batch_n; ++i) {
-            fprintf(batch_file, " %g", *batch_var[i]);
-        }
-        fprintf(batch_file, "\n");
+    if (batch_writer) {
+        batch_writer->frame(batch_var);
     }
 }
 
 void batch_save(void) {
-    int i;
     if (!ifarg(1)) {
-        batch_n = 0;
+        batch_var.clear();
     } else {
-        for (i = 1; ifarg(i); ++i) {
-            if (batch_size <= batch_n) {
-                batch_size += 20;
-                batch_var = (double**) erealloc(batch_var, batch_size * sizeof(double*));
-            }
-            batch_var[batch_n] = hoc_pgetarg(i);
-            ++batch_n;
+        for (int i = 1; ifarg(i); ++i) {
+            batch_var.push_back(hoc_hgetarg<double>(i));
         }
     }
     hoc_retpushx(1.);
@@ -110,6 +110,7 @@ extern int nrn_nobanner_;
 double t, dt, clamp_resist, celsius, htablemin, htablemax;
 int nrn_netrec_state_adjust = 0;
 int nrn_sparse_partrans = 0;
+int nrn_overlap_partrans = 0;
 hoc_List* section_list;
 int nrn_global_ncell = 0; /* used to be rootnodecount */
 extern double hoc_default_dll_loaded_;
@@ -154,6 +155,7 @@ cTemplate** nrn_pnt_template_; /* for finding artificial cells */
 /* for synaptic events. */
 pnt_receive_t* pnt_receive;
 pnt_receive_init_t* pnt_receive_init;
+pnt_receive_batch_t* pnt_receive_batch;
 short* pnt_receive_size;
 
 /* values are type numbers of mechanisms which do net_send call */
@@ -329,6 +331,7 @@ void hoc_last_init(void) {
     nrn_pnt_template_ = (cTemplate**) ecalloc(memb_func_size_, sizeof(cTemplate*));
     pnt_receive = (pnt_receive_t*) ecalloc(memb_func_size_, sizeof(pnt_receive_t));
     pnt_receive_init = (pnt_receive_init_t*) ecalloc(memb_func_size_, sizeof(pnt_receive_init_t));
+    pnt_receive_batch = (pnt_receive_batch_t*) ecalloc(memb_func_size_, sizeof(pnt_receive_batch_t));
     pnt_receive_size = (short*) ecalloc(memb_func_size_, sizeof(short));
     nrn_is_artificial_ = (short*) ecalloc(memb_func_size_, sizeof(short));
     nrn_artcell_qindex_ = (short*) ecalloc(memb_func_size_, sizeof(short));
@@ -608,6 +611,9 @@ void reallocate_mech_data(int mechtype) {
         pnt_receive_init = (pnt_receive_init_t*) erealloc(pnt_receive_init,
                                                           memb_func_size_ *
                                                               sizeof(pnt_receive_init_t));
+        pnt_receive_batch = (pnt_receive_batch_t*) erealloc(pnt_receive_batch,
+                                                            memb_func_size_ *
+                                                                sizeof(pnt_receive_batch_t));
         pnt_receive_size = (short*) erealloc(pnt_receive_size, memb_func_size_ * sizeof(short));
         nrn_is_artificial_ = (short*) erealloc(nrn_is_artificial_, memb_func_size_ * sizeof(short));
         nrn_artcell_qindex_ = (short*) erealloc(nrn_artcell_qindex_,
@@ -637,6 +643,7 @@ void reallocate_mech_data(int mechtype) {
             nrn_pnt_template_[j] = (cTemplate*) 0;
             pnt_receive[j] = (pnt_receive_t) 0;
             pnt_receive_init[j] = (pnt_receive_init_t) 0;
+            pnt_receive_batch[j] = (pnt_receive_batch_t) 0;
             pnt_receive_size[j] = 0;
             nrn_is_artificial_[j] = 0;
             nrn_artcell_qindex_[j] = 0;
@@ -98,4 +98,13 @@ std::vector<double* const*> const& _pdata_ptr_cache_data(
     int mech_type) {
     return cache_token.mech_cache(mech_type).pdata_ptr_cache;
 }
+int _consecutive_node_index_base(neuron::model_sorted_token const& cache_token,
+                                 std::size_t thread_id,
+                                 Memb_list const& ml) {
+    auto const& map = cache_token.thread_cache(thread_id).mechanism_node_map.at(ml.type());
+    if (map.affine && map.stride == 1 && map.nodeindices == ml.nodeindices) {
+        return map.base;
+    }
+    return -1;
+}
 }  // namespace neuron::mechanism::_get
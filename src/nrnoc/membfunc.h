@@ -291,6 +291,10 @@ namespace _get {
 [[nodiscard]] std::vector<double* const*> const& _pdata_ptr_cache_data(
     neuron::model_sorted_token const& cache_token,
     int mech_type);
+// first Node index if the nodeindices of ml are consecutive, otherwise -1
+[[nodiscard]] int _consecutive_node_index_base(neuron::model_sorted_token const& cache_token,
+                                               std::size_t thread_id,
+                                               Memb_list const& ml);
 }  // namespace _get
 }  // namespace neuron::mechanism
 
@@ -88,6 +88,64 @@ std::unique_ptr<std::mutex> interpreter_lock;
 
 enum struct worker_flag { execute_job, exit, wait };
 
+// Task mode: when there are fewer workers than NrnThreads, each job is a set
+// of tasks, one per NrnThread (i.e. per cell group). Every worker starts with
+// a contiguous block of tasks, takes them from the front of its own queue and,
+// once that is empty, steals from the back of the other queues. Each task
+// runs to completion on one worker and a NrnThread is never shared between
+// tasks, so the results do not depend on which worker ran what.
+struct task_queue_t {
+    std::mutex mut;
+    int begin{};
+    int end{};
+};
+
+struct task_scheduler_t {
+    explicit task_scheduler_t(std::size_t nworker)
+        : m_nworker{nworker}
+        , m_queues{std::make_unique<task_queue_t[]>(nworker)} {}
+
+    // Worker that starts with NrnThread i in its queue.
+    std::size_t owner(int i) const {
+        return (std::size_t(i) * m_nworker) / nrn_nthread;
+    }
+
+    // Refill the queues with all the NrnThreads. Only called when all the
+    // workers are idle.
+    void reset() {
+        for (std::size_t w = 0; w < m_nworker; ++w) {
+            std::lock_guard<std::mutex> _{m_queues[w].mut};
+            // first task i with owner(i) == w
+            m_queues[w].begin = int((w * nrn_nthread + m_nworker - 1) / m_nworker);
+            m_queues[w].end = int(((w + 1) * nrn_nthread + m_nworker - 1) / m_nworker);
+        }
+    }
+
+    // Next task for worker w, -1 when there are none left.
+    int next(std::size_t w) {
+        {
+            auto& q = m_queues[w];
+            std::lock_guard<std::mutex> _{q.mut};
+            if (q.begin < q.end) {
+                return q.begin++;
+            }
+        }
+        for (std::size_t k = 1; k < m_nworker; ++k) {
+            auto& q = m_queues[(w + k) % m_nworker];
+            std::lock_guard<std::mutex> _{q.mut};
+            if (q.begin < q.end) {
+                return --q.end;
+            }
+        }
+        return -1;
+    }
+
+  private:
+    std::size_t m_nworker{};
+    // Cannot easily use std::vector because std::mutex is not moveable.
+    std::unique_ptr<task_queue_t[]> m_queues;
+};
+
 // With C++17 and alignment-aware allocators we could do something like
 // alignas(std::hardware_destructive_interference_size) here and then use a
 // regular vector. https://en.cppreference.com/w/cpp/compiler_support/17 shows
@@ -99,29 +157,47 @@ struct worker_conf_t {
                  std::pair<worker_job_with_token_t, neuron::model_sorted_token const*>>
         job{};
     std::size_t thread_id{};
+    // NrnThread to run the job on, or all the tasks of tasks if not null
+    std::size_t nt_id{};
+    task_scheduler_t* tasks{};
     worker_flag flag{worker_flag::wait};
     friend bool operator==(worker_conf_t const& lhs, worker_conf_t const& rhs) {
-        return lhs.flag == rhs.flag && lhs.thread_id == rhs.thread_id && lhs.job == rhs.job;
+        return lhs.flag == rhs.flag && lhs.thread_id == rhs.thread_id &&
+               lhs.nt_id == rhs.nt_id && lhs.tasks == rhs.tasks && lhs.job == rhs.job;
     }
 };
 
 struct worker_kernel {
-    worker_kernel(std::size_t thread_id)
-        : m_thread_id{thread_id} {}
+    worker_kernel(worker_conf_t const& conf)
+        : m_thread_id{conf.thread_id}
+        , m_nt_id{conf.nt_id}
+        , m_tasks{conf.tasks} {}
     void operator()(std::monostate const&) const {
         throw std::runtime_error("worker_kernel");
     }
     void operator()(worker_job_t job) const {
-        job(nrn_threads + m_thread_id);
+        for_each_thread([job](NrnThread* nt) { job(nt); });
     }
     void operator()(
         std::pair<worker_job_with_token_t, neuron::model_sorted_token const*> const& pair) const {
         auto const& [job, token_ptr] = pair;
-        job(*token_ptr, nrn_threads[m_thread_id]);
+        for_each_thread([job, token_ptr](NrnThread* nt) { job(*token_ptr, *nt); });
     }
 
   private:
+    template <typename F>
+    void for_each_thread(F const& f) const {
+        if (m_tasks) {
+            for (int i; (i = m_tasks->next(m_thread_id)) >= 0;) {
+                f(nrn_threads + i);
+            }
+        } else {
+            f(nrn_threads + m_nt_id);
+        }
+    }
     std::size_t m_thread_id{};
+    std::size_t m_nt_id{};
+    task_scheduler_t* m_tasks{};
 };
 
 void worker_main(worker_conf_t* my_wc_ptr,
@@ -144,7 +220,7 @@ void worker_main(worker_conf_t* my_wc_ptr,
                 return;
             }
             assert(wc.flag == worker_flag::execute_job);
-            std::visit(worker_kernel{wc.thread_id}, wc.job);
+            std::visit(worker_kernel{wc}, wc.job);
             wc.flag = worker_flag::wait;
             wc.job = std::monostate{};
             cond.notify_one();
@@ -166,7 +242,7 @@ void worker_main(worker_conf_t* my_wc_ptr,
                 conf = wc;
             }
             // Execute the workload without keeping the mutex
-            std::visit(worker_kernel{conf.thread_id}, conf.job);
+            std::visit(worker_kernel{conf}, conf.job);
             // Signal that the work is completed and this thread is becoming
             // idle
             {
@@ -187,16 +263,24 @@ void worker_main(worker_conf_t* my_wc_ptr,
 
 // Using an instance of a custom type allows us to manage the teardown process
 // more easily. TODO: remove the pointless zeroth entry in the vectors/arrays.
+// There is one worker per NrnThread unless nworker < nrn_nthread, in which
+// case the jobs are run in task mode (see task_scheduler_t) by nworker
+// workers, the coordinating thread being worker 0.
 struct worker_threads_t {
-    worker_threads_t()
-        : m_cond{std::make_unique<std::condition_variable[]>(nrn_nthread)}
-        , m_mut{std::make_unique<std::mutex[]>(nrn_nthread)} {
+    worker_threads_t(std::size_t nworker)
+        : m_nworker{nworker}
+        , m_cond{std::make_unique<std::condition_variable[]>(nworker)}
+        , m_mut{std::make_unique<std::mutex[]>(nworker)} {
+        assert(nworker > 1 && nworker <= std::size_t(nrn_nthread));
+        if (nworker < std::size_t(nrn_nthread)) {
+            m_tasks = std::make_unique<task_scheduler_t>(nworker);
+        }
         // Note that this does not call the worker_conf_t constructor.
-        CACHELINE_ALLOC(m_wc, worker_conf_t, nrn_nthread);
-        m_worker_threads.reserve(nrn_nthread);
+        CACHELINE_ALLOC(m_wc, worker_conf_t, nworker);
+        m_worker_threads.reserve(nworker);
         // worker_threads[0] does not appear to be used
         m_worker_threads.emplace_back();
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < nworker; ++i) {
             new (m_wc + i) worker_conf_t{};
             m_wc[i].thread_id = i;
             m_worker_threads.emplace_back(worker_main, &(m_wc[i]), &(m_cond[i]), &(m_mut[i]));
@@ -211,9 +295,9 @@ struct worker_threads_t {
     }
 
     ~worker_threads_t() {
-        assert(m_worker_threads.size() == nrn_nthread);
+        assert(m_worker_threads.size() == m_nworker);
         wait();
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < m_nworker; ++i) {
             {
                 std::lock_guard<std::mutex> _{m_mut[i]};
                 m_wc[i].flag = worker_flag::exit;
@@ -229,45 +313,38 @@ struct worker_threads_t {
         free(std::exchange(m_wc, nullptr));
     }
 
-    void assign_job(std::size_t worker, worker_job_t job) {
-        assert(worker > 0);
-        auto& cond = m_cond[worker];
-        auto& wc = m_wc[worker];
-        {
-            std::unique_lock<std::mutex> lock{m_mut[worker]};
-            // Wait until the worker is idle.
-            cond.wait(lock, [&wc] { return wc.flag == worker_flag::wait; });
-            assert(std::holds_alternative<std::monostate>(wc.job));
-            assert(wc.thread_id == worker);
-            wc.job = job;
-            wc.flag = worker_flag::execute_job;
+    // Run job on all the NrnThreads, the calling thread taking part as
+    // worker 0, and wait for the other workers to finish.
+    template <typename Job>
+    void run_all(Job job) {
+        if (m_tasks) {
+            m_tasks->reset();
         }
-        // Notify the worker that it has new work to do.
-        cond.notify_one();
+        for (std::size_t i = 1; i < m_nworker; ++i) {
+            assign_job(i, i, m_tasks.get(), job);
+        }
+        worker_conf_t main_conf{};
+        main_conf.job = job;
+        main_conf.tasks = m_tasks.get();
+        std::visit(worker_kernel{main_conf}, main_conf.job);
+        wait();
     }
 
-    void assign_job(std::size_t worker,
-                    neuron::model_sorted_token const& cache_token,
-                    worker_job_with_token_t job) {
-        assert(worker > 0);
-        auto& cond = m_cond[worker];
-        auto& wc = m_wc[worker];
-        {
-            std::unique_lock<std::mutex> lock{m_mut[worker]};
-            // Wait until the worker is idle.
-            cond.wait(lock, [&wc] { return wc.flag == worker_flag::wait; });
-            assert(std::holds_alternative<std::monostate>(wc.job));
-            assert(wc.thread_id == worker);
-            wc.job = std::make_pair(job, &cache_token);
-            wc.flag = worker_flag::execute_job;
+    // Run job on NrnThread i with the worker that would normally run it, and
+    // wait for it to finish.
+    void run_one(int i, worker_job_t job) {
+        std::size_t worker = m_tasks ? m_tasks->owner(i) : std::size_t(i);
+        if (worker > 0) {
+            assign_job(worker, i, nullptr, job);
+            wait();
+        } else {
+            (*job)(nrn_threads + i);
         }
-        // Notify the worker that it has new work to do.
-        cond.notify_one();
     }
 
     // Wait until all worker threads are waiting
     void wait() const {
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < m_nworker; ++i) {
             auto& wc{m_wc[i]};
             if (busywait_main_) {
                 while (wc.flag != worker_flag::wait) {
@@ -284,14 +361,42 @@ struct worker_threads_t {
     }
 
   private:
+    template <typename Job>
+    void assign_job(std::size_t worker, std::size_t nt_id, task_scheduler_t* tasks, Job job) {
+        assert(worker > 0);
+        auto& cond = m_cond[worker];
+        auto& wc = m_wc[worker];
+        {
+            std::unique_lock<std::mutex> lock{m_mut[worker]};
+            // Wait until the worker is idle.
+            cond.wait(lock, [&wc] { return wc.flag == worker_flag::wait; });
+            assert(std::holds_alternative<std::monostate>(wc.job));
+            assert(wc.thread_id == worker);
+            wc.job = job;
+            wc.nt_id = nt_id;
+            wc.tasks = tasks;
+            wc.flag = worker_flag::execute_job;
+        }
+        // Notify the worker that it has new work to do.
+        cond.notify_one();
+    }
+
+    std::size_t m_nworker{};
     // Cannot easily use std::vector because std::condition_variable is not moveable.
     std::unique_ptr<std::condition_variable[]> m_cond;
     // Cannot easily use std::vector because std::mutex is not moveable.
     std::unique_ptr<std::mutex[]> m_mut;
     std::vector<std::thread> m_worker_threads;
     worker_conf_t* m_wc{};
+    std::unique_ptr<task_scheduler_t> m_tasks;
 };
 std::unique_ptr<worker_threads_t> worker_threads{};
+// Requested number of workers, 0 means one per NrnThread.
+int nworker_requested{};
+std::size_t nworker_effective() {
+    return nworker_requested > 0 && nworker_requested < nrn_nthread ? nworker_requested
+                                                                     : nrn_nthread;
+}
 }  // namespace
 
 void nrn_thread_error(const char* s) {
@@ -300,9 +405,16 @@ void nrn_thread_error(const char* s) {
     }
 }
 
-void nrn_threads_create(int n, bool parallel) {
+void nrn_threads_create(int n, bool parallel, int nworker) {
     int i, j;
     NrnThread* nt;
+    if (nworker < 0) {
+        nworker = 0;
+    }
+    if (nworker_requested != nworker) {
+        worker_threads.reset();
+        nworker_requested = nworker;
+    }
     if (nrn_nthread != n) {
         worker_threads.reset();
         // If the number of threads changes then the node storage data is
@@ -367,8 +479,8 @@ void nrn_threads_create(int n, bool parallel) {
             return;
         }
 #endif
-        if (parallel && nrn_nthread > 1) {
-            worker_threads = std::make_unique<worker_threads_t>();
+        if (parallel && nworker_effective() > 1) {
+            worker_threads = std::make_unique<worker_threads_t>(nworker_effective());
         }
     }
 #endif
@@ -638,8 +750,10 @@ void nrn_thread_memblist_setup() {
     // status of the underlying storage, i.e. they should be part of a cache
     // structure. In any case, because we have just created new Memb_list then
     // their offsets are empty, so we need to trigger a re-sort before they are
-    // used.
-    neuron::model().apply_to_mechanisms([](auto& mech_data) { mech_data.mark_as_unsorted(); });
+    // used. Invalidating the cache is enough for that: the data of the types
+    // whose instances are still in Memb_list order need not be sorted again,
+    // which nrn_ensure_model_data_are_sorted checks.
+    neuron::cache::invalidate();
     nrn_fast_imem_alloc();
     free((char*) vmap);
     free((char*) mlcnt);
@@ -837,11 +951,7 @@ void nrn_multithread_job(worker_job_t job) {
 #if NRN_ENABLE_THREADS
     if (worker_threads) {
         nrn_inthread_ = 1;
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
-            worker_threads->assign_job(i, job);
-        }
-        (*job)(nrn_threads);
-        worker_threads->wait();
+        worker_threads->run_all(job);
         nrn_inthread_ = 0;
         return;
     }
@@ -857,11 +967,7 @@ void nrn_multithread_job(neuron::model_sorted_token const& cache_token,
 #if NRN_ENABLE_THREADS
     if (worker_threads) {
         nrn_inthread_ = 1;
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
-            worker_threads->assign_job(i, cache_token, job);
-        }
-        job(cache_token, nrn_threads[0]);
-        worker_threads->wait();
+        worker_threads->run_all(std::make_pair(job, &cache_token));
         nrn_inthread_ = 0;
         return;
     }
@@ -876,12 +982,7 @@ void nrn_onethread_job(int i, void* (*job)(NrnThread*) ) {
     assert(i >= 0 && i < nrn_nthread);
 #if NRN_ENABLE_THREADS
     if (worker_threads) {
-        if (i > 0) {
-            worker_threads->assign_job(i, job);
-            worker_threads->wait();
-        } else {
-            (*job)(nrn_threads);
-        }
+        worker_threads->run_one(i, job);
         return;
     }
 #endif
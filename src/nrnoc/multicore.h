@@ -111,7 +111,7 @@ extern NrnThread* nrn_threads;
 
 int nrn_allow_busywait(int b);
 int nrn_how_many_processors();
-void nrn_threads_create(int n, bool parallel);
+void nrn_threads_create(int n, bool parallel, int nworker = 0);
 void nrn_thread_error(const char*);
 using worker_job_t = void* (*) (NrnThread*);
 using worker_job_with_token_t = void (*)(neuron::model_sorted_token const&, NrnThread&);
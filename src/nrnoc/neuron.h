@@ -22,7 +22,7 @@ extern void issection(), ismembrane(), sectionname(), psection();
 extern void pop_section(), push_section(), section_exists();
 extern void delete_section();
 extern int secondorder, diam_changed, nrn_shape_changed_;
-extern int nrn_netrec_state_adjust, nrn_sparse_partrans;
+extern int nrn_netrec_state_adjust, nrn_sparse_partrans, nrn_overlap_partrans;
 extern double clamp_resist;
 extern double celsius;
 extern int stoprun;
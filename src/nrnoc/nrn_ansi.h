@@ -142,6 +142,7 @@ extern void nrn_length_change(Section*, double);
 extern void stor_pt3d(Section*, double x, double y, double z, double d);
 extern int nrn_netrec_state_adjust;
 extern int nrn_sparse_partrans;
+extern int nrn_overlap_partrans;
 
 char* nrn_version(int);
 
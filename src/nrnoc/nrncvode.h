@@ -12,7 +12,9 @@ void free_event_queues();
 extern void init_net_events();
 extern void nrn_record_init();
 extern void nrn_play_init();
+void fixed_record_prepare(int nstep);
 void fixed_record_continuous(neuron::model_sorted_token const&, NrnThread& nt);
+void fixed_record_check();
 extern void fixed_play_continuous(NrnThread* nt);
 extern void nrn_solver_prepare();
 extern "C" void nrn_random_play();
@@ -24,5 +26,6 @@ void nrn_capacity_current(neuron::model_sorted_token const&, NrnThread* _nt, Mem
 extern void nrn_spike_exchange_init();
 void nrn_spike_exchange(NrnThread* nt);
 extern bool nrn_use_bin_queue_;
+extern bool nrn_use_calendar_queue_;
 double nrn_event_queue_stats(double* stats);
 void nrn_fake_fire(int gid, double spiketime, int fake_out);
@@ -21,6 +21,8 @@ using ldifusfunc2_t =
 using ldifusfunc_t = void (*)(ldifusfunc2_t, neuron::model_sorted_token const&, NrnThread&);
 typedef void (*pnt_receive_t)(Point_process*, double*, double);
 typedef void (*pnt_receive_init_t)(Point_process*, double*, double);
+// the NET_RECEIVE of n events with the same delivery time and flag
+typedef void (*pnt_receive_batch_t)(Point_process**, double**, int, double);
 
 extern Prop* need_memb_cl(Symbol*, int*, int*);
 extern Prop* prop_alloc(Prop**, int, Node*);
@@ -94,6 +96,7 @@ extern int v_structure_change;    // defined in treeset.cpp
 // nrnmech stuff
 extern pnt_receive_t* pnt_receive;
 extern pnt_receive_init_t* pnt_receive_init;
+extern pnt_receive_batch_t* pnt_receive_batch;
 extern short* pnt_receive_size;
 extern void nrn_net_event(Point_process*, double);
 void nrn_net_move(Datum*, Point_process*, double);
@@ -7,6 +7,7 @@ saves the pointtype as later argument to create and loc */
 #include <stdlib.h>
 
 #include "membfunc.h"
+#include "neuron/model_data.hpp"
 #include "nrniv_mf.h"
 #include "ocnotify.h"
 #include "parse_with_deps.hpp"
@@ -96,6 +97,9 @@ void nrn_loc_point_process(int pointtype, Point_process* pnt, Section* sec, Node
             }
             v_structure_change = 1;  // needed?
         }
+        // The area and ion pointers of pnt->prop change, so its cached copies
+        // have to be rebuilt
+        neuron::model().mechanism_data(pnt->prop->_type).mark_as_unsorted();
         // Tell the new Node about pnt->prop
         pnt->prop->next = node->prop;
         node->prop = pnt->prop;
@@ -6,9 +6,11 @@
 #include "membfunc.h"
 #include "multisplit.h"
 #include "nrn_ansi.h"
+#include "ion_semantics.h"
 #include "neuron.h"
 #include "neuron/cache/mechanism_range.hpp"
 #include "neuron/cache/model_data.hpp"
+#include "neuron/container/memory_usage.hpp"
 #include "neuron/container/soa_container.hpp"
 #include "node_order_optim/node_order_optim.h"
 #include "nonvintblock.h"
@@ -28,7 +30,13 @@
 #include <cmath>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -71,6 +79,7 @@ extern Section** secorder;
 #if 1 /* if 0 then handled directly to save space : see finitialize*/
 extern short* nrn_is_artificial_;
 extern cTemplate** nrn_pnt_template_;
+extern int nrn_inthread_;
 #endif
 
 /*
@@ -1933,6 +1942,87 @@ static void nrn_matrix_node_alloc(void) {
     }
 }
 
+namespace {
+/**
+ * @brief The instances of one mechanism type in the order of the sorted storage.
+ *
+ * The instances in NrnThread i are prop[thread_begin[i]] .. prop[thread_begin[i + 1] - 1].
+ */
+struct MechInstances {
+    std::vector<Prop*> prop;
+    std::vector<std::size_t> thread_begin;
+};
+}  // namespace
+
+/** @brief Find the instances of all the mechanism types in one traversal of the model.
+ *
+ *  Within each NrnThread the instances attached to Nodes come in Node order,
+ *  followed by the artificial cells of the thread.
+ */
+static std::vector<MechInstances> nrn_mech_instances(std::size_t mech_storage_size) {
+    std::vector<MechInstances> instances(mech_storage_size);
+    // this condition comes from thread_memblist_setup(...)
+    std::vector<char> in_memb_list(mech_storage_size);
+    // Artificial cells are not in the Prop lists of the Nodes, so group them
+    // by NrnThread with one pass over the objects of their template.
+    std::vector<std::vector<std::vector<Prop*>>> artificial(mech_storage_size);
+    for (std::size_t type = 0; type < mech_storage_size; ++type) {
+        instances[type].thread_begin.resize(nrn_nthread + 1);
+        if (type == MORPHOLOGY) {
+            continue;
+        }
+        in_memb_list[type] = memb_func[type].current || memb_func[type].state ||
+                             memb_func[type].has_initialize();
+        if (nrn_is_artificial_[type]) {
+            auto& by_thread = artificial[type];
+            by_thread.resize(nrn_nthread);
+            hoc_Item* q;
+            ITERATE(q, nrn_pnt_template_[type]->olist) {
+                auto* pnt = static_cast<Point_process*>(OBJ(q)->u.this_pointer);
+                assert(pnt->prop->_type == type);
+                auto* const nt = static_cast<NrnThread*>(pnt->_vnt);
+                if (nt >= nrn_threads && nt < nrn_threads + nrn_nthread) {
+                    by_thread[nt->id].push_back(pnt->prop);
+                }
+            }
+        }
+    }
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        for (auto& inst: instances) {
+            inst.thread_begin[nt->id] = inst.prop.size();
+        }
+        for (int i = 0; i < nt->end; ++i) {
+            auto* const nd = nt->_v_node[i];
+            for (Prop* p = nd->prop; p; p = p->next) {
+                if (!in_memb_list[p->_type]) {
+                    continue;
+                }
+                auto& inst = instances[p->_type];
+                // Checks
+                assert(nt->_ml_list[p->_type]->nodelist[inst.prop.size() -
+                                                        inst.thread_begin[nt->id]] == nd);
+                assert(nt->_ml_list[p->_type]->nodeindices[inst.prop.size() -
+                                                           inst.thread_begin[nt->id]] ==
+                       nd->v_node_index);
+                inst.prop.push_back(p);
+            }
+        }
+        for (std::size_t type = 0; type < mech_storage_size; ++type) {
+            auto& inst = instances[type];
+            assert(!nt->_ml_list[type] ||
+                   nt->_ml_list[type]->nodecount == inst.prop.size() - inst.thread_begin[nt->id]);
+            if (!artificial[type].empty()) {
+                auto const& cells = artificial[type][nt->id];
+                inst.prop.insert(inst.prop.end(), cells.begin(), cells.end());
+            }
+        }
+    }
+    for (auto& inst: instances) {
+        inst.thread_begin[nrn_nthread] = inst.prop.size();
+    }
+    return instances;
+}
+
 /** @brief Sort the underlying storage for a particular mechanism.
  *
  *  After model building is complete the storage vectors backing all Mechanism
@@ -1941,31 +2031,36 @@ static void nrn_matrix_node_alloc(void) {
  *
  *  This method ensures that the Mechanism data is ready for this compute phase.
  *  It is guaranteed to remain "ready" until the returned tokens are destroyed.
+ *  It only touches the storage and cache entries of its own type, so different
+ *  types can be sorted concurrently.
  */
 static void nrn_sort_mech_data(
     neuron::container::Mechanism::storage::frozen_token_type& sorted_token,
     neuron::cache::Model& cache,
-    neuron::container::Mechanism::storage& mech_data) {
-    // Do the actual sorting here. For now the algorithm is just to ensure that
-    // the mechanism instances are partitioned by NrnThread.
+    neuron::container::Mechanism::storage& mech_data,
+    MechInstances const& instances) {
+    // Do the actual sorting here. The instances are partitioned by NrnThread
+    // and, within a thread, follow the Node order of _v_node, as found by
+    // nrn_mech_instances. That is the order of the Memb_list, and after
+    // nrn_permute_node_order it is the cache efficient or interleaved order, so
+    // the accesses to Node data through nodeindices and to ion data through
+    // the pdata caches are close to sequential. Artificial cells come last.
     auto const type = mech_data.type();
     // Some special types are not "really" mechanisms and don't need to be
     // sorted
     if (type != MORPHOLOGY) {
         std::size_t const mech_data_size{mech_data.size()};
         std::vector<short> pdata_fields_to_cache{};
-        neuron::cache::indices_to_cache(type,
-                                        [mech_data_size,
-                                         &pdata_fields_to_cache,
-                                         &pdata_hack = cache.mechanism.at(type).pdata_hack](
-                                            auto field) {
-                                            if (field >= pdata_hack.size()) {
-                                                // we get called with the largest field first
-                                                pdata_hack.resize(field + 1);
-                                            }
-                                            pdata_hack.at(field).reserve(mech_data_size);
-                                            pdata_fields_to_cache.push_back(field);
-                                        });
+        auto& pdata_hack = cache.mechanism.at(type).pdata_hack;
+        neuron::cache::indices_to_cache(
+            type, [mech_data_size, &pdata_fields_to_cache, &pdata_hack](auto field) {
+                if (field >= pdata_hack.size()) {
+                    // we get called with the largest field first
+                    pdata_hack.resize(field + 1);
+                }
+                pdata_hack.at(field).reserve(mech_data_size);
+                pdata_fields_to_cache.push_back(field);
+            });
         std::size_t global_i{}, trivial_counter{};
         std::vector<std::size_t> mech_data_permutation(mech_data_size,
                                                        std::numeric_limits<std::size_t>::max());
@@ -1980,53 +2075,14 @@ static void nrn_sort_mech_data(
             // Record where in the global storage this NrnThread's instances of
             // the mechanism start
             cache.thread.at(nt->id).mechanism_offset.at(type) = global_i;
-            // Count how many times we see this mechanism in this NrnThread
-            auto nt_mech_count = 0;
-            // Loop through the Nodes in this NrnThread
-            for (auto i = 0; i < nt->end; ++i) {
-                auto* const nd = nt->_v_node[i];
-                // See if this Node has a mechanism of this type
-                for (Prop* p = nd->prop; p; p = p->next) {
-                    if (p->_type != type) {
-                        continue;
-                    }
-                    // this condition comes from thread_memblist_setup(...)
-                    if (!memb_func[type].current && !memb_func[type].state &&
-                        !memb_func[type].has_initialize()) {
-                        continue;
-                    }
-                    // OK, p is an instance of the mechanism we're currently
-                    // considering.
-                    auto const current_global_row = p->id().current_row();
-                    trivial_counter += (current_global_row == global_i);
-                    mech_data_permutation.at(current_global_row) = global_i++;
-                    for (auto const field: pdata_fields_to_cache) {
-                        cache.mechanism.at(type).pdata_hack.at(field).push_back(p->dparam + field);
-                    }
-                    // Checks
-                    assert(ml->nodelist[nt_mech_count] == nd);
-                    assert(ml->nodeindices[nt_mech_count] == nd->v_node_index);
-                    ++nt_mech_count;
-                }
-            }
-            assert(!ml || ml->nodecount == nt_mech_count);
-            // Look for any artificial cells attached to this NrnThread
-            if (nrn_is_artificial_[type]) {
-                cTemplate* tmp = nrn_pnt_template_[type];
-                hoc_Item* q;
-                ITERATE(q, tmp->olist) {
-                    Object* obj = OBJ(q);
-                    auto* pnt = static_cast<Point_process*>(obj->u.this_pointer);
-                    assert(pnt->prop->_type == type);
-                    if (nt == pnt->_vnt) {
-                        auto const current_global_row = pnt->prop->id().current_row();
-                        trivial_counter += (current_global_row == global_i);
-                        mech_data_permutation.at(current_global_row) = global_i++;
-                        for (auto const field: pdata_fields_to_cache) {
-                            cache.mechanism.at(type).pdata_hack.at(field).push_back(
-                                pnt->prop->dparam + field);
-                        }
-                    }
+            assert(global_i == instances.thread_begin[nt->id]);
+            for (auto const end = instances.thread_begin[nt->id + 1]; global_i < end; ++global_i) {
+                Prop* const p = instances.prop[global_i];
+                auto const current_global_row = p->id().current_row();
+                trivial_counter += (current_global_row == global_i);
+                mech_data_permutation.at(current_global_row) = global_i;
+                for (auto const field: pdata_fields_to_cache) {
+                    pdata_hack.at(field).push_back(p->dparam + field);
                 }
             }
         }
@@ -2173,6 +2229,185 @@ static void nrn_sort_node_data(neuron::container::Node::storage::frozen_token_ty
     node_data.apply_reverse_permutation(std::move(node_data_permutation), sorted_token);
 }
 
+namespace {
+/**
+ * @brief Per mechanism type work of nrn_ensure_model_data_are_sorted.
+ *
+ * The threads running mech_sort_job take the types, largest first, from a
+ * shared counter. An exception is kept and rethrown by the calling thread.
+ */
+struct MechSortJob {
+    struct Task {
+        neuron::container::Mechanism::storage* mech_data;
+        neuron::container::Mechanism::storage::frozen_token_type* token;
+    };
+    std::vector<Task> tasks;
+    neuron::cache::Model* cache;
+    std::vector<MechInstances> const* instances;
+    bool reserve_slack{};
+    bool fill_caches{};
+    std::atomic<std::size_t> next{};
+    std::mutex error_mut;
+    std::exception_ptr error;
+};
+MechSortJob* mech_sort_job_;
+}  // namespace
+
+static void* mech_sort_job(NrnThread*) {
+    auto& job = *mech_sort_job_;
+    for (std::size_t i; (i = job.next++) < job.tasks.size();) {
+        auto& task = job.tasks[i];
+        try {
+            if (job.fill_caches) {
+                nrn_fill_mech_data_caches(*job.cache, *task.mech_data);
+            } else {
+                auto const type = task.mech_data->type();
+                nrn_sort_mech_data(
+                    *task.token, *job.cache, *task.mech_data, (*job.instances)[type]);
+                assert(task.mech_data->is_sorted());
+                if (job.reserve_slack && (type == MORPHOLOGY || nrn_is_ion(type))) {
+                    // The pdata caches of other types point into ion and
+                    // morphology data. Leave room to append instances without
+                    // moving them, so that those caches stay valid.
+                    auto const size = task.mech_data->size();
+                    task.mech_data->reserve(size + size / 8 + 16, *task.token);
+                }
+            }
+        } catch (...) {
+            std::lock_guard _{job.error_mut};
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Spread the tasks over the worker threads, unless there are none or this is
+// called from one of them.
+static void run_mech_sort_job(MechSortJob& job) {
+    job.next = 0;
+    mech_sort_job_ = &job;
+    if (nrn_nthread > 1 && !nrn_inthread_) {
+        nrn_multithread_job(mech_sort_job);
+    } else {
+        mech_sort_job(nrn_threads);
+    }
+    mech_sort_job_ = nullptr;
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+/** @brief Check that the instances of a type are where the stale cache expects them.
+ *
+ *  True if the type has the same number of instances per NrnThread and each
+ *  is already in the row a sort would put it in, i.e. its permutation would
+ *  be trivial.
+ */
+static bool nrn_mech_instances_in_place(neuron::cache::Model const& stale,
+                                        neuron::container::Mechanism::storage const& mech_data,
+                                        MechInstances const& instances) {
+    auto const type = mech_data.type();
+    if (type == MORPHOLOGY || instances.prop.size() != mech_data.size()) {
+        return false;
+    }
+    for (int it = 0; it < nrn_nthread; ++it) {
+        if (instances.thread_begin[it] != stale.thread.at(it).mechanism_offset.at(type)) {
+            return false;
+        }
+    }
+    for (std::size_t row = 0; row < instances.prop.size(); ++row) {
+        if (instances.prop[row]->id().current_row() != row) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Check if data the pdata cache of a type points into moved since it was built.
+ *
+ *  The cached fields point into ion data, the morphology (diam) or the Node
+ *  data (area). The Node data is checked by the caller.
+ */
+static bool nrn_mech_cache_targets_moved(neuron::cache::Model const& stale, int type) {
+    auto& model = neuron::model();
+    bool moved{};
+    neuron::cache::indices_to_cache(type, [&model, &moved, &stale, type](auto field) {
+        auto const sem = memb_func[type].dparam_semantics[field];
+        int const target = nrn_semantics_is_ion(sem) ? nrn_semantics_ion_type(sem)
+                           : sem == -9               ? MORPHOLOGY
+                                                     : -1;
+        if (target >= 0) {
+            moved = moved || !model.is_valid_mechanism(target) ||
+                    stale.mechanism.at(target).generation !=
+                        model.mechanism_data(target).layout_generation();
+        }
+    });
+    return moved;
+}
+
+/** @brief Move the stale cache of a type whose instances and pdata targets did not move.
+ */
+static void nrn_reuse_mech_cache(neuron::cache::Model& cache,
+                                 neuron::cache::Model& stale,
+                                 MechInstances const& instances,
+                                 int type) {
+    cache.mechanism.at(type) = std::move(stale.mechanism.at(type));
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        auto const offset = stale.thread.at(nt->id).mechanism_offset.at(type);
+        cache.thread.at(nt->id).mechanism_offset.at(type) = offset;
+        // The Memb_list may have been rebuilt since
+        if (auto* const ml = nt->_ml_list[type]; ml) {
+            ml->set_storage_offset(offset);
+        }
+    }
+#ifndef NDEBUG
+    auto const& pdata = cache.mechanism.at(type).pdata;
+    neuron::cache::indices_to_cache(type, [&instances, &pdata](auto field) {
+        for (std::size_t row = 0; row < instances.prop.size(); ++row) {
+            assert(pdata.at(field).at(row) ==
+                   (instances.prop[row]->dparam + field)->template get<double*>());
+        }
+    });
+#endif
+}
+
+/** @brief Record which Memb_lists map their instances to Nodes affinely.
+ *
+ *  Instances are sorted in Node order, so a mechanism in a run of consecutive
+ *  Nodes, e.g. in all the Nodes of the thread, has consecutive nodeindices.
+ */
+static void nrn_fill_node_index_maps(neuron::cache::Model& cache, std::size_t mech_storage_size) {
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        auto& maps = cache.thread.at(nt->id).mechanism_node_map;
+        maps.assign(mech_storage_size, {});
+        for (std::size_t type = 0; type < mech_storage_size; ++type) {
+            auto* const ml = nt->_ml_list[type];
+            if (!ml || !ml->nodeindices) {
+                continue;
+            }
+            int const* const ni = ml->nodeindices;
+            int const count = ml->nodecount;
+            auto& map = maps[type];
+            map.nodeindices = ni;
+            map.base = count > 0 ? ni[0] : 0;
+            map.stride = count > 1 ? ni[1] - ni[0] : 1;
+            map.affine = true;
+            for (int i = 2; i < count && map.affine; ++i) {
+                map.affine = ni[i] == map.base + map.stride * i;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rebuilds caches of raw storage offsets held outside neuron::cache::Model.
+ *
+ * Set by ParallelContext.setup_transfer for the gap junction copy tables.
+ */
+void (*nrn_mk_transfer_tables_)();
+
 /**
  * @brief Ensure neuron::container::* data are sorted.
  *
@@ -2208,10 +2443,15 @@ neuron::model_sorted_token nrn_ensure_model_data_are_sorted() {
     auto const mech_storage_size = model.mechanism_storage_size();
     std::vector<neuron::container::Mechanism::storage::frozen_token_type> mech_tokens{};
     mech_tokens.reserve(mech_storage_size);
-    model.apply_to_mechanisms([&already_sorted, &mech_tokens](auto& mech_data) {
+    std::vector<bool> mech_was_sorted{};
+    model.apply_to_mechanisms([&already_sorted, &mech_tokens, &mech_was_sorted](auto& mech_data) {
         mech_tokens.push_back(mech_data.issue_frozen_token());
+        mech_was_sorted.push_back(mech_data.is_sorted());
         already_sorted = already_sorted && mech_data.is_sorted();
     });
+    // Rebuilding the Memb_lists invalidates the cache without unsorting the
+    // data, see nrn_thread_memblist_setup.
+    already_sorted = already_sorted && neuron::cache::model;
     // Now the whole model is marked frozen/read-only, but it may or may not be
     // marked sorted (if it is, the cache should be valid, otherwise it should
     // not be).
@@ -2220,14 +2460,17 @@ neuron::model_sorted_token nrn_ensure_model_data_are_sorted() {
         assert(neuron::cache::model);
         // There isn't any more work to be done, really.
     } else {
-        // Some part of the model data is not already marked sorted. In this
-        // case we expect that the cache is *not* valid, because whatever
-        // caused something to not be sorted should also have invalidated the
-        // cache.
+        // Some part of the model data is not already marked sorted, or the
+        // cache was invalidated on its own. In this case we expect that the
+        // cache is *not* valid, because whatever caused something to not be
+        // sorted should also have invalidated the cache.
         assert(!neuron::cache::model);
         // Build a new cache (*not* in situ, so it doesn't get invalidated
         // under our feet while we're in the middle of the job) and populate it
         // by calling the various methods that sort the model data.
+        auto const sort_start = std::chrono::steady_clock::now();
+        // The cache that was invalidated, if any, to reuse what is still valid
+        auto stale = std::exchange(neuron::cache::stale_model, std::nullopt);
         neuron::cache::Model cache{};
         cache.thread.resize(nrn_nthread);
         for (auto& thread_cache: cache.thread) {
@@ -2245,19 +2488,69 @@ neuron::model_sorted_token nrn_ensure_model_data_are_sorted() {
         // an elevated "write lock" status.
         nrn_sort_node_data(node_token, cache);
         assert(node_data.is_sorted());
+        cache.node_data_generation = node_data.layout_generation();
+        // If the Nodes did not move, the stale cache entries of the mechanism
+        // types that did not change can be reused. Otherwise sort everything.
+        bool const incremental = stale && stale->thread.size() == cache.thread.size() &&
+                                 stale->mechanism.size() == mech_storage_size &&
+                                 stale->node_data_generation == cache.node_data_generation;
         // TODO: maybe we should separate out cache population from sorting.
+        auto const instances = nrn_mech_instances(mech_storage_size);
+        MechSortJob job{};
+        job.cache = &cache;
+        job.instances = &instances;
+        job.reserve_slack = !incremental;
+        std::vector<MechSortJob::Task> unchanged{};
         std::size_t n{};
-        model.apply_to_mechanisms([&cache, &n, &mech_tokens](auto& mech_data) {
+        model.apply_to_mechanisms([&](auto& mech_data) {
             // TODO do we need to pass `node_token` to `nrn_sort_mech_data`?
-            nrn_sort_mech_data(mech_tokens[n], cache, mech_data);
-            assert(mech_data.is_sorted());
+            MechSortJob::Task task{&mech_data, &mech_tokens[n]};
+            if (incremental && mech_was_sorted[n] &&
+                nrn_mech_instances_in_place(*stale, mech_data, instances[mech_data.type()])) {
+                unchanged.push_back(task);
+            } else {
+                job.tasks.push_back(task);
+            }
             ++n;
         });
+        auto const by_size = [](auto const& a, auto const& b) {
+            return a.mech_data->size() > b.mech_data->size();
+        };
+        std::stable_sort(job.tasks.begin(), job.tasks.end(), by_size);
+        run_mech_sort_job(job);
+        // Now that the changed types are sorted, the unchanged types whose
+        // pdata point into data that moved need their caches rebuilt too.
+        std::vector<MechSortJob::Task> sorted = std::move(job.tasks);
+        job.tasks.clear();
+        for (auto const& task: unchanged) {
+            auto const type = task.mech_data->type();
+            if (nrn_mech_cache_targets_moved(*stale, type)) {
+                job.tasks.push_back(task);
+            } else {
+                nrn_reuse_mech_cache(cache, *stale, instances[type], type);
+            }
+        }
+        run_mech_sort_job(job);
+        sorted.insert(sorted.end(), job.tasks.begin(), job.tasks.end());
         // Now that all the mechanism data is sorted we can fill in pdata caches
-        model.apply_to_mechanisms(
-            [&cache](auto& mech_data) { nrn_fill_mech_data_caches(cache, mech_data); });
+        job.tasks = std::move(sorted);
+        std::stable_sort(job.tasks.begin(), job.tasks.end(), by_size);
+        job.fill_caches = true;
+        run_mech_sort_job(job);
+        model.apply_to_mechanisms([&cache](auto& mech_data) {
+            cache.mechanism.at(mech_data.type()).generation = mech_data.layout_generation();
+        });
+        nrn_fill_node_index_maps(cache, mech_storage_size);
         // Move our working cache into the global storage.
         neuron::cache::model = std::move(cache);
+        if (nrn_mk_transfer_tables_) {
+            (*nrn_mk_transfer_tables_)();
+        }
+        std::chrono::duration<double> const elapsed{std::chrono::steady_clock::now() - sort_start};
+        auto& timing = neuron::container::model_sort_timing;
+        ++(incremental ? timing.incremental : timing.full);
+        timing.last = elapsed.count();
+        timing.total += elapsed.count();
     }
     // Move our tokens into the return value and be done with it.
     neuron::model_sorted_token ret{*neuron::cache::model, std::move(node_token)};
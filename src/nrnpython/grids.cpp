@@ -159,24 +159,28 @@ ECS_Grid_node::ECS_Grid_node(PyHocObject* my_states,
     ecs_tasks = (ECSAdiGridData*) malloc(NUM_THREADS * sizeof(ECSAdiGridData));
     for (k = 0; k < NUM_THREADS; k++) {
         ecs_tasks[k].scratchpad = (double*) malloc(
-            sizeof(double) * MAX(my_num_states_x, MAX(my_num_states_y, my_num_states_z)));
+            sizeof(double) * (ECS_ADI_LINES + 2) *
+            MAX(my_num_states_x, MAX(my_num_states_y, my_num_states_z)));
         ecs_tasks[k].g = this;
     }
 
 
     ecs_adi_dir_x = (ECSAdiDirection*) malloc(sizeof(ECSAdiDirection));
+    ecs_adi_dir_x->ecs_dg_adi_lines = NULL;
     ecs_adi_dir_x->states_in = states;
     ecs_adi_dir_x->states_out = states_x;
     ecs_adi_dir_x->line_size = my_num_states_x;
 
 
     ecs_adi_dir_y = (ECSAdiDirection*) malloc(sizeof(ECSAdiDirection));
+    ecs_adi_dir_y->ecs_dg_adi_lines = NULL;
     ecs_adi_dir_y->states_in = states_x;
     ecs_adi_dir_y->states_out = states_y;
     ecs_adi_dir_y->line_size = my_num_states_y;
 
 
     ecs_adi_dir_z = (ECSAdiDirection*) malloc(sizeof(ECSAdiDirection));
+    ecs_adi_dir_z->ecs_dg_adi_lines = NULL;
     ecs_adi_dir_z->states_in = states_y;
     ecs_adi_dir_z->states_out = states_x;
     ecs_adi_dir_z->line_size = my_num_states_z;
@@ -334,6 +338,8 @@ ICS_Grid_node::ICS_Grid_node(PyHocObject* my_states,
     ics_adi_dir_x->ordered_line_defs = (long*) malloc(sizeof(long) * _x_lines_length);
     ics_adi_dir_x->deltas = (double*) malloc(sizeof(double) * _num_nodes);
     ics_adi_dir_x->d = dx;
+    ics_adi_dir_x->factors = (double*) malloc(sizeof(double) * 3 * _num_nodes);
+    ics_adi_dir_x->factors_dt = -1.0;
 
     ics_adi_dir_y = (ICSAdiDirection*) malloc(sizeof(ICSAdiDirection));
     ics_adi_dir_y->states_in = states_y;
@@ -344,6 +350,8 @@ ICS_Grid_node::ICS_Grid_node(PyHocObject* my_states,
     ics_adi_dir_y->ordered_line_defs = (long*) malloc(sizeof(long) * _y_lines_length);
     ics_adi_dir_y->deltas = (double*) malloc(sizeof(double) * _num_nodes);
     ics_adi_dir_y->d = dx;
+    ics_adi_dir_y->factors = (double*) malloc(sizeof(double) * 3 * _num_nodes);
+    ics_adi_dir_y->factors_dt = -1.0;
 
     ics_adi_dir_z = (ICSAdiDirection*) malloc(sizeof(ICSAdiDirection));
     ics_adi_dir_z->states_in = states_z;
@@ -354,6 +362,8 @@ ICS_Grid_node::ICS_Grid_node(PyHocObject* my_states,
     ics_adi_dir_z->ordered_line_defs = (long*) malloc(sizeof(long) * _z_lines_length);
     ics_adi_dir_z->deltas = (double*) malloc(sizeof(double) * _num_nodes);
     ics_adi_dir_z->d = dx;
+    ics_adi_dir_z->factors = (double*) malloc(sizeof(double) * 3 * _num_nodes);
+    ics_adi_dir_z->factors_dt = -1.0;
 
     if (dcgrid == NULL) {
         ics_adi_dir_x->dc = dc[0];
@@ -841,7 +851,7 @@ void ECS_Grid_node::set_num_threads(const int n) {
     free(ecs_tasks);
     ecs_tasks = (ECSAdiGridData*) malloc(n * sizeof(ECSAdiGridData));
     for (i = 0; i < n; i++) {
-        ecs_tasks[i].scratchpad = (double*) malloc(sizeof(double) *
+        ecs_tasks[i].scratchpad = (double*) malloc(sizeof(double) * (ECS_ADI_LINES + 2) *
                                                    MAX(size_x, MAX(size_y, size_z)));
         ecs_tasks[i].g = this;
     }
@@ -1397,6 +1407,9 @@ void ICS_Grid_node::divide_x_work(const int nthreads) {
         }
     }
 
+    // The line factors are stored in this order
+    ics_adi_dir_x->factors_dt = -1.0;
+
     // Delete thread_line_defs array
     for (i = 0; i < nthreads; i++) {
         free(thread_line_defs[i]);
@@ -1494,6 +1507,9 @@ void ICS_Grid_node::divide_y_work(const int nthreads) {
         }
     }
 
+    // The line factors are stored in this order
+    ics_adi_dir_y->factors_dt = -1.0;
+
     // Delete thread_line_defs array
     for (i = 0; i < nthreads; i++) {
         free(thread_line_defs[i]);
@@ -1592,6 +1608,9 @@ void ICS_Grid_node::divide_z_work(const int nthreads) {
         }
     }
 
+    // The line factors are stored in this order
+    ics_adi_dir_z->factors_dt = -1.0;
+
     // Delete thread_line_defs array
     for (i = 0; i < nthreads; i++) {
         free(thread_line_defs[i]);
@@ -1676,6 +1695,9 @@ void ICS_Grid_node::do_grid_currents(double* output, double dt, int) {
 }
 
 void ICS_Grid_node::volume_setup() {
+    ics_adi_dir_x->factors_dt = -1.0;
+    ics_adi_dir_y->factors_dt = -1.0;
+    ics_adi_dir_z->factors_dt = -1.0;
     if (ics_adi_dir_x->dcgrid == NULL) {
         ics_adi_dir_x->ics_dg_adi_dir = ics_dg_adi_x;
         ics_adi_dir_y->ics_dg_adi_dir = ics_dg_adi_y;
@@ -1772,18 +1794,21 @@ ICS_Grid_node::~ICS_Grid_node() {
     free(ics_adi_dir_x->line_start_stop_indices);
     free(ics_adi_dir_x->ordered_nodes);
     free(ics_adi_dir_x->deltas);
+    free(ics_adi_dir_x->factors);
     free(ics_adi_dir_x);
 
     free(ics_adi_dir_y->ordered_start_stop_indices);
     free(ics_adi_dir_y->line_start_stop_indices);
     free(ics_adi_dir_y->ordered_nodes);
     free(ics_adi_dir_y->deltas);
+    free(ics_adi_dir_y->factors);
     free(ics_adi_dir_y);
 
     free(ics_adi_dir_z->ordered_start_stop_indices);
     free(ics_adi_dir_z->line_start_stop_indices);
     free(ics_adi_dir_z->ordered_nodes);
     free(ics_adi_dir_z->deltas);
+    free(ics_adi_dir_z->factors);
     free(ics_adi_dir_z);
 
     free(hybrid_data);
@@ -225,6 +225,11 @@ class ECS_Grid_node: public Grid_node {
     double* set_rxd_currents(int, int*, PyHocObject**);
 };
 
+/* number of lines solved together by ecs_dg_adi_lines, and number of
+ * consecutive planes in the tiles it visits them in */
+#define ECS_ADI_LINES 8
+#define ECS_ADI_TILE  8
+
 struct ECSAdiDirection {
     void (*ecs_dg_adi_dir)(ECS_Grid_node*,
                            const double,
@@ -233,6 +238,16 @@ struct ECSAdiDirection {
                            double const* const,
                            double* const,
                            double* const);
+    /* if not NULL, used instead of ecs_dg_adi_dir to advance all the lines
+     * of a task at once */
+    void (*ecs_dg_adi_lines)(ECS_Grid_node*,
+                             const double,
+                             const int,
+                             const int,
+                             const int,
+                             double const* const,
+                             double* const,
+                             double* const);
     double* states_in;
     double* states_out;
     int line_size;
@@ -345,6 +360,10 @@ struct ICSAdiDirection {
     double dc;
     double* dcgrid;
     double d;
+    /* factors of the line matrices, 3 for each node in ordered_nodes, and
+     * the dt they were computed for or -1 if they have to be recomputed */
+    double* factors;
+    double factors_dt;
 };
 
 
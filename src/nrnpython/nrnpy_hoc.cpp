@@ -8,6 +8,7 @@
 #include "nrnoc2iv.h"
 #include "nrnpy.h"
 #include "nrnpy_utils.h"
+#include "ocmatrix.h"
 #include "nrnpython.h"
 #include "convert_cxx_exceptions.hpp"
 
@@ -15,10 +16,12 @@
 #include "ocfile.h"
 #include "ocjump.h"
 #include "oclist.h"
+#include "recordingset.h"
 #include "shapeplt.h"
 #include "seclist.h"  // lvappendsec_and_ref, seclist_size
 
 #include <cstdint>
+#include <memory>
 #include <climits>
 #include <cmath>
 #include <vector>
@@ -74,6 +77,7 @@ static double nrnpy_call_func_(Object*, double);
 static int nrnpy_call_obj_method_(Object*, const char*, Object*);
 static int nrnpy_call_obj_method_double_(Object*, const char*, double);
 extern IvocVect* (*nrnpy_vec_from_python_p_)(void*);
+extern IvocVect* (*nrnpy_vec_from_buffer_p_)(void*);
 extern Object** (*nrnpy_vec_to_python_p_)(void*);
 extern Object** (*nrnpy_vec_as_numpy_helper_)(int, double*);
 extern Object* (*nrnpy_rvp_rxd_to_callable)(Object*);
@@ -88,6 +92,7 @@ extern PyObject* rangevars_;   // Python map for name to Symbol
 extern int hoc_max_builtin_class_id;
 
 static cTemplate* hoc_vec_template_;
+static cTemplate* hoc_matrix_template_;
 static cTemplate* hoc_list_template_;
 static cTemplate* hoc_sectionlist_template_;
 
@@ -1121,9 +1126,9 @@ static PyObject* hocobj_getattr(PyObject* subself, PyObject* pyname) {
                 add2topdict(dict.ptr());
             }
 
-            // Is the self->ho_ a Vector?  If so, add the __array_interface__ symbol
+            // Is the self->ho_ a Vector or RecordingSet?  If so, add __array_interface__
 
-            if (is_obj_type(self->ho_, "Vector")) {
+            if (is_obj_type(self->ho_, "Vector") || is_obj_type(self->ho_, "RecordingSet")) {
                 PyDict_SetItemString(dict.ptr(), "__array_interface__", Py_None);
             } else if (is_obj_type(self->ho_, "RangeVarPlot") ||
                        is_obj_type(self->ho_, "PlotShape")) {
@@ -2611,6 +2616,49 @@ static IvocVect* nrnpy_vec_from_python(void* v) {
     return hv;
 }
 
+// Vector.from_buffer(obj): one copy from any 1-d buffer of double, no
+// per element conversion. The std::vector storage cannot adopt the memory.
+static IvocVect* nrnpy_vec_from_buffer(void* v) {
+    Vect* hv = (Vect*) v;
+    Object* ho = *hoc_objgetarg(1);
+    if (ho->ctemplate->sym != nrnpy_pyobj_sym_) {
+        hoc_execerror(hoc_object_name(ho), " is not a PythonObject");
+    }
+    nb::object po = nb::borrow(nrnpy_hoc2pyobject(ho));
+    Py_buffer view;
+    if (PyObject_GetBuffer(po.ptr(), &view, PyBUF_STRIDES | PyBUF_FORMAT) < 0) {
+        PyErr_Clear();
+        hoc_execerror(hoc_object_name(ho), " does not support the buffer protocol");
+    }
+    const char* fmt = view.format ? view.format : "B";
+    if (fmt[0] == '@' || fmt[0] == '=' || fmt[0] == array_interface_typestr[0]) {
+        ++fmt;
+    }
+    if (view.ndim != 1 || strcmp(fmt, "d") != 0) {
+        PyBuffer_Release(&view);
+        hoc_execerror(hoc_object_name(ho), " is not a 1-d buffer of native double");
+    }
+    Py_ssize_t const n = view.shape[0];
+    Py_ssize_t const stride = view.strides[0];
+    if (hv->exports_block_resize(n)) {
+        PyBuffer_Release(&view);
+        hv->exports_moved();
+    }
+    hv->resize(n);
+    double* x = vector_vec(hv);
+    auto const* src = static_cast<char const*>(view.buf);
+    if (stride == sizeof(double)) {
+        // may be this Vector's own data
+        memmove(x, src, n * sizeof(double));
+    } else {
+        for (Py_ssize_t i = 0; i < n; ++i) {
+            x[i] = *reinterpret_cast<double const*>(src + i * stride);
+        }
+    }
+    PyBuffer_Release(&view);
+    return hv;
+}
+
 static PyObject* (*vec_as_numpy)(int, double*);
 extern "C" NRN_EXPORT int nrnpy_set_vec_as_numpy(PyObject* (*p)(int, double*) ) {
     vec_as_numpy = p;
@@ -3196,6 +3244,89 @@ static PyObject* py_hocobj_div(PyObject* obj1, PyObject* obj2) {
     return py_hocobj_math("div", obj1, obj2);
 }
 
+// Buffer protocol. A Vector is a 1-d and a full Matrix a C ordered 2-d array
+// of double, shared with Python without a copy, as is the (nrow, ncol) block of
+// a RecordingSet, of double or float. view->obj keeps the hoc object alive and,
+// while a view exists, a resize that would move the data is a hoc error (see
+// IvocVect::check_exports, OcMatrix::check_exports and RecordingSet::grow).
+struct HocBufferInfo {
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    int* exports;
+};
+
+static int hocobj_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    static double empty;
+    auto* po = (PyHocObject*) self;
+    void* data{};
+    int ndim{};
+    Py_ssize_t itemsize = sizeof(double);
+    char const* format = "d";
+    auto info = std::make_unique<HocBufferInfo>();
+    if (po->type_ == PyHoc::HocObject && po->ho_->ctemplate == hoc_vec_template_) {
+        auto* v = static_cast<Vect*>(po->ho_->u.this_pointer);
+        data = v->data();
+        ndim = 1;
+        info->shape[0] = v->size();
+        info->strides[0] = sizeof(double);
+        info->exports = &v->exports_;
+    } else if (po->type_ == PyHoc::HocObject && po->ho_->ctemplate == hoc_matrix_template_) {
+        auto* m = dynamic_cast<OcFullMatrix*>(static_cast<Matrix*>(po->ho_->u.this_pointer));
+        if (!m) {
+            PyErr_SetString(PyExc_BufferError, "only a full Matrix supports the buffer protocol");
+            view->obj = nullptr;
+            return -1;
+        }
+        data = m->nrow() && m->ncol() ? &m->coeff(0, 0) : nullptr;
+        ndim = 2;
+        info->shape[0] = m->nrow();
+        info->shape[1] = m->ncol();
+        info->strides[0] = m->ncol() * sizeof(double);
+        info->strides[1] = sizeof(double);
+        info->exports = &m->exports_;
+    } else if (po->type_ == PyHoc::HocObject && is_obj_type(po->ho_, "RecordingSet")) {
+        auto* rs = static_cast<RecordingSet*>(po->ho_->u.this_pointer);
+        if (rs->float32()) {
+            itemsize = sizeof(float);
+            format = "f";
+        }
+        data = rs->data();
+        ndim = 2;
+        info->shape[0] = rs->nrow();
+        info->shape[1] = rs->ncol();
+        info->strides[0] = rs->ncol() * itemsize;
+        info->strides[1] = itemsize;
+        info->exports = &rs->exports_;
+    } else {
+        PyErr_SetString(PyExc_BufferError,
+                        "only a Vector, Matrix or RecordingSet supports the buffer protocol");
+        view->obj = nullptr;
+        return -1;
+    }
+    view->buf = data ? data : &empty;
+    view->obj = Py_NewRef(self);
+    view->len = itemsize;
+    for (int i = 0; i < ndim; ++i) {
+        view->len *= info->shape[i];
+    }
+    view->readonly = 0;
+    view->itemsize = itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(format) : nullptr;
+    view->ndim = ndim;
+    view->shape = (flags & PyBUF_ND) ? info->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? info->strides : nullptr;
+    view->suboffsets = nullptr;
+    ++*info->exports;
+    view->internal = info.release();
+    return 0;
+}
+
+static void hocobj_releasebuffer(PyObject*, Py_buffer* view) {
+    auto* info = static_cast<HocBufferInfo*>(view->internal);
+    --*info->exports;
+    delete info;
+}
+
 #include "nrnpy_hoc.h"
 
 // Figure out the endian-ness of the system, and return
@@ -3362,6 +3493,7 @@ extern "C" NRN_EXPORT PyObject* nrnpy_hoc() {
     PyTypeObject* pto;
     PyType_Spec spec;
     nrnpy_vec_from_python_p_ = nrnpy_vec_from_python;
+    nrnpy_vec_from_buffer_p_ = nrnpy_vec_from_buffer;
     nrnpy_vec_to_python_p_ = nrnpy_vec_to_python;
     nrnpy_vec_as_numpy_helper_ = vec_as_numpy_helper;
     nrnpy_sectionlist_helper_ = sectionlist_helper_;
@@ -3474,6 +3606,7 @@ extern "C" NRN_EXPORT PyObject* nrnpy_hoc() {
     hoc_sectionlist_template_ = s->u.ctemplate;
     s = hoc_lookup("Matrix");
     assert(s);
+    hoc_matrix_template_ = s->u.ctemplate;
     sym_mat_x = hoc_table_lookup("x", s->u.ctemplate->symtable);
     assert(sym_mat_x);
     s = hoc_lookup("NetCon");
@@ -26,6 +26,8 @@ static PyType_Slot nrnpy_HocObjectType_slots[] = {
     {Py_nb_positive, (PyObject*) py_hocobj_upos},
     {Py_nb_absolute, (PyObject*) py_hocobj_uabs},
     {Py_nb_true_divide, (PyObject*) py_hocobj_div},
+    {Py_bf_getbuffer, (void*) hocobj_getbuffer},
+    {Py_bf_releasebuffer, (void*) hocobj_releasebuffer},
     {0, 0},
 };
 
@@ -983,6 +983,67 @@ static int solve_dd_clhs_tridiag(const int N,
     return 0;
 }
 
+/* factor_dd_clhs_tridiag does the elimination of solve_dd_clhs_tridiag that
+ * does not depend on the RHS, so that it can be done once for many lines.
+ * c        -   the modified upper diagonal, N - 1 doubles long
+ * d        -   the modified diagonal, N doubles long
+ */
+static void factor_dd_clhs_tridiag(const int N,
+                                   const double l_diag,
+                                   const double diag,
+                                   const double u_diag,
+                                   const double lbc_diag,
+                                   const double lbc_u_diag,
+                                   const double ubc_l_diag,
+                                   const double ubc_diag,
+                                   double* const c,
+                                   double* const d) {
+    int i;
+    c[0] = lbc_u_diag / lbc_diag;
+    d[0] = lbc_diag;
+    for (i = 1; i < N - 1; i++) {
+        d[i] = diag - l_diag * c[i - 1];
+        c[i] = u_diag / d[i];
+    }
+    d[N - 1] = ubc_diag - ubc_l_diag * c[N - 2];
+}
+
+/* solve_dd_clhs_tridiag_lines solves ECS_ADI_LINES systems factored by
+ * factor_dd_clhs_tridiag at once, giving the same results as
+ * solve_dd_clhs_tridiag. The lines are interleaved, b[i * ECS_ADI_LINES + l]
+ * is element i of line l, so that the inner loops are over independent lines
+ * and vectorize.
+ */
+static void solve_dd_clhs_tridiag_lines(const int N,
+                                        const double l_diag,
+                                        const double ubc_l_diag,
+                                        double const* const c,
+                                        double const* const d,
+                                        double* const b) {
+    const int n = ECS_ADI_LINES;
+    int i, l;
+    for (l = 0; l < n; l++) {
+        b[l] = b[l] / d[0];
+    }
+    for (i = 1; i < N - 1; i++) {
+        double* const bi = b + i * n;
+        for (l = 0; l < n; l++) {
+            bi[l] = (bi[l] - l_diag * bi[l - n]) / d[i];
+        }
+    }
+    double* const bN = b + (N - 1) * n;
+    for (l = 0; l < n; l++) {
+        bN[l] = (bN[l] - ubc_l_diag * bN[l - n]) / d[N - 1];
+    }
+    /*back substitution*/
+    for (i = N - 2; i >= 0; i--) {
+        double* const bi = b + i * n;
+        for (l = 0; l < n; l++) {
+            bi[l] = bi[l] - c[i] * bi[l + n];
+        }
+    }
+}
+
 /*
 static int solve_dd_clhs_tridiag_rev(const int N, const double l_diag, const double diag,
     const double u_diag, const double lbc_diag, const double lbc_u_diag,
@@ -1029,32 +1090,31 @@ ubc_diag, b, c);
 */
 
 
-/* dg_adi_x performs the first of 3 steps in DG-ADI
+/* ecs_dg_adi_x_rhs sets the right hand side of the first of 3 steps in DG-ADI
+ * for the nl lines (y, z0), ..., (y, z0 + nl - 1)
  * g    -   the parameters and state of the grid
  * dt   -   the time step
  * y    -   the index for the y plane
- * z    -   the index for the z plane
- * state    -   where the output of this step is stored
- * scratch  - scratchpad array of doubles, length g->size_x - 1
+ * z0   -   the index for the z plane of the first line
+ * nl   -   the number of lines, at most ECS_ADI_LINES
+ * state    -   the current state
+ * RHS  -   where the right hand side is stored, RHS[x * stride + l] for line l
+ * solve    -   set to 1 for the lines whose tridiagonal system has to be
+ *              solved and to 0 for those where RHS is already the output
+ * returns the number of lines to solve
  */
-static void ecs_dg_adi_x(ECS_Grid_node* g,
-                         const double dt,
-                         const int y,
-                         const int z,
-                         double const* const state,
-                         double* const RHS,
-                         double* const scratch) {
-    int yp, ym, zp, zm;
-    int x;
-    double r = g->dc_x * dt / SQ(g->dx);
-    double div_y, div_z;
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (y == 0 || z == 0 || y == g->size_y - 1 || z == g->size_z - 1)) {
-        for (x = 0; x < g->size_x; x++)
-            RHS[x] = g->bc->value;
-        return;
-    }
+static int ecs_dg_adi_x_rhs(ECS_Grid_node* g,
+                            const double dt,
+                            const int y,
+                            const int z0,
+                            const int nl,
+                            double const* const state,
+                            double* const RHS,
+                            const int stride,
+                            int* const solve) {
+    int yp, ym, zp[ECS_ADI_LINES], zm[ECS_ADI_LINES];
+    int x, z, l, nsolve = 0;
+    double div_y, div_z[ECS_ADI_LINES];
 
     if (g->size_y > 1) {
         yp = (y == g->size_y - 1) ? y - 1 : y + 1;
@@ -1065,54 +1125,76 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
         ym = 0;
         div_y = 1;
     }
-    if (g->size_z > 1) {
-        zp = (z == g->size_z - 1) ? z - 1 : z + 1;
-        zm = (z == 0) ? z + 1 : z - 1;
-        div_z = (z == 0 || z == g->size_z - 1) ? 2. : 1.;
-    } else {
-        zp = 0;
-        zm = 0;
-        div_z = 1;
+    for (l = 0; l < nl; l++) {
+        z = z0 + l;
+        if (g->size_z > 1) {
+            zp[l] = (z == g->size_z - 1) ? z - 1 : z + 1;
+            zm[l] = (z == 0) ? z + 1 : z - 1;
+            div_z[l] = (z == 0 || z == g->size_z - 1) ? 2. : 1.;
+        } else {
+            zp[l] = 0;
+            zm[l] = 0;
+            div_z[l] = 1;
+        }
+        /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET
+         * conditions*/
+        solve[l] = g->size_x > 1 &&
+                   !(g->bc->type == DIRICHLET &&
+                     (y == 0 || z == 0 || y == g->size_y - 1 || z == g->size_z - 1));
+        nsolve += solve[l];
     }
 
     if (g->bc->type == NEUMANN) {
         /*zero flux boundary condition*/
-        RHS[0] = state[IDX(0, y, z)] + g->states_cur[IDX(0, y, z)] +
-                 dt *
-                     ((g->dc_y / SQ(g->dy)) *
-                          (state[IDX(0, yp, z)] - 2. * state[IDX(0, y, z)] + state[IDX(0, ym, z)]) /
-                          div_y +
-                      (g->dc_z / SQ(g->dz)) *
-                          (state[IDX(0, y, zp)] - 2. * state[IDX(0, y, z)] + state[IDX(0, y, zm)]) /
-                          div_z);
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            RHS[l] = state[IDX(0, y, z)] + g->states_cur[IDX(0, y, z)] +
+                     dt * ((g->dc_y / SQ(g->dy)) *
+                               (state[IDX(0, yp, z)] - 2. * state[IDX(0, y, z)] +
+                                state[IDX(0, ym, z)]) /
+                               div_y +
+                           (g->dc_z / SQ(g->dz)) *
+                               (state[IDX(0, y, zp[l])] - 2. * state[IDX(0, y, z)] +
+                                state[IDX(0, y, zm[l])]) /
+                               div_z[l]);
+        }
         if (g->size_x > 1) {
-            RHS[0] += dt * (g->dc_x / SQ(g->dx)) * (state[IDX(1, y, z)] - state[IDX(0, y, z)]) /
-                      2.0;
             x = g->size_x - 1;
-            RHS[x] =
-                state[IDX(x, y, z)] + g->states_cur[IDX(x, y, z)] +
-                dt *
-                    ((g->dc_x / SQ(g->dx)) * (state[IDX(x - 1, y, z)] - state[IDX(x, y, z)]) / 2.0 +
-                     (g->dc_y / SQ(g->dy)) *
-                         (state[IDX(x, yp, z)] - 2. * state[IDX(x, y, z)] + state[IDX(x, ym, z)]) /
-                         div_y +
-                     (g->dc_z / SQ(g->dz)) *
-                         (state[IDX(x, y, zp)] - 2. * state[IDX(x, y, z)] + state[IDX(x, y, zm)]) /
-                         div_z);
+            for (l = 0; l < nl; l++) {
+                z = z0 + l;
+                RHS[l] += dt * (g->dc_x / SQ(g->dx)) *
+                          (state[IDX(1, y, z)] - state[IDX(0, y, z)]) / 2.0;
+                RHS[x * stride + l] =
+                    state[IDX(x, y, z)] + g->states_cur[IDX(x, y, z)] +
+                    dt * ((g->dc_x / SQ(g->dx)) * (state[IDX(x - 1, y, z)] - state[IDX(x, y, z)]) /
+                              2.0 +
+                          (g->dc_y / SQ(g->dy)) *
+                              (state[IDX(x, yp, z)] - 2. * state[IDX(x, y, z)] +
+                               state[IDX(x, ym, z)]) /
+                              div_y +
+                          (g->dc_z / SQ(g->dz)) *
+                              (state[IDX(x, y, zp[l])] - 2. * state[IDX(x, y, z)] +
+                               state[IDX(x, y, zm[l])]) /
+                              div_z[l]);
+            }
         }
     } else {
-        RHS[0] = g->bc->value;
-        RHS[g->size_x - 1] = g->bc->value;
+        for (l = 0; l < nl; l++) {
+            RHS[l] = g->bc->value;
+            RHS[(g->size_x - 1) * stride + l] = g->bc->value;
+        }
     }
     for (x = 1; x < g->size_x - 1; x++) {
 #ifndef __PGI
-        __builtin_prefetch(&(state[IDX(x + PREFETCH, y, z)]), 0, 1);
-        __builtin_prefetch(&(state[IDX(x + PREFETCH, yp, z)]), 0, 0);
-        __builtin_prefetch(&(state[IDX(x + PREFETCH, ym, z)]), 0, 0);
+        __builtin_prefetch(&(state[IDX(x + PREFETCH, y, z0)]), 0, 1);
+        __builtin_prefetch(&(state[IDX(x + PREFETCH, yp, z0)]), 0, 0);
+        __builtin_prefetch(&(state[IDX(x + PREFETCH, ym, z0)]), 0, 0);
 #endif
-        RHS[x] = state[IDX(x, y, z)] +
-                 dt *
-                     ((g->dc_x / SQ(g->dx)) *
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            RHS[x * stride + l] =
+                state[IDX(x, y, z)] +
+                dt * ((g->dc_x / SQ(g->dx)) *
                           (state[IDX(x + 1, y, z)] - 2. * state[IDX(x, y, z)] +
                            state[IDX(x - 1, y, z)]) /
                           2. +
@@ -1120,89 +1202,170 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
                           (state[IDX(x, yp, z)] - 2. * state[IDX(x, y, z)] + state[IDX(x, ym, z)]) /
                           div_y +
                       (g->dc_z / SQ(g->dz)) *
-                          (state[IDX(x, y, zp)] - 2. * state[IDX(x, y, z)] + state[IDX(x, y, zm)]) /
-                          div_z) +
-                 g->states_cur[IDX(x, y, z)];
+                          (state[IDX(x, y, zp[l])] - 2. * state[IDX(x, y, z)] +
+                           state[IDX(x, y, zm[l])]) /
+                          div_z[l]) +
+                g->states_cur[IDX(x, y, z)];
+        }
     }
-    if (g->size_x > 1) {
-        if (g->bc->type == NEUMANN)
-            solve_dd_clhs_tridiag(g->size_x,
-                                  -r / 2.0,
-                                  1.0 + r,
-                                  -r / 2.0,
-                                  1.0 + r / 2.0,
-                                  -r / 2.0,
-                                  -r / 2.0,
-                                  1.0 + r / 2.0,
-                                  RHS,
-                                  scratch);
-        else
-            solve_dd_clhs_tridiag(
-                g->size_x, -r / 2.0, 1.0 + r, -r / 2.0, 1.0, 0, 0, 1.0, RHS, scratch);
+    if (g->bc->type == DIRICHLET) {
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            if (y == 0 || z == 0 || y == g->size_y - 1 || z == g->size_z - 1) {
+                for (x = 0; x < g->size_x; x++)
+                    RHS[x * stride + l] = g->bc->value;
+            }
+        }
     }
+    return nsolve;
 }
 
-
-/* dg_adi_y performs the second of 3 steps in DG-ADI
+/* dg_adi_x performs the first of 3 steps in DG-ADI
  * g    -   the parameters and state of the grid
  * dt   -   the time step
- * x    -   the index for the x plane
+ * y    -   the index for the y plane
  * z    -   the index for the z plane
- * state    -   the values from the first step, which are
- *              overwritten by the output of this step
- * scratch  -   scratchpad array of doubles, length g->size_y - 1
+ * state    -   the current state
+ * RHS  -   where the output of this step is stored
+ * scratch  - scratchpad array of doubles, length g->size_x - 1
  */
-static void ecs_dg_adi_y(ECS_Grid_node* g,
-                         double const dt,
-                         int const x,
-                         int const z,
+static void ecs_dg_adi_x(ECS_Grid_node* g,
+                         const double dt,
+                         const int y,
+                         const int z,
                          double const* const state,
                          double* const RHS,
                          double* const scratch) {
-    int y;
-    double r = (g->dc_y * dt / SQ(g->dy));
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (x == 0 || z == 0 || x == g->size_x - 1 || z == g->size_z - 1)) {
-        for (y = 0; y < g->size_y; y++)
-            RHS[y] = g->bc->value;
+    double r = g->dc_x * dt / SQ(g->dx);
+    int solve;
+    if (!ecs_dg_adi_x_rhs(g, dt, y, z, 1, state, RHS, 1, &solve))
         return;
+    if (g->bc->type == NEUMANN)
+        solve_dd_clhs_tridiag(g->size_x,
+                              -r / 2.0,
+                              1.0 + r,
+                              -r / 2.0,
+                              1.0 + r / 2.0,
+                              -r / 2.0,
+                              -r / 2.0,
+                              1.0 + r / 2.0,
+                              RHS,
+                              scratch);
+    else
+        solve_dd_clhs_tridiag(g->size_x, -r / 2.0, 1.0 + r, -r / 2.0, 1.0, 0, 0, 1.0, RHS, scratch);
+}
+
+
+/* ecs_dg_adi_y_rhs sets the right hand side of the second of 3 steps in DG-ADI
+ * for the nl lines (x, z0), ..., (x, z0 + nl - 1)
+ * g    -   the parameters and state of the grid
+ * dt   -   the time step
+ * x    -   the index for the x plane
+ * z0   -   the index for the z plane of the first line
+ * nl   -   the number of lines, at most ECS_ADI_LINES
+ * state    -   the values from the first step
+ * RHS  -   where the right hand side is stored, RHS[y * stride + l] for line l
+ * solve    -   set to 1 for the lines whose tridiagonal system has to be
+ *              solved and to 0 for those where RHS is already the output
+ * returns the number of lines to solve
+ */
+static int ecs_dg_adi_y_rhs(ECS_Grid_node* g,
+                            double const dt,
+                            int const x,
+                            int const z0,
+                            int const nl,
+                            double const* const state,
+                            double* const RHS,
+                            int const stride,
+                            int* const solve) {
+    int y, z, l, nsolve = 0;
+    for (l = 0; l < nl; l++) {
+        z = z0 + l;
+        /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET
+         * conditions*/
+        solve[l] = g->size_y > 1 &&
+                   !(g->bc->type == DIRICHLET &&
+                     (x == 0 || z == 0 || x == g->size_x - 1 || z == g->size_z - 1));
+        nsolve += solve[l];
     }
     if (g->size_y == 1) {
-        if (g->bc->type == NEUMANN)
-            RHS[0] = state[x + z * g->size_x];
-        else
-            RHS[0] = g->bc->value;
-        return;
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            if (g->bc->type == NEUMANN)
+                RHS[l] = state[x + z * g->size_x];
+            else
+                RHS[l] = g->bc->value;
+        }
+        return 0;
     }
     if (g->bc->type == NEUMANN) {
         /*zero flux boundary condition*/
-        RHS[0] = state[x + z * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, 1, z)] - 2.0 * g->states[IDX(x, 0, z)] +
-                      g->states[IDX(x, 1, z)]) /
-                     4.0;
         y = g->size_y - 1;
-        RHS[y] = state[x + (z + y * g->size_z) * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, y - 1, z)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y - 1, z)]) /
-                     4.0;
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            RHS[l] = state[x + z * g->size_x] -
+                     (g->dc_y * dt / SQ(g->dy)) *
+                         (g->states[IDX(x, 1, z)] - 2.0 * g->states[IDX(x, 0, z)] +
+                          g->states[IDX(x, 1, z)]) /
+                         4.0;
+            RHS[y * stride + l] = state[x + (z + y * g->size_z) * g->size_x] -
+                                  (g->dc_y * dt / SQ(g->dy)) *
+                                      (g->states[IDX(x, y - 1, z)] - 2. * g->states[IDX(x, y, z)] +
+                                       g->states[IDX(x, y - 1, z)]) /
+                                      4.0;
+        }
     } else {
-        RHS[0] = g->bc->value;
-        RHS[g->size_y - 1] = g->bc->value;
+        for (l = 0; l < nl; l++) {
+            RHS[l] = g->bc->value;
+            RHS[(g->size_y - 1) * stride + l] = g->bc->value;
+        }
     }
     for (y = 1; y < g->size_y - 1; y++) {
 #ifndef __PGI
-        __builtin_prefetch(&state[x + (z + (y + PREFETCH) * g->size_z) * g->size_x], 0, 0);
-        __builtin_prefetch(&(g->states[IDX(x, y + PREFETCH, z)]), 0, 1);
+        __builtin_prefetch(&state[x + (z0 + (y + PREFETCH) * g->size_z) * g->size_x], 0, 0);
+        __builtin_prefetch(&(g->states[IDX(x, y + PREFETCH, z0)]), 0, 1);
 #endif
-        RHS[y] = state[x + (z + y * g->size_z) * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, y + 1, z)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y - 1, z)]) /
-                     2.0;
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            RHS[y * stride + l] = state[x + (z + y * g->size_z) * g->size_x] -
+                                  (g->dc_y * dt / SQ(g->dy)) *
+                                      (g->states[IDX(x, y + 1, z)] - 2. * g->states[IDX(x, y, z)] +
+                                       g->states[IDX(x, y - 1, z)]) /
+                                      2.0;
+        }
     }
+    if (g->bc->type == DIRICHLET) {
+        for (l = 0; l < nl; l++) {
+            z = z0 + l;
+            if (x == 0 || z == 0 || x == g->size_x - 1 || z == g->size_z - 1) {
+                for (y = 0; y < g->size_y; y++)
+                    RHS[y * stride + l] = g->bc->value;
+            }
+        }
+    }
+    return nsolve;
+}
+
+/* dg_adi_y performs the second of 3 steps in DG-ADI
+ * g    -   the parameters and state of the grid
+ * dt   -   the time step
+ * x    -   the index for the x plane
+ * z    -   the index for the z plane
+ * state    -   the values from the first step
+ * RHS  -   where the output of this step is stored
+ * scratch  -   scratchpad array of doubles, length g->size_y - 1
+ */
+static void ecs_dg_adi_y(ECS_Grid_node* g,
+                         double const dt,
+                         int const x,
+                         int const z,
+                         double const* const state,
+                         double* const RHS,
+                         double* const scratch) {
+    double r = (g->dc_y * dt / SQ(g->dy));
+    int solve;
+    if (!ecs_dg_adi_y_rhs(g, dt, x, z, 1, state, RHS, 1, &solve))
+        return;
     if (g->bc->type == NEUMANN)
         solve_dd_clhs_tridiag(g->size_y,
                               -r / 2.0,
@@ -1219,65 +1382,114 @@ static void ecs_dg_adi_y(ECS_Grid_node* g,
 }
 
 
-/* dg_adi_z performs the final step in DG-ADI
+/* ecs_dg_adi_z_rhs sets the right hand side of the final step in DG-ADI
+ * for the nl lines (x, y0), ..., (x, y0 + nl - 1)
  * g    -   the parameters and state of the grid
  * dt   -   the time step
  * x    -   the index for the x plane
- * y    -   the index for the y plane
- * state    -   the values from the second step, which are
- *              overwritten by the output of this step
- * scratch  -   scratchpad array of doubles, length g->size_z - 1
+ * y0   -   the index for the y plane of the first line
+ * nl   -   the number of lines, at most ECS_ADI_LINES
+ * state    -   the values from the second step
+ * RHS  -   where the right hand side is stored, RHS[z * stride + l] for line l
+ * solve    -   set to 1 for the lines whose tridiagonal system has to be
+ *              solved and to 0 for those where RHS is already the output
+ * returns the number of lines to solve
  */
-static void ecs_dg_adi_z(ECS_Grid_node* g,
-                         double const dt,
-                         int const x,
-                         int const y,
-                         double const* const state,
-                         double* const RHS,
-                         double* const scratch) {
-    int z;
-    double r = g->dc_z * dt / SQ(g->dz);
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (x == 0 || y == 0 || x == g->size_x - 1 || y == g->size_y - 1)) {
-        for (z = 0; z < g->size_z; z++)
-            RHS[z] = g->bc->value;
-        return;
+static int ecs_dg_adi_z_rhs(ECS_Grid_node* g,
+                            double const dt,
+                            int const x,
+                            int const y0,
+                            int const nl,
+                            double const* const state,
+                            double* const RHS,
+                            int const stride,
+                            int* const solve) {
+    int y, z, l, nsolve = 0;
+    for (l = 0; l < nl; l++) {
+        y = y0 + l;
+        /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET
+         * conditions*/
+        solve[l] = g->size_z > 1 &&
+                   !(g->bc->type == DIRICHLET &&
+                     (x == 0 || y == 0 || x == g->size_x - 1 || y == g->size_y - 1));
+        nsolve += solve[l];
     }
 
     if (g->size_z == 1) {
-        if (g->bc->type == NEUMANN)
-            RHS[0] = state[y + g->size_y * x];
-        else
-            RHS[0] = g->bc->value;
-        return;
+        for (l = 0; l < nl; l++) {
+            y = y0 + l;
+            if (g->bc->type == NEUMANN)
+                RHS[l] = state[y + g->size_y * x];
+            else
+                RHS[l] = g->bc->value;
+        }
+        return 0;
     }
 
     if (g->bc->type == NEUMANN) {
         /*zero flux boundary condition*/
-        RHS[0] = state[y + g->size_y * (x * g->size_z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, 1)] - 2.0 * g->states[IDX(x, y, 0)] +
-                      g->states[IDX(x, y, 1)]) /
-                     4.0;
         z = g->size_z - 1;
-        RHS[z] = state[y + g->size_y * (x * g->size_z + z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, z - 1)] - 2.0 * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y, z - 1)]) /
-                     4.0;
-
+        for (l = 0; l < nl; l++) {
+            y = y0 + l;
+            RHS[l] = state[y + g->size_y * (x * g->size_z)] -
+                     (g->dc_z * dt / SQ(g->dz)) *
+                         (g->states[IDX(x, y, 1)] - 2.0 * g->states[IDX(x, y, 0)] +
+                          g->states[IDX(x, y, 1)]) /
+                         4.0;
+            RHS[z * stride + l] = state[y + g->size_y * (x * g->size_z + z)] -
+                                  (g->dc_z * dt / SQ(g->dz)) *
+                                      (g->states[IDX(x, y, z - 1)] - 2.0 * g->states[IDX(x, y, z)] +
+                                       g->states[IDX(x, y, z - 1)]) /
+                                      4.0;
+        }
     } else {
-        RHS[0] = g->bc->value;
-        RHS[g->size_z - 1] = g->bc->value;
+        for (l = 0; l < nl; l++) {
+            RHS[l] = g->bc->value;
+            RHS[(g->size_z - 1) * stride + l] = g->bc->value;
+        }
     }
     for (z = 1; z < g->size_z - 1; z++) {
-        RHS[z] = state[y + g->size_y * (x * g->size_z + z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, z + 1)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y, z - 1)]) /
-                     2.;
+        for (l = 0; l < nl; l++) {
+            y = y0 + l;
+            RHS[z * stride + l] = state[y + g->size_y * (x * g->size_z + z)] -
+                                  (g->dc_z * dt / SQ(g->dz)) *
+                                      (g->states[IDX(x, y, z + 1)] - 2. * g->states[IDX(x, y, z)] +
+                                       g->states[IDX(x, y, z - 1)]) /
+                                      2.;
+        }
+    }
+    if (g->bc->type == DIRICHLET) {
+        for (l = 0; l < nl; l++) {
+            y = y0 + l;
+            if (x == 0 || y == 0 || x == g->size_x - 1 || y == g->size_y - 1) {
+                for (z = 0; z < g->size_z; z++)
+                    RHS[z * stride + l] = g->bc->value;
+            }
+        }
     }
+    return nsolve;
+}
+
+/* dg_adi_z performs the final step in DG-ADI
+ * g    -   the parameters and state of the grid
+ * dt   -   the time step
+ * x    -   the index for the x plane
+ * y    -   the index for the y plane
+ * state    -   the values from the second step
+ * RHS  -   where the output of this step is stored
+ * scratch  -   scratchpad array of doubles, length g->size_z - 1
+ */
+static void ecs_dg_adi_z(ECS_Grid_node* g,
+                         double const dt,
+                         int const x,
+                         int const y,
+                         double const* const state,
+                         double* const RHS,
+                         double* const scratch) {
+    double r = g->dc_z * dt / SQ(g->dz);
+    int solve;
+    if (!ecs_dg_adi_z_rhs(g, dt, x, y, 1, state, RHS, 1, &solve))
+        return;
 
     if (g->bc->type == NEUMANN)
         solve_dd_clhs_tridiag(g->size_z,
@@ -1294,6 +1506,162 @@ static void ecs_dg_adi_z(ECS_Grid_node* g,
         solve_dd_clhs_tridiag(g->size_z, -r / 2., 1. + r, -r / 2., 1.0, 0, 0, 1.0, RHS, scratch);
 }
 
+/* ecs_dg_adi_lines advances the lines k = i * sizej + j, start <= k < stop,
+ * of one of the DG-ADI steps, ECS_ADI_LINES consecutive lines at a time.
+ * The batches are visited in tiles of ECS_ADI_TILE consecutive i, so that
+ * the y and z steps, which read one of their inputs with a large stride
+ * between consecutive j, use all of every cache line they load.
+ * N        -   the length of the lines
+ * r        -   the diffusion coefficient times dt over the squared step
+ * rhs      -   ecs_dg_adi_x_rhs, ecs_dg_adi_y_rhs or ecs_dg_adi_z_rhs
+ * state_out    -   the output, line k at state_out[k * N]
+ * scratch  -   scratchpad array of doubles, length (ECS_ADI_LINES + 2) * N
+ */
+static void ecs_dg_adi_lines(ECS_Grid_node* g,
+                             const double dt,
+                             const int N,
+                             const double r,
+                             int (*rhs)(ECS_Grid_node*,
+                                        const double,
+                                        const int,
+                                        const int,
+                                        const int,
+                                        double const* const,
+                                        double* const,
+                                        const int,
+                                        int* const),
+                             const int start,
+                             const int stop,
+                             const int sizej,
+                             double const* const state,
+                             double* const state_out,
+                             double* const scratch) {
+    const int n = ECS_ADI_LINES;
+    double* const c = scratch;
+    double* const d = c + N;
+    double* const b = d + N;
+    const double ubc_l_diag = g->bc->type == NEUMANN ? -r / 2.0 : 0;
+    int i0, i, j0, j, k, l;
+    int solve[ECS_ADI_LINES];
+
+    if (start >= stop)
+        return;
+    if (N > 1) {
+        if (g->bc->type == NEUMANN)
+            factor_dd_clhs_tridiag(N,
+                                   -r / 2.0,
+                                   1.0 + r,
+                                   -r / 2.0,
+                                   1.0 + r / 2.0,
+                                   -r / 2.0,
+                                   -r / 2.0,
+                                   1.0 + r / 2.0,
+                                   c,
+                                   d);
+        else
+            factor_dd_clhs_tridiag(N, -r / 2.0, 1.0 + r, -r / 2.0, 1.0, 0, 0, 1.0, c, d);
+    }
+    /* unused lanes are solved too, keep them finite */
+    memset(b, 0, sizeof(double) * n * N);
+
+    const int i_start = start / sizej;
+    const int i_stop = (stop - 1) / sizej + 1;
+    for (i0 = i_start; i0 < i_stop; i0 += ECS_ADI_TILE) {
+        const int i1 = MIN(i0 + ECS_ADI_TILE, i_stop);
+        for (j0 = 0; j0 < sizej; j0 += n) {
+            for (i = i0; i < i1; i++) {
+                const int jb = MAX(j0, start - i * sizej);
+                const int je = MIN(MIN(j0 + n, sizej), stop - i * sizej);
+                if (jb >= je)
+                    continue;
+                const int nsolve = rhs(g, dt, i, jb, je - jb, state, b, n, solve);
+                for (j = jb; j < je; j++) {
+                    l = j - jb;
+                    if (!solve[l]) {
+                        double* const out = state_out + (i * sizej + j) * N;
+                        for (k = 0; k < N; k++)
+                            out[k] = b[k * n + l];
+                    }
+                }
+                if (!nsolve)
+                    continue;
+                solve_dd_clhs_tridiag_lines(N, -r / 2.0, ubc_l_diag, c, d, b);
+                for (j = jb; j < je; j++) {
+                    l = j - jb;
+                    if (solve[l]) {
+                        double* const out = state_out + (i * sizej + j) * N;
+                        for (k = 0; k < N; k++)
+                            out[k] = b[k * n + l];
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void ecs_dg_adi_x_lines(ECS_Grid_node* g,
+                               const double dt,
+                               const int start,
+                               const int stop,
+                               const int sizej,
+                               double const* const state,
+                               double* const state_out,
+                               double* const scratch) {
+    ecs_dg_adi_lines(g,
+                     dt,
+                     g->size_x,
+                     g->dc_x * dt / SQ(g->dx),
+                     ecs_dg_adi_x_rhs,
+                     start,
+                     stop,
+                     sizej,
+                     state,
+                     state_out,
+                     scratch);
+}
+
+static void ecs_dg_adi_y_lines(ECS_Grid_node* g,
+                               const double dt,
+                               const int start,
+                               const int stop,
+                               const int sizej,
+                               double const* const state,
+                               double* const state_out,
+                               double* const scratch) {
+    ecs_dg_adi_lines(g,
+                     dt,
+                     g->size_y,
+                     g->dc_y * dt / SQ(g->dy),
+                     ecs_dg_adi_y_rhs,
+                     start,
+                     stop,
+                     sizej,
+                     state,
+                     state_out,
+                     scratch);
+}
+
+static void ecs_dg_adi_z_lines(ECS_Grid_node* g,
+                               const double dt,
+                               const int start,
+                               const int stop,
+                               const int sizej,
+                               double const* const state,
+                               double* const state_out,
+                               double* const scratch) {
+    ecs_dg_adi_lines(g,
+                     dt,
+                     g->size_z,
+                     g->dc_z * dt / SQ(g->dz),
+                     ecs_dg_adi_z_rhs,
+                     start,
+                     stop,
+                     sizej,
+                     state,
+                     state_out,
+                     scratch);
+}
+
 static void* ecs_do_dg_adi(void* dataptr) {
     ECSAdiGridData* data = (ECSAdiGridData*) dataptr;
     int start = data->start;
@@ -1310,6 +1678,10 @@ static void* ecs_do_dg_adi(void* dataptr) {
     void (*ecs_dg_adi_dir)(
         ECS_Grid_node*, double, int, int, double const* const, double* const, double* const) =
         ecs_adi_dir->ecs_dg_adi_dir;
+    if (ecs_adi_dir->ecs_dg_adi_lines) {
+        ecs_adi_dir->ecs_dg_adi_lines(g, dt, start, stop, sizej, state_in, state_out, scratchpad);
+        return NULL;
+    }
     for (k = start; k < stop; k++) {
         i = k / sizej;
         j = k % sizej;
@@ -1355,4 +1727,7 @@ void ecs_set_adi_homogeneous(ECS_Grid_node* g) {
     g->ecs_adi_dir_x->ecs_dg_adi_dir = ecs_dg_adi_x;
     g->ecs_adi_dir_y->ecs_dg_adi_dir = ecs_dg_adi_y;
     g->ecs_adi_dir_z->ecs_dg_adi_dir = ecs_dg_adi_z;
+    g->ecs_adi_dir_x->ecs_dg_adi_lines = ecs_dg_adi_x_lines;
+    g->ecs_adi_dir_y->ecs_dg_adi_lines = ecs_dg_adi_y_lines;
+    g->ecs_adi_dir_z->ecs_dg_adi_lines = ecs_dg_adi_z_lines;
 }
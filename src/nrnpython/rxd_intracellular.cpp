@@ -76,6 +76,10 @@ extern "C" NRN_EXPORT void set_hybrid_data(int64_t* num_1d_indices_per_grid,
                         volumes3d[index_ctr_3d] / dx;
                 }
             }
+            // the line matrices depend on the changed alphas
+            ((ICS_Grid_node*) grid)->ics_adi_dir_x->factors_dt = -1.0;
+            ((ICS_Grid_node*) grid)->ics_adi_dir_y->factors_dt = -1.0;
+            ((ICS_Grid_node*) grid)->ics_adi_dir_z->factors_dt = -1.0;
             grid_id_check++;
         }
     }
@@ -116,6 +120,55 @@ static int solve_dd_tridiag(int N,
     return 0;
 }
 
+/* factor_dd_tridiag does the elimination of solve_dd_tridiag that only
+ * depends on the matrix, so that it is done once for as long as the matrix
+ * does not change. For row i, factors[3 * i] is the lower diagonal,
+ * factors[3 * i + 1] the pivot and factors[3 * i + 2] the modified upper
+ * diagonal, so a line is solved reading the factors in order.
+ * A line of a single node has no neighbors in this direction and its matrix
+ * is 1, l_diag, diag and u_diag are not used.
+ */
+static void factor_dd_tridiag(int N,
+                              const double* l_diag,
+                              const double* diag,
+                              const double* u_diag,
+                              double* factors) {
+    int i;
+    if (N == 1) {
+        factors[0] = 0.0;
+        factors[1] = 1.0;
+        factors[2] = 0.0;
+        return;
+    }
+    factors[0] = 0.0;
+    factors[1] = diag[0];
+    factors[2] = u_diag[0] / diag[0];
+    for (i = 1; i < N - 1; i++) {
+        factors[3 * i] = l_diag[i - 1];
+        factors[3 * i + 1] = diag[i] - l_diag[i - 1] * factors[3 * i - 1];
+        factors[3 * i + 2] = u_diag[i] / factors[3 * i + 1];
+    }
+    factors[3 * i] = l_diag[N - 2];
+    factors[3 * i + 1] = diag[N - 1] - l_diag[N - 2] * factors[3 * i - 1];
+    factors[3 * i + 2] = 0.0;
+}
+
+/* solve_factored_dd_tridiag solves Ax=b with the factors of A from
+ * factor_dd_tridiag, giving the same x as solve_dd_tridiag.
+ * The solution (x) will be stored in B.
+ */
+static void solve_factored_dd_tridiag(int N, const double* factors, double* b) {
+    int i;
+    b[0] = b[0] / factors[1];
+    for (i = 1; i < N; i++) {
+        b[i] = (b[i] - factors[3 * i] * b[i - 1]) / factors[3 * i + 1];
+    }
+    /*back substitution*/
+    for (i = N - 2; i >= 0; i--) {
+        b[i] = b[i] - factors[3 * i + 2] * b[i + 1];
+    }
+}
+
 // Homogeneous diffusion coefficient
 void ics_find_deltas(long start,
                      long stop,
@@ -315,6 +368,8 @@ void ics_dg_adi_x_inhom(ICS_Grid_node* g,
     double dy = g->ics_adi_dir_y->d;
     double dz = g->ics_adi_dir_z->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_x->factors;
+    bool refactor = g->ics_adi_dir_x->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -337,34 +392,37 @@ void ics_dg_adi_x_inhom(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_nodes[ordered_index];
-        next = alphas[next_index] * dc[next_index] / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dx);
-        u_diag[0] = -dt * next / SQ(dx);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_nodes[ordered_index];
-            prev = alphas[prev_index] * dc[current_index] /
-                   (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc[next_index] /
                    (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dx);
-            diag[c] = 1. + dt * (prev + next) / SQ(dx);
-            u_diag[c] = -dt * next / SQ(dx);
+            diag[0] = 1.0 + dt * next / SQ(dx);
+            u_diag[0] = -dt * next / SQ(dx);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_nodes[ordered_index];
+                prev = alphas[prev_index] * dc[current_index] /
+                       (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc[next_index] /
+                       (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dx);
+                diag[c] = 1. + dt * (prev + next) / SQ(dx);
+                u_diag[c] = -dt * next / SQ(dx);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc[next_index] /
+                   (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dx);
+            l_diag[N - 2] = -dt * prev / SQ(dx);
         }
-        prev = alphas[current_index] * dc[next_index] /
-               (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dx);
-        l_diag[N - 2] = -dt * prev / SQ(dx);
-
-
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -392,6 +450,8 @@ void ics_dg_adi_y_inhom(ICS_Grid_node* g,
     double* dc = g->ics_adi_dir_y->dcgrid;
     double dy = g->ics_adi_dir_y->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_y->factors;
+    bool refactor = g->ics_adi_dir_y->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -412,33 +472,37 @@ void ics_dg_adi_y_inhom(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_y_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_y_nodes[ordered_index];
-        next = alphas[next_index] * dc[next_index] / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dy);
-        u_diag[0] = -dt * next / SQ(dy);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_y_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_y_nodes[ordered_index];
-            prev = alphas[prev_index] * dc[prev_index] /
-                   (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc[next_index] /
                    (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dy);
-            diag[c] = 1. + dt * (prev + next) / SQ(dy);
-            u_diag[c] = -dt * next / SQ(dy);
+            diag[0] = 1.0 + dt * next / SQ(dy);
+            u_diag[0] = -dt * next / SQ(dy);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_y_nodes[ordered_index];
+                prev = alphas[prev_index] * dc[prev_index] /
+                       (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc[next_index] /
+                       (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dy);
+                diag[c] = 1. + dt * (prev + next) / SQ(dy);
+                u_diag[c] = -dt * next / SQ(dy);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc[current_index] /
+                   (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dy);
+            l_diag[N - 2] = -dt * prev / SQ(dy);
         }
-        prev = alphas[current_index] * dc[current_index] /
-               (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dy);
-        l_diag[N - 2] = -dt * prev / SQ(dy);
-
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -466,6 +530,8 @@ void ics_dg_adi_z_inhom(ICS_Grid_node* g,
     double* dc = g->ics_adi_dir_z->dcgrid;
     double dz = g->ics_adi_dir_z->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_z->factors;
+    bool refactor = g->ics_adi_dir_z->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -484,32 +550,37 @@ void ics_dg_adi_z_inhom(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_z_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_z_nodes[ordered_index];
-        next = alphas[next_index] * dc[next_index] / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dz);
-        u_diag[0] = -dt * next / SQ(dz);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_z_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_z_nodes[ordered_index];
-            prev = alphas[prev_index] * dc[prev_index] /
-                   (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc[next_index] /
                    (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dz);
-            diag[c] = 1. + dt * (prev + next) / SQ(dz);
-            u_diag[c] = -dt * next / SQ(dz);
+            diag[0] = 1.0 + dt * next / SQ(dz);
+            u_diag[0] = -dt * next / SQ(dz);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_z_nodes[ordered_index];
+                prev = alphas[prev_index] * dc[prev_index] /
+                       (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc[next_index] /
+                       (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dz);
+                diag[c] = 1. + dt * (prev + next) / SQ(dz);
+                u_diag[c] = -dt * next / SQ(dz);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc[current_index] /
+                   (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dz);
+            l_diag[N - 2] = -dt * prev / SQ(dz);
         }
-        prev = alphas[current_index] * dc[current_index] /
-               (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dz);
-        l_diag[N - 2] = -dt * prev / SQ(dz);
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -542,6 +613,8 @@ void ics_dg_adi_x(ICS_Grid_node* g,
     double dy = g->ics_adi_dir_y->d;
     double dz = g->ics_adi_dir_z->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_x->factors;
+    bool refactor = g->ics_adi_dir_x->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -564,31 +637,33 @@ void ics_dg_adi_x(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_nodes[ordered_index];
-        next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dx);
-        u_diag[0] = -dt * next / SQ(dx);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_nodes[ordered_index];
-            prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dx);
-            diag[c] = 1. + dt * (prev + next) / SQ(dx);
-            u_diag[c] = -dt * next / SQ(dx);
+            diag[0] = 1.0 + dt * next / SQ(dx);
+            u_diag[0] = -dt * next / SQ(dx);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_nodes[ordered_index];
+                prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dx);
+                diag[c] = 1. + dt * (prev + next) / SQ(dx);
+                u_diag[c] = -dt * next / SQ(dx);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dx);
+            l_diag[N - 2] = -dt * prev / SQ(dx);
         }
-        prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dx);
-        l_diag[N - 2] = -dt * prev / SQ(dx);
-
-
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -616,6 +691,8 @@ void ics_dg_adi_y(ICS_Grid_node* g,
     double dc = g->ics_adi_dir_y->dc;
     double dy = g->ics_adi_dir_y->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_y->factors;
+    bool refactor = g->ics_adi_dir_y->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -636,30 +713,33 @@ void ics_dg_adi_y(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_y_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_y_nodes[ordered_index];
-        next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dy);
-        u_diag[0] = -dt * next / SQ(dy);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_y_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_y_nodes[ordered_index];
-            prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dy);
-            diag[c] = 1. + dt * (prev + next) / SQ(dy);
-            u_diag[c] = -dt * next / SQ(dy);
+            diag[0] = 1.0 + dt * next / SQ(dy);
+            u_diag[0] = -dt * next / SQ(dy);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_y_nodes[ordered_index];
+                prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dy);
+                diag[c] = 1. + dt * (prev + next) / SQ(dy);
+                u_diag[c] = -dt * next / SQ(dy);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dy);
+            l_diag[N - 2] = -dt * prev / SQ(dy);
         }
-        prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dy);
-        l_diag[N - 2] = -dt * prev / SQ(dy);
-
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -687,6 +767,8 @@ void ics_dg_adi_z(ICS_Grid_node* g,
     double dc = g->ics_adi_dir_z->dc;
     double dz = g->ics_adi_dir_z->d;
     double dt = *dt_ptr;
+    double* factors = g->ics_adi_dir_z->factors;
+    bool refactor = g->ics_adi_dir_z->factors_dt != dt;
     long next_index = -1;
     long prev_index = -1;
     double next;
@@ -705,29 +787,33 @@ void ics_dg_adi_z(ICS_Grid_node* g,
             ordered_index++;
         }
 
-        ordered_index = ordered_index_start;
-        current_index = ordered_z_nodes[ordered_index];
-        ordered_index++;
-        next_index = ordered_z_nodes[ordered_index];
-        next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-        diag[0] = 1.0 + dt * next / SQ(dz);
-        u_diag[0] = -dt * next / SQ(dz);
-        ordered_index++;
-        for (int c = 1; c < N - 1; c++) {
-            prev_index = current_index;
-            current_index = next_index;
+        if (refactor && N > 1) {
+            ordered_index = ordered_index_start;
+            current_index = ordered_z_nodes[ordered_index];
+            ordered_index++;
             next_index = ordered_z_nodes[ordered_index];
-            prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
             next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
-            l_diag[c - 1] = -dt * prev / SQ(dz);
-            diag[c] = 1. + dt * (prev + next) / SQ(dz);
-            u_diag[c] = -dt * next / SQ(dz);
+            diag[0] = 1.0 + dt * next / SQ(dz);
+            u_diag[0] = -dt * next / SQ(dz);
             ordered_index++;
+            for (int c = 1; c < N - 1; c++) {
+                prev_index = current_index;
+                current_index = next_index;
+                next_index = ordered_z_nodes[ordered_index];
+                prev = alphas[prev_index] * dc / (alphas[prev_index] + alphas[current_index]);
+                next = alphas[next_index] * dc / (alphas[next_index] + alphas[current_index]);
+                l_diag[c - 1] = -dt * prev / SQ(dz);
+                diag[c] = 1. + dt * (prev + next) / SQ(dz);
+                u_diag[c] = -dt * next / SQ(dz);
+                ordered_index++;
+            }
+            prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
+            diag[N - 1] = 1.0 + dt * prev / SQ(dz);
+            l_diag[N - 2] = -dt * prev / SQ(dz);
         }
-        prev = alphas[current_index] * dc / (alphas[current_index] + alphas[next_index]);
-        diag[N - 1] = 1.0 + dt * prev / SQ(dz);
-        l_diag[N - 2] = -dt * prev / SQ(dz);
-        solve_dd_tridiag(N, l_diag, diag, u_diag, RHS, scratchpad);
+        if (refactor)
+            factor_dd_tridiag(N, l_diag, diag, u_diag, &factors[3 * ordered_index_start]);
+        solve_factored_dd_tridiag(N, &factors[3 * ordered_index_start], RHS);
 
         ordered_index = ordered_index_start;
         for (int k = 0; k < N; k++) {
@@ -791,6 +877,8 @@ void ICS_Grid_node::run_threaded_ics_dg_adi(ICSAdiDirection* ics_adi_dir) {
     do_ics_dg_adi(&ics_tasks[NUM_THREADS - 1]);
     /* wait for them to finish */
     TaskQueue_sync(AllTasks);
+    /* the tasks have factored their lines if the factors were stale */
+    ics_adi_dir->factors_dt = *dt_ptr;
 }
 
 
@@ -869,12 +869,16 @@ static double broadcast(void*) {
 
 static double nthrd(void*) {
     bool ip{true};
+    int nworker{0};
     hoc_return_type_code = HocReturnType::integer;
     if (ifarg(1)) {
         if (ifarg(2)) {
             ip = bool(chkarg(2, 0, 1));
         }
-        nrn_threads_create(int(chkarg(1, 1, 1e5)), ip);
+        if (ifarg(3)) {
+            nworker = int(chkarg(3, 0, 1e5));
+        }
+        nrn_threads_create(int(chkarg(1, 1, 1e5)), ip, nworker);
     }
     return double(nrn_nthread);
 }
@@ -930,6 +934,9 @@ static double optimize_node_order(void*) {
     if (ifarg(1)) {
         neuron::nrn_optimize_node_order(int(chkarg(1, 0, 2)));
     }
+    if (ifarg(2)) {
+        neuron::interleave_simd = int(chkarg(2, 0, 1));
+    }
     return double(neuron::interleave_permute_type);
 }
 
@@ -197,6 +197,7 @@ static void CVDecreaseBDF(CVodeMem cv_mem);
 static void CVRescale(CVodeMem cv_mem);
 
 static void CVPredict(CVodeMem cv_mem);
+static void CVPascal(int nq, realtype sign, N_Vector *z);
 
 static void CVSet(CVodeMem cv_mem);
 static void CVSetAdams(CVodeMem cv_mem);
@@ -3576,15 +3577,12 @@ static void CVRescale(CVodeMem cv_mem)
 {
   int j;
   int is;
-  realtype factor;
+  realtype factor, factors[L_MAX];
 
   factor = eta;
   for (j=1; j <= q; j++) {
 
-    N_VScale(factor, zn[j], zn[j]);
-
-    if (quadr)
-      N_VScale(factor, znQ[j], znQ[j]);
+    factors[j] = factor;
 
     if (sensi)
       for (is=0; is<Ns; is++)
@@ -3593,6 +3591,12 @@ static void CVRescale(CVodeMem cv_mem)
     factor *= eta;
 
   }
+
+  N_VScaleVectorArray(q, factors+1, zn+1, zn+1);
+
+  if (quadr)
+    N_VScaleVectorArray(q, factors+1, znQ+1, znQ+1);
+
   h = hscale * eta;
   hscale = h;
   nscon = 0;
@@ -3615,15 +3619,10 @@ static void CVPredict(CVodeMem cv_mem)
 
   tn += h;
 
-  for (k = 1; k <= q; k++)
-    for (j = q; j >= k; j--) 
-      N_VLinearSum(ONE, zn[j-1], ONE, zn[j], zn[j-1]); 
+  CVPascal(q, ONE, zn);
 
-  if (quadr) {
-    for (k = 1; k <= q; k++)
-      for (j = q; j >= k; j--) 
-        N_VLinearSum(ONE, znQ[j-1], ONE, znQ[j], znQ[j-1]);
-  }
+  if (quadr)
+    CVPascal(q, ONE, znQ);
 
   if (sensi) {
     for (is=0; is<Ns; is++) {
@@ -3636,6 +3635,33 @@ static void CVPredict(CVodeMem cv_mem)
 
 /*-----------------------------------------------------------------*/
 
+/*
+ * CVPascal
+ *
+ * This routine does the repeated additions (sign = ONE) of the
+ * prediction, or the subtractions (sign = -ONE) that undo it, on the
+ * q+1 columns of the Nordsieck array z. All q(q+1)/2 of them are one
+ * fused vector operation, with the same sequence of operations on each
+ * element as when they are done one after the other.
+ */
+
+static void CVPascal(int nq, realtype sign, N_Vector *z)
+{
+  N_Vector X[L_MAX*(L_MAX-1)/2], Y[L_MAX*(L_MAX-1)/2];
+  int j, k, n;
+
+  n = 0;
+  for (k = 1; k <= nq; k++)
+    for (j = nq; j >= k; j--) {
+      X[n] = z[j-1];
+      Y[n] = z[j];
+      n++;
+    }
+  N_VLinearSumVectorArray(n, ONE, X, sign, Y, X);
+}
+
+/*-----------------------------------------------------------------*/
+
 /*
  * CVSet
  *
@@ -4359,15 +4385,11 @@ static void CVRestore(CVodeMem cv_mem, realtype saved_t)
   int is;
 
   tn = saved_t;
-  for (k = 1; k <= q; k++)
-    for (j = q; j >= k; j--)
-      N_VLinearSum(ONE, zn[j-1], -ONE, zn[j], zn[j-1]);
 
-  if (quadr) {
-    for (k = 1; k <= q; k++)
-      for (j = q; j >= k; j--)
-        N_VLinearSum(ONE, znQ[j-1], -ONE, znQ[j], znQ[j-1]);
-  }
+  CVPascal(q, -ONE, zn);
+
+  if (quadr)
+    CVPascal(q, -ONE, znQ);
 
   if (sensi) {
     for (is=0; is<Ns; is++) {
@@ -5227,13 +5249,10 @@ static void CVCompleteStep(CVodeMem cv_mem)
 
   /* Apply correction to column j of zn: l_j * Delta_n */
 
-  for (j=0; j <= q; j++) 
-    N_VLinearSum(l[j], acor, ONE, zn[j], zn[j]);
+  N_VScaleAddMulti(q+1, l, acor, zn, zn);
 
-  if (quadr) {
-    for (j=0; j <= q; j++) 
-      N_VLinearSum(l[j], acorQ, ONE, znQ[j], znQ[j]);
-  }
+  if (quadr)
+    N_VScaleAddMulti(q+1, l, acorQ, znQ, znQ);
 
   if (sensi) {
     for (is=0; is<Ns; is++)
@@ -170,6 +170,62 @@ realtype N_VMinQuotient(N_Vector num, N_Vector denom)
   return(quotient);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * Fused operations, with fallbacks to the single operations
+ * -----------------------------------------------------------------
+ */
+
+void N_VLinearCombination(int nvec, realtype *c, N_Vector *X, N_Vector z)
+{
+  int i;
+  if (z->ops->nvlinearcombination) {
+    z->ops->nvlinearcombination(nvec, c, X, z);
+    return;
+  }
+  N_VScale(c[0], X[0], z);
+  for (i=1; i<nvec; i++) {
+    N_VLinearSum(c[i], X[i], RCONST(1.0), z, z);
+  }
+}
+
+void N_VScaleAddMulti(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z)
+{
+  int i;
+  if (x->ops->nvscaleaddmulti) {
+    x->ops->nvscaleaddmulti(nvec, a, x, Y, Z);
+    return;
+  }
+  for (i=0; i<nvec; i++) {
+    N_VLinearSum(a[i], x, RCONST(1.0), Y[i], Z[i]);
+  }
+}
+
+void N_VLinearSumVectorArray(int nvec, realtype a, N_Vector *X, realtype b, N_Vector *Y,
+                             N_Vector *Z)
+{
+  int i;
+  if (nvec > 0 && Z[0]->ops->nvlinearsumvectorarray) {
+    Z[0]->ops->nvlinearsumvectorarray(nvec, a, X, b, Y, Z);
+    return;
+  }
+  for (i=0; i<nvec; i++) {
+    N_VLinearSum(a, X[i], b, Y[i], Z[i]);
+  }
+}
+
+void N_VScaleVectorArray(int nvec, realtype *c, N_Vector *X, N_Vector *Z)
+{
+  int i;
+  if (nvec > 0 && Z[0]->ops->nvscalevectorarray) {
+    Z[0]->ops->nvscalevectorarray(nvec, c, X, Z);
+    return;
+  }
+  for (i=0; i<nvec; i++) {
+    N_VScale(c[i], X[i], Z[i]);
+  }
+}
+
 /*
  * -----------------------------------------------------------------
  * Additional functions exported by the generic NVECTOR:
@@ -90,6 +90,11 @@ struct _generic_N_Vector_Ops {
   booleantype (*nvinvtest)(N_Vector, N_Vector);
   booleantype (*nvconstrmask)(N_Vector, N_Vector, N_Vector);
   realtype    (*nvminquotient)(N_Vector, N_Vector);
+  /* fused operations, may be NULL */
+  void        (*nvlinearcombination)(int, realtype*, N_Vector*, N_Vector);
+  void        (*nvscaleaddmulti)(int, realtype*, N_Vector, N_Vector*, N_Vector*);
+  void        (*nvlinearsumvectorarray)(int, realtype, N_Vector*, realtype, N_Vector*, N_Vector*);
+  void        (*nvscalevectorarray)(int, realtype*, N_Vector*, N_Vector*);
 };
   
 /*
@@ -330,6 +335,41 @@ booleantype N_VInvTest(N_Vector x, N_Vector z);
 booleantype N_VConstrMask(N_Vector c, N_Vector x, N_Vector m);
 realtype N_VMinQuotient(N_Vector num, N_Vector denom);
 
+/*
+ * -----------------------------------------------------------------
+ * Fused operations
+ *
+ * Each of these does the work of several of the operations above
+ * in one call, which for a vector whose data is distributed over
+ * threads means one thread job instead of several. If the ops
+ * entry of an implementation is NULL, the generic function falls
+ * back to the single operations, with the same result.
+ *
+ * N_VLinearCombination
+ *   Performs z = c[0]*X[0] + ... + c[nvec-1]*X[nvec-1].
+ *   z may be X[0] but not one of the others.
+ *
+ * N_VScaleAddMulti
+ *   Performs Z[i] = a[i]*x + Y[i] for i = 0 .. nvec-1.
+ *   Z[i] may be Y[i].
+ *
+ * N_VLinearSumVectorArray
+ *   Performs Z[i] = a*X[i] + b*Y[i] for i = 0 .. nvec-1, in that
+ *   order for each element. Z[i] may be X[i] or Y[i], and also
+ *   X[j] or Y[j] of a later j > i, which then uses the new Z[i].
+ *
+ * N_VScaleVectorArray
+ *   Performs Z[i] = c[i]*X[i] for i = 0 .. nvec-1.
+ *   Z[i] may be X[i].
+ * -----------------------------------------------------------------
+ */
+
+void N_VLinearCombination(int nvec, realtype *c, N_Vector *X, N_Vector z);
+void N_VScaleAddMulti(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z);
+void N_VLinearSumVectorArray(int nvec, realtype a, N_Vector *X, realtype b, N_Vector *Y,
+                             N_Vector *Z);
+void N_VScaleVectorArray(int nvec, realtype *c, N_Vector *X, N_Vector *Z);
+
 /*
  * -----------------------------------------------------------------
  * Additional functions exported by nvector
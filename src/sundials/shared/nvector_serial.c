@@ -107,6 +107,10 @@ N_Vector N_VNewEmpty_Serial(long int length)
   ops->nvinvtest         = N_VInvTest_Serial;
   ops->nvconstrmask      = N_VConstrMask_Serial;
   ops->nvminquotient     = N_VMinQuotient_Serial;
+  ops->nvlinearcombination    = N_VLinearCombination_Serial;
+  ops->nvscaleaddmulti        = N_VScaleAddMulti_Serial;
+  ops->nvlinearsumvectorarray = N_VLinearSumVectorArray_Serial;
+  ops->nvscalevectorarray     = N_VScaleVectorArray_Serial;
 
   /* Create content */
   content = (N_VectorContent_Serial) malloc(sizeof(struct _N_VectorContent_Serial));
@@ -201,6 +205,10 @@ N_Vector N_VCloneEmpty_Serial(N_Vector w)
   ops->nvinvtest         = w->ops->nvinvtest;
   ops->nvconstrmask      = w->ops->nvconstrmask;
   ops->nvminquotient     = w->ops->nvminquotient;
+  ops->nvlinearcombination    = w->ops->nvlinearcombination;
+  ops->nvscaleaddmulti        = w->ops->nvscaleaddmulti;
+  ops->nvlinearsumvectorarray = w->ops->nvlinearsumvectorarray;
+  ops->nvscalevectorarray     = w->ops->nvscalevectorarray;
 
   /* Create content */
   content = (N_VectorContent_Serial) malloc(sizeof(struct _N_VectorContent_Serial));
@@ -792,6 +800,104 @@ realtype N_VMinQuotient_Serial(N_Vector num, N_Vector denom)
   return(min);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * fused operations
+ *
+ * The elements are done in blocks of NV_BLOCK so that the block of
+ * the vector that is used for all nvec stays in the L1 cache, and
+ * the inner loops over a block are simple enough to be vectorized.
+ * Each element gets the same sequence of operations as with the
+ * single operations, so results are the same.
+ * -----------------------------------------------------------------
+ */
+
+#define NV_BLOCK 512
+
+void N_VLinearCombination_Serial(int nvec, realtype *c, N_Vector *X, N_Vector z)
+{
+  int i;
+  long int j, j0, j1, N;
+  realtype ci, *xd, *zd;
+
+  N  = NV_LENGTH_S(z);
+  zd = NV_DATA_S(z);
+
+  for (j0=0; j0 < N; j0 += NV_BLOCK) {
+    j1 = MIN(j0 + NV_BLOCK, N);
+    xd = NV_DATA_S(X[0]);
+    ci = c[0];
+    for (j=j0; j < j1; j++)
+      zd[j] = ci * xd[j];
+    for (i=1; i < nvec; i++) {
+      xd = NV_DATA_S(X[i]);
+      ci = c[i];
+      for (j=j0; j < j1; j++)
+        zd[j] += ci * xd[j];
+    }
+  }
+}
+
+void N_VScaleAddMulti_Serial(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z)
+{
+  int i;
+  long int j, j0, j1, N;
+  realtype ai, *xd, *yd, *zd;
+
+  N  = NV_LENGTH_S(x);
+  xd = NV_DATA_S(x);
+
+  for (j0=0; j0 < N; j0 += NV_BLOCK) {
+    j1 = MIN(j0 + NV_BLOCK, N);
+    for (i=0; i < nvec; i++) {
+      yd = NV_DATA_S(Y[i]);
+      zd = NV_DATA_S(Z[i]);
+      ai = a[i];
+      for (j=j0; j < j1; j++)
+        zd[j] = ai * xd[j] + yd[j];
+    }
+  }
+}
+
+void N_VLinearSumVectorArray_Serial(int nvec, realtype a, N_Vector *X, realtype b,
+                                    N_Vector *Y, N_Vector *Z)
+{
+  int i;
+  long int j, j0, j1, N;
+  realtype *xd, *yd, *zd;
+
+  if (nvec < 1) return;
+  N = NV_LENGTH_S(Z[0]);
+
+  /* blocks keep the chain Z[i] = Y[i+1] of CVODE's predictor in cache */
+  for (j0=0; j0 < N; j0 += NV_BLOCK) {
+    j1 = MIN(j0 + NV_BLOCK, N);
+    for (i=0; i < nvec; i++) {
+      xd = NV_DATA_S(X[i]);
+      yd = NV_DATA_S(Y[i]);
+      zd = NV_DATA_S(Z[i]);
+      for (j=j0; j < j1; j++)
+        zd[j] = a * xd[j] + b * yd[j];
+    }
+  }
+}
+
+void N_VScaleVectorArray_Serial(int nvec, realtype *c, N_Vector *X, N_Vector *Z)
+{
+  int i;
+  long int j, N;
+  realtype ci, *xd, *zd;
+
+  for (i=0; i < nvec; i++) {
+    N  = NV_LENGTH_S(Z[i]);
+    xd = NV_DATA_S(X[i]);
+    zd = NV_DATA_S(Z[i]);
+    ci = c[i];
+    for (j=0; j < N; j++)
+      zd[j] = ci * xd[j];
+  }
+}
+
 /*
  * -----------------------------------------------------------------
  * private functions
@@ -269,6 +269,11 @@ void N_VCompare_Serial(realtype c, N_Vector x, N_Vector z);
 booleantype N_VInvTest_Serial(N_Vector x, N_Vector z);
 booleantype N_VConstrMask_Serial(N_Vector c, N_Vector x, N_Vector m);
 realtype N_VMinQuotient_Serial(N_Vector num, N_Vector denom);
+void N_VLinearCombination_Serial(int nvec, realtype *c, N_Vector *X, N_Vector z);
+void N_VScaleAddMulti_Serial(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z);
+void N_VLinearSumVectorArray_Serial(int nvec, realtype a, N_Vector *X, realtype b,
+                                    N_Vector *Y, N_Vector *Z);
+void N_VScaleVectorArray_Serial(int nvec, realtype *c, N_Vector *X, N_Vector *Z);
 
 #ifdef __cplusplus
 }
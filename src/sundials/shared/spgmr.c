@@ -331,10 +331,14 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
     if (QRsol(krydim, Hes, givens, yg) != 0)
       return(SPGMR_QRSOL_FAIL);
     
-    /* Add correction vector V_l y to xcor. */
+    /* Add correction vector V_l y to xcor, which is 0 on the first try. */
 
-    for (k = 0; k < krydim; k++)
-      N_VLinearSum(yg[k], V[k], ONE, xcor, xcor);
+    if (ntries == 0) {
+      N_VLinearCombination(krydim, yg, V, xcor);
+    } else {
+      for (k = 0; k < krydim; k++)
+        N_VLinearSum(yg[k], V[k], ONE, xcor, xcor);
+    }
     
     /* If converged, construct the final solution vector x and return. */
 
@@ -379,9 +383,7 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
     r_norm = ABS(r_norm);
     
     /* Multiply yg by V_(krydim+1) to get last residual vector; restart. */
-    N_VScale(yg[0], V[0], V[0]);
-    for (k = 1; k <= krydim; k++)
-      N_VLinearSum(yg[k], V[k], ONE, V[0], V[0]);
+    N_VLinearCombination(krydim+1, yg, V, V[0]);
     
   }
   
@@ -0,0 +1,67 @@
+# batch_run benchmark for text and binary output.
+#
+# Simulates ncell Hodgkin-Huxley cells with staggered current clamps and
+# saves the voltage of every cell every tstep with batch_run, writing text
+# and binary frames, and for reference with a Python loop of fadvance calls
+# that copies the values into a numpy array. Run with e.g.
+#   python batch_run.py
+#   python batch_run.py --ncell 10000 --tstep 0.025
+# and compare the reported times; the sums of the last frames have to agree
+# up to the precision of the text output.
+
+import argparse
+import os
+import tempfile
+import numpy as np
+from neuron import h
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=2000)
+parser.add_argument("--tstep", type=float, default=0.1)
+parser.add_argument("--tstop", type=float, default=50.0)
+args, _ = parser.parse_known_args()
+
+h.dt = 0.025
+cells = []
+stims = []
+for i in range(args.ncell):
+    sec = h.Section(name=f"cell[{i}]")
+    sec.L = sec.diam = 20
+    sec.insert("hh")
+    stim = h.IClamp(sec(0.5))
+    stim.delay = 1 + i % 10
+    stim.dur = 1e9
+    stim.amp = 0.1 + 0.05 * (i % 5)
+    cells.append(sec)
+    stims.append(stim)
+
+h.batch_save()
+h.batch_save(*[sec(0.5)._ref_v for sec in cells])
+path = os.path.join(tempfile.mkdtemp(), "batch.dat")
+
+for binary in [0, 1]:
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.batch_run(args.tstop, args.tstep, path, "benchmark", binary)
+    t1 = h.startsw() - t0
+    if binary:
+        with open(path, "rb") as f:
+            header = [f.readline() for i in range(3)]
+            last = np.fromfile(f, dtype=np.float64).reshape(-1, args.ncell)[-1]
+    else:
+        with open(path) as f:
+            last = np.array(f.readlines()[-1].split(), dtype=np.float64)
+    size = os.path.getsize(path)
+    print(f"batch_run binary={binary} time={t1:.3f}s size={size} v={last.sum():.6g}")
+
+h.finitialize(-65)
+nstep = int(round(args.tstep / h.dt))
+frames = []
+t0 = h.startsw()
+while h.t < args.tstop - h.dt / 4:
+    for i in range(nstep):
+        h.fadvance()
+    frames.append(np.array([sec(0.5).v for sec in cells]))
+t1 = h.startsw() - t0
+print(f"fadvance loop time={t1:.3f}s v={frames[-1].sum():.6g}")
+os.remove(path)
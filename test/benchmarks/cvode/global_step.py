@@ -0,0 +1,56 @@
+# Global variable step benchmark for the threaded N_Vector operations.
+#
+# Simulates ncell Hodgkin-Huxley cells with a few dendritic compartments
+# each, driven by staggered current clamps, with the global variable step
+# method and the given numbers of threads. Every CVODE step does the vector
+# operations of the prediction, the corrector and the error test over all
+# states, which the fused operations do in a few thread jobs. Run with e.g.
+#   python global_step.py
+#   python global_step.py --ncell 2000 --nthread 1 2 4 8
+# and compare the reported times; the voltage sums have to agree between the
+# numbers of threads up to the round off of the norms.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=500)
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2, 4])
+parser.add_argument("--tstop", type=float, default=50.0)
+args, _ = parser.parse_known_args()
+
+cells = []
+stims = []
+for i in range(args.ncell):
+    soma = h.Section(name=f"soma[{i}]")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    dend = h.Section(name=f"dend[{i}]")
+    dend.L = 200
+    dend.diam = 1
+    dend.nseg = 9
+    dend.insert("pas")
+    dend.connect(soma(1))
+    stim = h.IClamp(soma(0.5))
+    stim.delay = 1 + (i % 17) * 0.3
+    stim.dur = 1e9
+    stim.amp = 0.2 + 0.1 * (i % 7) / 7
+    cells.append((soma, dend))
+    stims.append(stim)
+
+pc = h.ParallelContext()
+cvode = h.CVode()
+cvode.active(1)
+cvode.atol(1e-3)
+for nthread in args.nthread:
+    pc.nthread(nthread)
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    vsum = sum(soma(0.5).v for soma, _ in cells)
+    print(f"nthread={nthread:2d} time={t1:.3f}s v={vsum:.10g}")
+pc.nthread(1)
+cvode.active(0)
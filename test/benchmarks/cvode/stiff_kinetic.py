@@ -0,0 +1,79 @@
+# Stiff kinetic scheme benchmark for the CVode linear solvers.
+#
+# Simulates ncell Hodgkin-Huxley cells whose somata also have a KSChan
+# potassium channel with a fast closed-open-inactivated kinetic scheme,
+# with the global variable step method and CVode.jacobian 0 (NEURON's
+# linear solver) and 3 (Newton-Krylov preconditioned by it). Run with e.g.
+#   python stiff_kinetic.py
+#   python stiff_kinetic.py --ncell 200 --rate 500
+# and compare the reported steps and steps per second; the spike counts
+# have to agree.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=50)
+parser.add_argument("--rate", type=float, default=100.0, help="fast rate (/ms)")
+parser.add_argument("--tstop", type=float, default=100.0)
+args, _ = parser.parse_known_args()
+
+ks = h.KSChan(0)
+ks.name("kstiff")
+ks.ion("k")
+ks.iv_type(0)
+ks.gmax(0.005)
+c = ks.add_ksstate(None, "C")
+o = ks.add_ksstate(c.gate(), "O")
+i = ks.add_ksstate(c.gate(), "I")
+c.frac(0)
+o.frac(1)
+i.frac(0)
+for src, tgt, fwd, bwd in [
+    (c, o, [args.rate, 0.05, -40], [args.rate, -0.05, -40]),
+    (o, i, [0.5 * args.rate, 0.02, -20], [0.5 * args.rate, -0.02, -20]),
+]:
+    tr = ks.add_transition(src, tgt)
+    tr.type(0)
+    tr.set_f(0, 2, h.Vector(fwd))
+    tr.set_f(1, 2, h.Vector(bwd))
+
+cells = []
+stims = []
+spikes = []
+for k in range(args.ncell):
+    soma = h.Section(name=f"soma[{k}]")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    soma.insert("kstiff")
+    stim = h.IClamp(soma(0.5))
+    stim.delay = 1 + k % 10
+    stim.dur = 1e9
+    stim.amp = 0.3
+    nc = h.NetCon(soma(0.5)._ref_v, None, sec=soma)
+    spk = h.Vector()
+    nc.record(spk)
+    cells.append((soma, nc))
+    stims.append(stim)
+    spikes.append(spk)
+
+cvode = h.CVode()
+cvode.active(1)
+tvec = h.Vector()
+tvec.record(h._ref_t)
+for jac in [0, 3]:
+    cvode.jacobian(jac)
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    nstep = tvec.size() - 1
+    nspike = sum(spk.size() for spk in spikes)
+    print(
+        f"jacobian={jac} steps={nstep} time={t1:.3f}s "
+        f"steps/s={nstep / t1:.0f} spikes={nspike}"
+    )
+cvode.jacobian(0)
+cvode.active(0)
@@ -0,0 +1,63 @@
+# Spike fan-out benchmark for PreSyn with many NetCon of a few delays.
+#
+# Connects ncell artificial cells all-to-all through synapses whose delays
+# take one of ndelay values (1M NetCon by default). Then a spike is one
+# event per (thread, delay) group instead of one per NetCon. With --jitter
+# every delay is made unique, which gives the per NetCon event baseline.
+# Run with e.g.
+#   python fanout_delays.py
+#   python fanout_delays.py --jitter
+#   python fanout_delays.py --ncell 2000 --ndelay 8
+# and compare the reported times; the spike counts have to agree.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=1000)
+parser.add_argument("--ndelay", type=int, default=4)
+parser.add_argument("--tstop", type=float, default=100.0)
+parser.add_argument("--jitter", action="store_true", help="make all delays distinct")
+args, _ = parser.parse_known_args()
+
+cells = []
+for i in range(args.ncell):
+    cell = h.IntFire1()
+    cell.tau = 10
+    cell.refrac = 5
+    cells.append(cell)
+stims = []
+for i, cell in enumerate(cells[:10]):
+    stim = h.NetStim()
+    stim.interval = 10
+    stim.number = 1e9
+    stim.start = i
+    nc = h.NetCon(stim, cell)
+    nc.weight[0] = 2
+    stims.append((stim, nc))
+
+ncs = []
+for i, src in enumerate(cells):
+    for j, tar in enumerate(cells):
+        nc = h.NetCon(src, tar)
+        nc.delay = 1.0 + (i + j) % args.ndelay
+        if args.jitter:
+            nc.delay += 1e-9 * (j + 1)
+        nc.weight[0] = 1.5 / args.ncell
+        ncs.append(nc)
+
+spikes = h.Vector()
+recorders = [h.NetCon(src, None) for src in cells]
+for nc in recorders:
+    nc.record(spikes)
+
+h.stdinit()
+t0 = h.startsw()
+h.continuerun(args.tstop)
+t1 = h.startsw() - t0
+print(
+    f"netcons={len(ncs)} ndelay={args.ndelay} jitter={args.jitter} "
+    f"time={t1:.3f}s spikes={int(spikes.size())}"
+)
@@ -0,0 +1,59 @@
+# NET_RECEIVE delivery benchmark for the fixed step bin queue.
+#
+# Drives ExpSyn and Exp2Syn synapses on ncell single compartment cells from
+# nstim NetStims, all with delays that are multiples of dt so that the
+# events of a step share one bin. Times the runs with CVode.queue_mode
+# batching of NET_RECEIVE calls by mechanism type off and on. Run with e.g.
+#   python receive_batch.py
+#   python receive_batch.py --ncell 20000 --nsyn 50
+# and compare the reported times; the voltage sums have to agree.
+
+import argparse
+import random
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=5000)
+parser.add_argument("--nstim", type=int, default=100)
+parser.add_argument("--nsyn", type=int, default=20, help="synapses per stim")
+parser.add_argument("--tstop", type=float, default=200.0)
+args, _ = parser.parse_known_args()
+
+random.seed(1)
+h.dt = 0.025
+cells = []
+syns = []
+for i in range(args.ncell):
+    sec = h.Section(name=f"cell[{i}]")
+    sec.L = sec.diam = 10
+    sec.insert("pas")
+    cells.append(sec)
+    syns.append(h.ExpSyn(sec(0.5)))
+    syns.append(h.Exp2Syn(sec(0.5)))
+    syns[-1].tau2 = 3
+stims = []
+netcons = []
+for i in range(args.nstim):
+    stim = h.NetStim()
+    stim.interval = 5
+    stim.number = 1e9
+    stim.start = i % 10
+    stims.append(stim)
+    for syn in random.sample(syns, args.nsyn):
+        nc = h.NetCon(stim, syn)
+        nc.delay = h.dt * random.randint(4, 40)
+        nc.weight[0] = 1e-4
+        netcons.append(nc)
+
+cvode = h.CVode()
+for batch in [0, 1]:
+    cvode.queue_mode(1, 0, 0, batch)
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    vsum = sum(sec(0.5).v for sec in cells)
+    print(f"batch={batch} ncon={len(netcons)} time={t1:.3f}s v={vsum:.12g}")
+cvode.queue_mode(0, 0, 0, 0)
@@ -0,0 +1,45 @@
+# Vector and Matrix transfer benchmark for the Python buffer protocol.
+#
+# Moves an n element Vector and an nrow x ncol Matrix to numpy with
+# Vector.to_python (element by element), numpy.array (a copy) and
+# numpy.asarray (a view through the buffer protocol), and a numpy array
+# back into a Vector with Vector.from_python and Vector.from_buffer.
+# Run with e.g.
+#   python buffer_protocol.py
+#   python buffer_protocol.py --n 10000000 --repeat 5
+# and compare the reported times; the sums have to agree.
+
+import argparse
+import numpy as np
+from neuron import h
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--n", type=int, default=1000000)
+parser.add_argument("--nrow", type=int, default=1000)
+parser.add_argument("--ncol", type=int, default=1000)
+parser.add_argument("--repeat", type=int, default=10)
+args, _ = parser.parse_known_args()
+
+vec = h.Vector(args.n).indgen()
+mat = h.Matrix(args.nrow, args.ncol)
+for i in range(args.nrow):
+    mat.setrow(i, i)
+
+
+def timed(label, f):
+    t0 = h.startsw()
+    for _ in range(args.repeat):
+        x = f()
+    t1 = (h.startsw() - t0) / args.repeat
+    print(f"{label:24s} time={t1 * 1e3:.3f}ms sum={np.sum(x):.12g}")
+
+
+timed("Vector.to_python", lambda: np.array(vec.to_python()))
+timed("numpy.array(Vector)", lambda: np.array(vec))
+timed("numpy.asarray(Vector)", lambda: np.asarray(vec))
+timed("numpy.asarray(Matrix)", lambda: np.asarray(mat))
+
+arr = np.random.default_rng(1).random(args.n)
+dest = h.Vector()
+timed("Vector.from_python", lambda: dest.from_python(arr))
+timed("Vector.from_buffer", lambda: dest.from_buffer(arr))
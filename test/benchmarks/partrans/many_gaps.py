@@ -0,0 +1,59 @@
+# Gap junction copy benchmark for the (storage, index) transfer tables.
+#
+# Connects ncell passive cells into a random graph with ngap ggap half gap
+# junctions (test/gjtests/ggap.mod) per cell, so that each step copies
+# ncell * ngap source voltages to targets spread over the mechanism data.
+# Times the fixed step runs for the given numbers of threads. Run with e.g.
+#   nrnivmodl ../../gjtests
+#   nrniv -python many_gaps.py
+#   nrniv -python many_gaps.py --ncell 100000 --ngap 4 --nthread 1 4
+# and compare the reported times against a build without the tables; the
+# voltage sums have to agree.
+
+import argparse
+import random
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=20000)
+parser.add_argument("--ngap", type=int, default=4, help="half gaps per cell")
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2])
+parser.add_argument("--tstop", type=float, default=20.0)
+args, _ = parser.parse_known_args()
+
+random.seed(1)
+cells = []
+gaps = []
+stims = []
+for i in range(args.ncell):
+    sec = h.Section(name=f"cell[{i}]")
+    sec.L = sec.diam = 10
+    sec.insert("pas")
+    pc.source_var(sec(0.5)._ref_v, i, sec=sec)
+    cells.append(sec)
+    if i % 10 == 0:
+        stim = h.IClamp(sec(0.5))
+        stim.delay = 1
+        stim.dur = 1e9
+        stim.amp = 0.05
+        stims.append(stim)
+for i, sec in enumerate(cells):
+    for _ in range(args.ngap):
+        gap = h.ggap(sec(0.5))
+        gap.g = 1e-4
+        pc.target_var(gap, gap._ref_vgap, random.randrange(args.ncell))
+        gaps.append(gap)
+pc.setup_transfer()
+
+for nthread in args.nthread:
+    pc.nthread(nthread)
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    vsum = sum(sec(0.5).v for sec in cells)
+    print(f"nthread={nthread} ngap={len(gaps)} time={t1:.3f}s v={vsum:.12g}")
+pc.nthread(1)
@@ -0,0 +1,63 @@
+# Gap junction transfer benchmark for the split phase (overlapped) exchange.
+#
+# Builds a ring of ncell Hodgkin-Huxley cells per rank joined by ggap half
+# gap junctions (test/gjtests/ggap.mod) whose partners are on the next rank,
+# so every step exchanges voltages between ranks. Times the fixed step runs
+# with nrn_overlap_partrans off and on. Run with e.g.
+#   nrnivmodl ../../gjtests
+#   mpiexec -n 8 nrniv -mpi -python overlap_transfer.py
+#   mpiexec -n 32 nrniv -mpi -python overlap_transfer.py --ncell 2000
+# and compare the reported transfer wait times; the voltage sums have to agree.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=500, help="cells per rank")
+parser.add_argument("--tstop", type=float, default=100.0)
+args, _ = parser.parse_known_args()
+
+rank = int(pc.id())
+nhost = int(pc.nhost())
+cells = []
+gaps = []
+stims = []
+for i in range(args.ncell):
+    gid = rank * args.ncell + i
+    soma = h.Section(name=f"soma[{gid}]")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    stim = h.IClamp(soma(0.5))
+    stim.delay = 1 + i % 10
+    stim.dur = 1e9
+    stim.amp = 0.1 + 0.2 * (gid % 3)
+    # source gid is gid, target of the gap towards the same cell index on the
+    # next rank
+    pc.source_var(soma(0.5)._ref_v, gid, sec=soma)
+    gap = h.ggap(soma(0.5))
+    gap.g = 1e-3
+    pc.target_var(gap, gap._ref_vgap, ((rank + 1) % nhost) * args.ncell + i)
+    cells.append(soma)
+    gaps.append(gap)
+    stims.append(stim)
+pc.setup_transfer()
+
+pc.set_maxstep(10)
+for overlap in [0, 1]:
+    h.nrn_overlap_partrans = overlap
+    h.finitialize(-65)
+    pc.barrier()
+    wait0 = pc.vtransfer_time()
+    t0 = h.startsw()
+    pc.psolve(args.tstop)
+    t1 = h.startsw() - t0
+    wait = pc.allreduce(pc.vtransfer_time() - wait0, 2) / nhost
+    vsum = pc.allreduce(sum(soma(0.5).v for soma in cells), 1)
+    if rank == 0:
+        print(f"overlap={overlap} time={t1:.3f}s transfer wait={wait:.3f}s v={vsum:.10g}")
+h.nrn_overlap_partrans = 0
+pc.barrier()
+h.quit()
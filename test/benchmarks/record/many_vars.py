@@ -0,0 +1,76 @@
+# Recording benchmark for Vector.record against RecordingSet.
+#
+# Simulates ncell passive single compartment cells with current clamps and
+# records the voltage of every cell, once with a Vector.record per cell and
+# once with one RecordingSet filled from a PtrVector, with the fixed step
+# method and the given numbers of threads. Run with e.g.
+#   python many_vars.py
+#   python many_vars.py --ncell 100000 --nthread 1 4
+# and compare the reported times against the run without recording; the
+# recorded values have to agree.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=20000)
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2])
+parser.add_argument("--tstop", type=float, default=20.0)
+args, _ = parser.parse_known_args()
+
+h.dt = 0.025
+cells = []
+stims = []
+for i in range(args.ncell):
+    sec = h.Section(name=f"cell[{i}]")
+    sec.L = sec.diam = 10
+    sec.insert("pas")
+    stim = h.IClamp(sec(0.5))
+    stim.delay = 1 + i % 10
+    stim.dur = 1e9
+    stim.amp = 0.01 * (1 + i % 7)
+    cells.append(sec)
+    stims.append(stim)
+
+nrow = int(args.tstop / h.dt) + 2
+pc = h.ParallelContext()
+
+
+def run(label):
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    print(f"nthread={int(pc.nthread())} {label:10s} time={t1:.3f}s")
+
+
+for nthread in args.nthread:
+    pc.nthread(nthread)
+    run("none")
+
+    vecs = []
+    for sec in cells:
+        vec = h.Vector()
+        vec.record(sec(0.5)._ref_v)
+        vecs.append(vec)
+    run("Vector")
+    vsum = sum(vec.sum() for vec in vecs)
+    vecs = []
+
+    pv = h.PtrVector(len(cells))
+    for i, sec in enumerate(cells):
+        pv.pset(i, sec(0.5)._ref_v)
+    rs = h.RecordingSet()
+    rs.add(pv)
+    rs.reserve(nrow)
+    run("RecordingSet")
+    col = h.Vector()
+    rsum = 0.0
+    for i in range(rs.ncol()):
+        rs.column(i, col)
+        rsum += col.sum()
+    print(f"  rows={int(rs.nrow())} v={vsum:.12g} {rsum:.12g}")
+    rs = None
+pc.nthread(1)
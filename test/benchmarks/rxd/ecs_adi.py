@@ -0,0 +1,42 @@
+# Extracellular diffusion benchmark for the fixed step DG-ADI solver.
+#
+# Times pure diffusion of a point source on cubic Extracellular grids of
+# increasing size with the given numbers of rxd threads. Run with e.g.
+#   python ecs_adi.py
+#   python ecs_adi.py --nthread 1 2 4 8 --sizes 64 128 256
+# and compare the reported times per step. The sums have to agree between
+# the numbers of threads.
+
+import argparse
+from neuron import h, rxd
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--sizes", type=int, nargs="+", default=[64, 128, 256])
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2, 4])
+parser.add_argument("--nstep", type=int, default=20)
+args, _ = parser.parse_known_args()
+
+h.dt = 0.1
+for n in args.sizes:
+    ecs = rxd.Extracellular(0, 0, 0, n, n, n, dx=1, volume_fraction=0.2, tortuosity=1.6)
+    k = rxd.Species(
+        ecs,
+        name="k",
+        d=2.62,
+        charge=1,
+        initial=lambda nd: 100 if nd.x3d == nd.y3d == nd.z3d == n // 2 else 3,
+    )
+    for nthread in args.nthread:
+        rxd.nthread(nthread)
+        h.finitialize(-65)
+        t0 = h.startsw()
+        for i in range(args.nstep):
+            h.fadvance()
+        t1 = h.startsw() - t0
+        print(
+            f"{n:4d}^3 nthread={nthread:2d} "
+            f"step={1000 * t1 / args.nstep:.2f}ms sum={k[ecs].states3d.sum():.10g}"
+        )
+    del k, ecs
@@ -0,0 +1,58 @@
+# Intracellular 3D diffusion benchmark for the fixed step DG-ADI solver.
+#
+# Times calcium diffusion in a branched dendrite simulated in 3D, with
+# homogeneous and with per voxel (inhomogeneous) diffusion coefficients and
+# the given numbers of rxd threads. Run with e.g.
+#   python ics_adi.py
+#   python ics_adi.py --nthread 1 2 4 --dx 0.1
+# and compare the reported times per step. The first steps include factoring
+# the line matrices, which is then reused while dt and the diffusion
+# coefficients do not change.
+
+import argparse
+from neuron import h, rxd
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--dx", type=float, default=0.2, help="voxel size (um)")
+parser.add_argument("--nbranch", type=int, default=4)
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2, 4])
+parser.add_argument("--nstep", type=int, default=100)
+args, _ = parser.parse_known_args()
+
+trunk = h.Section(name="trunk")
+trunk.pt3dadd(0, 0, 0, 3)
+trunk.pt3dadd(50, 0, 0, 2)
+branches = []
+for i in range(args.nbranch):
+    sec = h.Section(name=f"branch[{i}]")
+    sec.connect(trunk)
+    sec.pt3dadd(50, 0, 0, 1.5)
+    sec.pt3dadd(50 + 30, 30 * (2 * i - args.nbranch + 1) / args.nbranch, 10 * i, 1)
+    branches.append(sec)
+
+rxd.set_solve_type(dimension=3)
+cyt = rxd.Region(h.allsec(), name="cyt", nrn_region="i", dx=args.dx)
+ca = rxd.Species(cyt, name="ca", d=0.6, charge=2, initial=lambda nd: 1e-4)
+buf = rxd.Species(cyt, name="buf", initial=0.05)
+cabuf = rxd.Species(cyt, name="cabuf", initial=0)
+binding = rxd.Reaction(ca + buf, cabuf, 1e3, 0.1)
+
+h.dt = 0.025
+inhom = lambda nd: 0.6 if nd.x3d < 50 else 0.3
+for name, d in [("homogeneous", 0.6), ("inhomogeneous", inhom)]:
+    ca.d = d
+    for nthread in args.nthread:
+        rxd.nthread(nthread)
+        h.finitialize(-65)
+        ca.nodes(trunk(0.1)).concentration = 1e-2
+        t0 = h.startsw()
+        for i in range(args.nstep):
+            h.fadvance()
+        t1 = h.startsw() - t0
+        total = sum(nd.concentration for nd in ca.nodes)
+        print(
+            f"{name:14s} nodes={len(ca.nodes)} nthread={nthread:2d} "
+            f"step={1000 * t1 / args.nstep:.3f}ms ca={total:.10g}"
+        )
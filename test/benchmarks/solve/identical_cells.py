@@ -0,0 +1,68 @@
+# Benchmark for the lockstep gaussian elimination of interleaved cells.
+#
+# Builds ncell cells of nmorph morphologies, each a soma with hh and a
+# dendritic tree with pas, and times a fixed step run with node order 0,
+# node order 1 solved one cell at a time, and node order 1 solved for all
+# the cells in lockstep (ParallelContext.optimize_node_order(1, 1)), where
+# the corresponding nodes of identical cells are eliminated by one vector
+# loop. The matrix solve is a part of the step time, for its share run with
+# fewer mechanisms, e.g. --nohh. Run with e.g.
+#   python identical_cells.py
+#   python identical_cells.py --ncell 4000 --nmorph 1 --nohh
+# and compare the reported times; the voltage sums of the two node order 1
+# runs have to be identical, and agree with node order 0 up to round off.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=1000)
+parser.add_argument("--nmorph", type=int, default=2, help="distinct morphologies")
+parser.add_argument("--nohh", action="store_true", help="pas instead of hh in the soma")
+parser.add_argument("--nthread", type=int, default=1)
+parser.add_argument("--tstop", type=float, default=50.0)
+args, _ = parser.parse_known_args()
+
+
+def dendrites(soma, name, morph):
+    secs = []
+    for k in range(3 + morph):
+        dend = h.Section(name=f"{name}[{k}]")
+        dend.L = 150 + 50 * k
+        dend.diam = 1.5
+        dend.nseg = 7 + 2 * morph
+        dend.insert("pas")
+        dend.connect(secs[k // 2](1) if k > 1 else soma(1))
+        secs.append(dend)
+    return secs
+
+
+cells = []
+stims = []
+for i in range(args.ncell):
+    soma = h.Section(name=f"soma[{i}]")
+    soma.L = soma.diam = 20
+    soma.insert("pas" if args.nohh else "hh")
+    secs = [soma] + dendrites(soma, f"dend{i}", i % args.nmorph)
+    stim = h.IClamp(soma(0.5))
+    stim.delay = 1 + (i % 13) * 0.5
+    stim.dur = 1e9
+    stim.amp = 0.5
+    cells.append(secs)
+    stims.append(stim)
+
+pc = h.ParallelContext()
+pc.nthread(args.nthread)
+nnode = sum(sec.nseg for secs in cells for sec in secs)
+for order, simd in [(0, 0), (1, 0), (1, 1)]:
+    pc.optimize_node_order(order, simd)
+    h.finitialize(-65)
+    t0 = h.startsw()
+    h.continuerun(args.tstop)
+    t1 = h.startsw() - t0
+    vsum = sum(secs[-1](0.5).v for secs in cells)
+    print(f"order={order} simd={simd} nodes={nnode} time={t1:.3f}s v={vsum:.17g}")
+pc.optimize_node_order(0, 0)
+pc.nthread(1)
@@ -0,0 +1,54 @@
+# Benchmark for re-sorting the model data after adding single synapses.
+#
+# Builds ncell Hodgkin-Huxley cells with a passive dendrite, then adds one
+# ExpSyn at a time to a random dendrite segment and times the fadvance that
+# follows, which only has to sort the ExpSyn data and can reuse the cached
+# data of the other mechanism types. The "Model sorting" part of
+# print_local_memory_usage counts the full and incremental sorts. Run with e.g.
+#   python add_synapse.py
+#   python add_synapse.py --ncell 50000 --nsyn 100 --nthread 4
+# and compare the time per added synapse with the first fadvance times of
+# model_sort.py; the voltage sums have to agree between numbers of threads.
+
+import argparse
+import random
+from neuron import h
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=5000)
+parser.add_argument("--nsyn", type=int, default=20)
+parser.add_argument("--nthread", type=int, default=1)
+args, _ = parser.parse_known_args()
+
+cells = []
+for i in range(args.ncell):
+    soma = h.Section(name=f"soma[{i}]")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    dend = h.Section(name=f"dend[{i}]")
+    dend.L = 200
+    dend.diam = 1
+    dend.nseg = 5
+    dend.insert("pas")
+    dend.connect(soma(1))
+    cells.append((soma, dend))
+
+pc = h.ParallelContext()
+pc.nthread(args.nthread)
+h.finitialize(-65)
+h.fadvance()
+rng = random.Random(1)
+syns = []
+elapsed = 0.0
+for k in range(args.nsyn):
+    _, dend = cells[rng.randrange(len(cells))]
+    syn = h.ExpSyn(dend(rng.random()))
+    syn.e = 0
+    syns.append(syn)
+    t0 = h.startsw()
+    h.fadvance()
+    elapsed += h.startsw() - t0
+vsum = sum(soma(0.5).v for soma, _ in cells)
+print(f"nthread={args.nthread} per synapse={elapsed / args.nsyn:.4f}s v={vsum:.10g}")
+pc.nthread(1)
+h.print_local_memory_usage()
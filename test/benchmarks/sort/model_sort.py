@@ -0,0 +1,63 @@
+# Benchmark for re-sorting the model data after a structural change.
+#
+# Builds ncell cells with a soma and a few dendritic compartments carrying
+# several mechanism types, then repeatedly inserts a mechanism into one
+# section and times the first fadvance, which has to sort the data of all
+# mechanism types and rebuild the cache, with the given numbers of threads.
+# The "Model sorting" part of print_local_memory_usage reports the time spent
+# in the sorts themselves. Run with e.g.
+#   python model_sort.py
+#   python model_sort.py --ncell 50000 --nthread 1 4 8
+# and compare the reported times. The voltage sums of all the thread counts
+# have to be identical, which is asserted; the storage order and caches of a
+# serial and a parallel sort are compared by the testneuron unit tests.
+
+import argparse
+from neuron import h
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=5000)
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2, 4])
+parser.add_argument("--repeat", type=int, default=5)
+args, _ = parser.parse_known_args()
+
+cells = []
+stims = []
+for i in range(args.ncell):
+    soma = h.Section(name=f"soma[{i}]")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    dend = h.Section(name=f"dend[{i}]")
+    dend.L = 200
+    dend.diam = 1
+    dend.nseg = 5
+    dend.insert("pas")
+    dend.insert("extracellular")
+    dend.connect(soma(1))
+    stim = h.IClamp(soma(0.5))
+    stim.delay = 0.1
+    stim.dur = 1e9
+    stim.amp = 0.2
+    cells.append((soma, dend))
+    stims.append(stim)
+
+pc = h.ParallelContext()
+vsums = []
+for nthread in args.nthread:
+    pc.nthread(nthread)
+    h.finitialize(-65)
+    elapsed = 0.0
+    for k in range(args.repeat):
+        soma, _ = cells[k % len(cells)]
+        for change in (soma.insert, soma.uninsert):
+            change("pas")
+            t0 = h.startsw()
+            h.fadvance()
+            elapsed += h.startsw() - t0
+    vsum = sum(soma(0.5).v for soma, _ in cells)
+    nsort = 2 * args.repeat
+    print(f"nthread={nthread:2d} first fadvance={elapsed / nsort:.4f}s v={vsum:.10g}")
+    vsums.append(vsum)
+pc.nthread(1)
+assert all(vsum == vsums[0] for vsum in vsums), vsums
+h.print_local_memory_usage()
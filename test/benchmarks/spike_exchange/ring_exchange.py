@@ -0,0 +1,79 @@
+# Spike exchange scaling benchmark on a ringtest style network.
+#
+# Compares the default Allgather spike exchange with the sparse (neighbour
+# collective) exchange selected by bit 1 and the node aware (shared memory)
+# Allgather selected by bit 4 of the third argument of
+# ParallelContext.spike_compress. Run with e.g.
+#   mpiexec -n 16 nrniv -mpi -python ring_exchange.py
+#   mpiexec -n 64 nrniv -mpi -python ring_exchange.py --nring 256
+# and compare the reported spike exchange times.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--nring", type=int, default=64)
+parser.add_argument("--ncell", type=int, default=16, help="cells per ring")
+parser.add_argument("--tstop", type=float, default=100.0)
+args, _ = parser.parse_known_args()
+
+
+class Cell:
+    def __init__(self, gid):
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.L = self.soma.diam = 10
+        self.soma.insert("hh")
+        self.syn = h.ExpSyn(self.soma(0.5))
+        pc.set_gid2node(gid, pc.id())
+        pc.cell(gid, h.NetCon(self.soma(0.5)._ref_v, None, sec=self.soma))
+
+
+# gids of one ring are consecutive and distributed round robin, so every
+# connection crosses ranks but each rank only talks to a few neighbours.
+ngid = args.nring * args.ncell
+cells = {gid: Cell(gid) for gid in range(pc.id(), ngid, pc.nhost())}
+ncs = []
+stims = []
+for gid, cell in cells.items():
+    ring, i = divmod(gid, args.ncell)
+    src = ring * args.ncell + (i - 1) % args.ncell
+    nc = pc.gid_connect(src, cell.syn)
+    nc.delay = 1.0
+    nc.weight[0] = 0.01
+    ncs.append(nc)
+    if i == 0:
+        stim = h.NetStim()
+        stim.number = 1
+        stim.start = 0
+        nc = h.NetCon(stim, cell.syn)
+        nc.delay = 1.0
+        nc.weight[0] = 0.01
+        stims.append((stim, nc))
+
+for name, xchng_meth in [("allgather", 0), ("sparse", 2), ("node", 16)]:
+    pc.spike_compress(0, 0, xchng_meth)
+    pc.set_maxstep(10)
+    h.finitialize(-65)
+    pc.barrier()
+    w0 = pc.wait_time()
+    t0 = h.startsw()
+    pc.psolve(args.tstop)
+    t1 = h.startsw() - t0
+    wait = pc.allreduce(pc.wait_time() - w0, 2)
+    nsend, nrecv, nrecv_useful = h.ref(0), h.ref(0), h.ref(0)
+    pc.spike_statistics(nsend, nrecv, nrecv_useful)
+    nrecv = pc.allreduce(nrecv[0], 1)
+    nrecv_useful = pc.allreduce(nrecv_useful[0], 1)
+    if pc.id() == 0:
+        print(
+            f"{name:10s} nhost={int(pc.nhost())} ngid={ngid} "
+            f"received={int(nrecv)} useful={int(nrecv_useful)} "
+            f"run={t1:.3f}s max_wait={wait:.3f}s"
+        )
+
+pc.spike_compress(0, 0, 0)
+pc.barrier()
+h.quit()
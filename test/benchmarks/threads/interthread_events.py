@@ -0,0 +1,74 @@
+# Inter-thread event delivery benchmark.
+#
+# Every cell of a randomly and densely connected network of spiking cells
+# is driven by its own Poisson input, so almost all NetCon events cross
+# NrnThread boundaries. Times the fixed step simulation for the given
+# numbers of threads and input rates. Run with e.g.
+#   python interthread_events.py
+#   python interthread_events.py --nthread 1 2 4 8 --rates 20 80 320
+# and compare the reported times; the spike counts have to agree between
+# the numbers of threads.
+
+import argparse
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ncell", type=int, default=512)
+parser.add_argument("--nconn", type=int, default=100, help="connections per cell")
+parser.add_argument("--nthread", type=int, nargs="+", default=[1, 2, 4])
+parser.add_argument("--rates", type=float, nargs="+", default=[20, 80, 320], help="Hz")
+parser.add_argument("--tstop", type=float, default=200.0)
+args, _ = parser.parse_known_args()
+
+
+class Cell:
+    def __init__(self, i):
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.L = self.soma.diam = 10
+        self.soma.insert("hh")
+        self.syn = h.ExpSyn(self.soma(0.5))
+        self.spikes = h.NetCon(self.soma(0.5)._ref_v, None, sec=self.soma)
+        # the input is in the same thread as the cell
+        self.stim = h.NetStim(self.soma(0.5))
+        self.stim.noise = 1
+        self.stim.start = 0
+        self.stim.number = 1e9
+        self.stim.noiseFromRandom123(i, 0, 0)
+        self.input = h.NetCon(self.stim, self.syn)
+        self.input.delay = 0.1
+        self.input.weight[0] = 0.02
+
+
+cells = [Cell(i) for i in range(args.ncell)]
+r = h.Random()
+r.Random123(1, 2, 3)
+ncs = []
+for i, cell in enumerate(cells):
+    for k in range(args.nconn):
+        src = cells[int(r.discunif(0, args.ncell - 1))]
+        nc = h.NetCon(src.soma(0.5)._ref_v, cell.syn, sec=src.soma)
+        nc.delay = r.uniform(1.0, 5.0)
+        nc.weight[0] = 0.0005
+        ncs.append(nc)
+nspike = h.Vector()
+for cell in cells:
+    cell.spikes.record(nspike)
+
+for rate in args.rates:
+    for cell in cells:
+        cell.stim.interval = 1000.0 / rate
+    for nthread in args.nthread:
+        pc.nthread(nthread)
+        nspike.resize(0)
+        h.tstop = args.tstop
+        h.stdinit()
+        t0 = h.startsw()
+        h.continuerun(args.tstop)
+        t1 = h.startsw() - t0
+        print(
+            f"rate={rate:6.1f}Hz nthread={nthread:2d} time={t1:.3f}s "
+            f"spikes={int(nspike.size())} events={int(nspike.size()) * args.nconn}"
+        )
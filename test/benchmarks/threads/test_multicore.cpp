@@ -19,6 +19,7 @@
  *  * parallel mode (std::threads)
  *  * parallel mode with busywait
  *  * serial mode
+ *  * task mode (fewer worker threads than threads) with imbalanced threads
  *  * performance
  *      * NOTE: GitHub runners don't have enough capabilities for performance KPIs
  */
@@ -203,4 +204,51 @@ TEST_CASE("Multicore unit and performance testing", "[NEURON][multicore]") {
             }
         }
     }
+
+    SECTION("Test task mode with imbalanced threads", "[NEURON][multicore][tasks]") {
+        const int nof_workers = nof_threads_range.back();
+        // Each worker starts with this many threads in its queue
+        const int tasks_per_worker = 8;
+        const int nof_tasks = tasks_per_worker * nof_workers;
+        auto run = [](int nthread, bool parallel, int nworker, double& sum_v) {
+            nrn_threads_create(nthread, parallel, nworker);
+            REQUIRE(hoc_oc(("imbalanced_partition(" + std::to_string(nthread) + ")\n").c_str()) ==
+                    0);
+            auto start = std::chrono::high_resolution_clock::now();
+            REQUIRE(hoc_oc("prun()") == 0);
+            auto end = std::chrono::high_resolution_clock::now();
+            REQUIRE(hoc_oc("sum_dend_v()") == 0);
+            sum_v = hoc_ac_;
+            return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        };
+        WHEN("a few threads hold all the expensive cells") {
+            REQUIRE(hoc_oc("pc.thread_busywait(0)") == 0);
+            REQUIRE(hoc_oc(imbalanced_partition) == 0);
+            REQUIRE(hoc_oc(make_imbalanced_cells) == 0);
+            double v_serial{}, v_static{}, v_tasks{};
+            const auto t_serial = run(nof_tasks, false, 0, v_serial);
+            REQUIRE(nof_worker_threads() == 0);
+            const auto t_static = run(nof_workers, true, 0, v_static);
+            REQUIRE(nof_worker_threads() == (nof_workers > 1 ? nof_workers : 0));
+            const auto t_tasks = run(nof_tasks, true, nof_workers, v_tasks);
+            REQUIRE(nrn_nthread == nof_tasks);
+            REQUIRE(nof_worker_threads() == (nof_workers > 1 ? nof_workers : 0));
+            std::cout << "[tasks][simulation times] : " << std::endl;
+            std::cout << "workers\tserial\tstatic\ttasks" << std::endl;
+            std::cout << nof_workers << "\t" << t_serial << "\t" << t_static << "\t" << t_tasks
+                      << std::endl;
+            // the results do not depend on which worker ran which thread
+            REQUIRE(v_tasks == v_serial);
+            REQUIRE(v_static == v_serial);
+            // stealing tasks balances the load
+            if (nof_threads_range.size() > 2) {
+                CHECK(t_tasks < t_static);
+            } else {
+                WARN("Not enough threads to test task mode performance KPI");
+            }
+            REQUIRE(hoc_oc("pc.partition()") == 0);
+            REQUIRE(hoc_oc(make_balanced_cells) == 0);
+            nrn_threads_create(1, true);
+        }
+    }
 }
@@ -133,3 +133,44 @@ std::string operator"" _pas_cells(unsigned long long nof_cells) {
     )";
     return cells;
 };
+
+// make the first ncell/8 cells much more expensive than the others
+constexpr auto make_imbalanced_cells = R"(
+for i=0, ncell/8 - 1 {
+    cell[i].dend.nseg = 2001
+}
+)";
+
+// undo make_imbalanced_cells
+constexpr auto make_balanced_cells = R"(
+for i=0, ncell/8 - 1 {
+    cell[i].dend.nseg = 100
+}
+)";
+
+/**
+ * @brief imbalanced_partition(nt)
+ * puts contiguous blocks of cells in each of the nt threads, so that with
+ * make_imbalanced_cells the first threads get all of the expensive cells.
+ * hoc_ac_ is set to the sum of the dend voltages at the end of prun().
+ */
+constexpr auto imbalanced_partition = R"(
+objref part_sl
+proc imbalanced_partition() {local i, t, nt
+    nt = $1
+    for t = 0, nt - 1 {
+        part_sl = new SectionList()
+        for i = int(t*ncell/nt), int((t+1)*ncell/nt) - 1 {
+            cell[i].soma part_sl.append()
+        }
+        pc.partition(t, part_sl)
+    }
+    objref part_sl
+}
+proc sum_dend_v() {local i
+    hoc_ac_ = 0
+    for i=0, ncell - 1 {
+        hoc_ac_ += cell[i].dend.v(0.5)
+    }
+}
+)";
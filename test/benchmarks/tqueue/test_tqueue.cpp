@@ -0,0 +1,79 @@
+#include "tqueue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/* @brief
+ *  Compare the splay tree and calendar queue TQueue backends:
+ *  * both deliver the same events in the same order (including ties)
+ *  * "hold" benchmark: dequeue the least event and insert a new one in the
+ *    future, as artificial cells do with SelfEvents
+ */
+
+namespace {
+struct HoldResult {
+    std::vector<std::uintptr_t> order;
+    double seconds;
+};
+
+// Fill the queue with nitem events and then do nop dequeue/insert pairs
+// (with some moves and removals mixed in). Returns the delivery order.
+HoldResult hold(bool calendar, std::size_t nitem, std::size_t nop) {
+    TQItemPool pool(1000);
+    TQueue tq(&pool, 0, calendar);
+    REQUIRE(tq.uses_calendar_queue() == calendar);
+    std::mt19937_64 gen{42};
+    std::exponential_distribution<double> interval{0.1};
+    std::vector<TQItem*> items(nitem);
+    for (std::size_t i = 0; i < nitem; ++i) {
+        // multiples of 0.125 so that there are many simultaneous events
+        double t = std::floor(8. * interval(gen)) / 8.;
+        items[i] = tq.insert(t, reinterpret_cast<void*>(i + 1));
+    }
+    HoldResult result{};
+    result.order.reserve(nop);
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < nop; ++i) {
+        TQItem* q = tq.atomic_dq(1e15);
+        void* data = q->data_;
+        double t = q->t_;
+        tq.release(q);
+        auto const id = reinterpret_cast<std::uintptr_t>(data);
+        result.order.push_back(id);
+        items[id - 1] = tq.insert(t + std::floor(8. * interval(gen)) / 8., data);
+        std::size_t const other = gen() % nitem;
+        if (i % 5 == 0) {
+            tq.move(items[other], t + std::floor(8. * interval(gen)) / 8.);
+        } else if (i % 7 == 0) {
+            double t2 = items[other]->t_;
+            tq.remove(items[other]);
+            items[other] = tq.insert(t2, reinterpret_cast<void*>(other + 1));
+        }
+    }
+    auto const end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+}  // namespace
+
+TEST_CASE("TQueue splay tree vs calendar queue", "[NEURON][tqueue]") {
+    auto const nitem = GENERATE(std::size_t{1000}, std::size_t{100000}, std::size_t{1000000});
+    std::size_t const nop = 2000000;
+    auto const splay = hold(false, nitem, nop);
+    auto const calendar = hold(true, nitem, nop);
+    THEN("both backends deliver the events in the same order") {
+        REQUIRE(splay.order == calendar.order);
+    }
+    THEN("we print the results") {
+        std::cout << "[tqueue][hold] nitem=" << nitem << " nop=" << nop
+                  << " splay=" << splay.seconds << "s calendar=" << calendar.seconds << "s"
+                  << std::endl;
+    }
+}
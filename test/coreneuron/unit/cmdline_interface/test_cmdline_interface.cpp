@@ -70,6 +70,9 @@ TEST_CASE("cmdline_interface") {
         "--mindelay",
         "0.1",
 
+        "--report-async-buffers",
+        "16",
+
         "--dt_io",
         "0.2"};
     constexpr int argc = sizeof argv / sizeof argv[0];
@@ -113,6 +116,8 @@ TEST_CASE("cmdline_interface") {
 
     REQUIRE(corenrn_param_test.mindelay == 0.1);
 
+    REQUIRE(corenrn_param_test.report_async_buffers == 16);
+
     REQUIRE(corenrn_param_test.ms_phases == 1);
 
     REQUIRE(corenrn_param_test.ms_subint == 2);
@@ -0,0 +1,168 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2022 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================.
+*/
+#include "coreneuron/io/nrn_filehandler.hpp"
+#include "coreneuron/nrnconf.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace coreneuron;
+
+namespace {
+// Write nblock blocks of "<int>\n" followed by a double and an int array, as
+// the phase files do. With pad, chkpnt lines are padded like nrncore_write
+// does, otherwise the file is written as by bbcore_write_version 1.8.
+void write_blocks(const std::string& fname, std::size_t nblock, std::size_t n, bool pad) {
+    std::vector<double> d(n);
+    std::vector<int> ia(n);
+    std::iota(d.begin(), d.end(), 0.5);
+    std::iota(ia.begin(), ia.end(), 0);
+    FILE* f = fopen(fname.c_str(), "wb");
+    REQUIRE(f);
+    fprintf(f, "%s\n", pad ? bbcore_write_version : "1.8");
+    int chkpnt = 0;
+    auto write_chkpnt = [&]() {
+        long pos = ftell(f);
+        int len = fprintf(f, "chkpnt %d", chkpnt++);
+        int npad = pad ? int((chkpnt_align - (pos + len + 1) % chkpnt_align) % chkpnt_align) : 0;
+        fprintf(f, "%*s\n", npad, "");
+    };
+    for (std::size_t i = 0; i < nblock; ++i) {
+        fprintf(f, "%d\n", int(i));
+        write_chkpnt();
+        fwrite(d.data(), sizeof(double), n, f);
+        write_chkpnt();
+        fwrite(ia.data(), sizeof(int), n, f);
+    }
+    fclose(f);
+}
+
+// Read the blocks with FileHandler, return a checksum.
+double read_blocks(const std::string& fname, std::size_t nblock, std::size_t n) {
+    FileHandler F(fname);
+    REQUIRE(!F.fail());
+    std::vector<double> d(n);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < nblock; ++i) {
+        REQUIRE(F.read_int() == int(i));
+        F.read_array(d.data(), n);
+        auto ia = F.read_vector<int>(n);
+        sum += d.back() + ia.back();
+    }
+    REQUIRE(F.eof());
+    F.close();
+    return sum;
+}
+
+// Read the blocks the way FileHandler did before bbcore_write_version 1.9:
+// std::fstream, getline into a line buffer, sscanf, read.
+double stream_read_blocks(const std::string& fname, std::size_t nblock, std::size_t n) {
+    std::fstream F(fname, std::ios::in | std::ios::binary);
+    char line[1024];
+    F.getline(line, sizeof(line));
+    std::vector<double> d(n);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < nblock; ++i) {
+        int k;
+        F.getline(line, sizeof(line));
+        sscanf(line, "%d", &k);
+        F.getline(line, sizeof(line));
+        sscanf(line, "chkpnt %d\n", &k);
+        F.read((char*) d.data(), n * sizeof(double));
+        F.getline(line, sizeof(line));
+        sscanf(line, "chkpnt %d\n", &k);
+        auto ia = std::vector<int>(n);
+        F.read((char*) ia.data(), n * sizeof(int));
+        sum += d.back() + ia.back();
+    }
+    REQUIRE(!F.fail());
+    return sum;
+}
+}  // namespace
+
+TEST_CASE("FileHandler write and read back", "[filehandler]") {
+    const std::string fname = "filehandler_test.dat";
+    std::vector<double> d{1.0, 2.0, 3.0};
+    std::vector<int> ia{4, 5, 6, 7};
+    {
+        FileHandler F;
+        F.open(fname, std::ios::out);
+        F << 42 << "\n";
+        F.write_array(d.data(), d.size());
+        F << "1 2 3 4 extra words\n";
+        F.write_array(ia.data(), ia.size());
+        F.close();
+    }
+    // the arrays start at multiples of chkpnt_align in the file
+    {
+        std::ifstream in(fname, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        auto darr = contents.find("chkpnt 0");
+        darr = contents.find('\n', darr) + 1;
+        REQUIRE(darr % chkpnt_align == 0);
+        auto iarr = contents.find("chkpnt 1", darr + d.size() * sizeof(double));
+        iarr = contents.find('\n', iarr) + 1;
+        REQUIRE(iarr % chkpnt_align == 0);
+    }
+    FileHandler F;
+    F.open(fname);
+    REQUIRE(!F.fail());
+    REQUIRE(F.read_int() == 42);
+    REQUIRE(F.read_vector<double>(d.size()) == d);
+    int gid, nsec, nseg, nseclist;
+    F.read_mapping_count(&gid, &nsec, &nseg, &nseclist);
+    REQUIRE(gid == 1);
+    REQUIRE(nseclist == 4);
+    int* p = F.read_array<int>(ia.size());
+    REQUIRE(std::vector<int>(p, p + ia.size()) == ia);
+    delete[] p;
+    REQUIRE(F.eof());
+    F.close();
+    REQUIRE(!F.fail());
+    // as with std::fstream, closing a closed file fails
+    F.close();
+    REQUIRE(F.fail());
+    std::remove(fname.c_str());
+}
+
+TEST_CASE("FileHandler reads version 1.8 files", "[filehandler]") {
+    REQUIRE(bbcore_read_version_supported(bbcore_write_version));
+    REQUIRE(bbcore_read_version_supported("1.8"));
+    REQUIRE_FALSE(bbcore_read_version_supported("1.7"));
+    const std::string fname = "filehandler_unpadded.dat";
+    write_blocks(fname, 3, 10, false);
+    REQUIRE(read_blocks(fname, 3, 10) == 3 * (9.5 + 9));
+    std::remove(fname.c_str());
+}
+
+// Load benchmark, not run by default: filehandler_test_bin "[benchmark]"
+TEST_CASE("FileHandler load benchmark", "[.][benchmark]") {
+    const std::size_t nblock = 20000;
+    const std::size_t n = 1000;
+    const std::string fname = "filehandler_benchmark.dat";
+    for (bool pad: {false, true}) {
+        write_blocks(fname, nblock, n, pad);
+        auto t0 = std::chrono::steady_clock::now();
+        double s0 = stream_read_blocks(fname, nblock, n);
+        auto t1 = std::chrono::steady_clock::now();
+        double s1 = read_blocks(fname, nblock, n);
+        auto t2 = std::chrono::steady_clock::now();
+        REQUIRE(s0 == s1);
+        std::cout << "[filehandler] padded=" << pad << " fstream "
+                  << std::chrono::duration<double>(t1 - t0).count() << "s, mapped "
+                  << std::chrono::duration<double>(t2 - t1).count() << "s" << std::endl;
+    }
+    std::remove(fname.c_str());
+}
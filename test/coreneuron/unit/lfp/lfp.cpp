@@ -13,7 +13,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <chrono>
 #include <iostream>
+#include <random>
 
 using namespace coreneuron;
 using namespace coreneuron::lfputils;
@@ -113,6 +115,128 @@ TEST_CASE("LFP_PointSource_LineSource") {
 #endif
 }
 
+namespace {
+struct RandomCircuit {
+    Point3Ds starts, ends, electrodes;
+    std::vector<double> radii;
+    std::vector<int> indices;
+    std::vector<double> currents;
+
+    RandomCircuit(std::size_t n_segments, std::size_t n_electrodes) {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<double> pos{-100.0, 100.0};
+        std::uniform_real_distribution<double> dir{-2.0, 2.0};
+        for (std::size_t l = 0; l < n_segments; ++l) {
+            starts.push_back({pos(gen), pos(gen), pos(gen)});
+            ends.push_back(paxpy(starts.back(), 1.0, {dir(gen), dir(gen), dir(gen)}));
+            radii.push_back(0.5);
+            // currents are not in segment order
+            indices.push_back(n_segments - 1 - l);
+            currents.push_back(dir(gen));
+        }
+        for (std::size_t k = 0; k < n_electrodes; ++k) {
+            electrodes.push_back({pos(gen), pos(gen), pos(gen)});
+        }
+    }
+
+    // Straightforward electrode x segment sum of the factors within cutoff.
+    std::vector<double> reference_lfp(double cutoff) const {
+        const double f = 1.0 / (4.0 * pi);
+        std::vector<double> res(electrodes.size());
+        for (std::size_t k = 0; k < electrodes.size(); ++k) {
+            for (std::size_t l = 0; l < starts.size(); ++l) {
+                double dist = norm(paxpy(electrodes[k], -1.0, barycenter(starts[l], ends[l])));
+                if (cutoff == 0.0 || dist <= cutoff) {
+                    res[k] += line_source_lfp_factor(
+                                  electrodes[k], starts[l], ends[l], radii[l], f) *
+                              currents[indices[l]];
+                }
+            }
+        }
+        return res;
+    }
+};
+}  // namespace
+
+TEST_CASE("LFP_Dense_and_Cutoff") {
+    pi = 3.141592653589;
+    // electrode count not a multiple of the row blocking and segment count
+    // larger than one tile, so that all the remainder loops are exercised
+    RandomCircuit circuit(5000, 37);
+    for (double cutoff: {0.0, 1.0e6, 60.0}) {
+        LFPCalculator<LineSource> lfp(circuit.starts,
+                                      circuit.ends,
+                                      circuit.radii,
+                                      circuit.indices,
+                                      circuit.electrodes,
+                                      1.0,
+                                      cutoff);
+        if (cutoff == 60.0) {
+            REQUIRE_FALSE(lfp.is_dense());
+            REQUIRE(lfp.num_factors() < circuit.starts.size() * circuit.electrodes.size());
+        } else {
+            // a cutoff that drops nothing gives the dense matrix
+            REQUIRE(lfp.is_dense());
+        }
+        lfp.lfp(circuit.currents);
+        // twice, to check that the buffers reused between calls are reset
+        lfp.lfp(circuit.currents);
+        auto reference = circuit.reference_lfp(cutoff);
+        REQUIRE(lfp.lfp_values().size() == reference.size());
+        for (std::size_t k = 0; k < reference.size(); ++k) {
+            REQUIRE_THAT(lfp.lfp_values()[k], Catch::Matchers::WithinRel(reference[k], 1.0e-8));
+        }
+    }
+    REQUIRE_THROWS_AS(LFPCalculator<LineSource>(circuit.starts,
+                                                circuit.ends,
+                                                circuit.radii,
+                                                circuit.indices,
+                                                circuit.electrodes,
+                                                1.0,
+                                                -1.0),
+                      std::invalid_argument);
+
+    // a cutoff below every electrode-segment distance drops all the factors
+    LFPCalculator<LineSource> none(circuit.starts,
+                                   circuit.ends,
+                                   circuit.radii,
+                                   circuit.indices,
+                                   circuit.electrodes,
+                                   1.0,
+                                   1.0e-6);
+    REQUIRE_FALSE(none.is_dense());
+    REQUIRE(none.num_factors() == 0);
+    none.lfp(circuit.currents);
+    REQUIRE(none.lfp_values().size() == circuit.electrodes.size());
+    for (double value: none.lfp_values()) {
+        REQUIRE(value == 0.0);
+    }
+}
+
+// Micro-benchmark, not run by default: lfp_test_bin "[benchmark]"
+TEST_CASE("LFP_Benchmark", "[.][benchmark]") {
+    pi = 3.141592653589;
+    RandomCircuit circuit(100000, 1000);
+    const int nstep = 20;
+    for (double cutoff: {0.0, 50.0, 20.0}) {
+        LFPCalculator<LineSource> lfp(circuit.starts,
+                                      circuit.ends,
+                                      circuit.radii,
+                                      circuit.indices,
+                                      circuit.electrodes,
+                                      1.0,
+                                      cutoff);
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nstep; ++i) {
+            lfp.lfp(circuit.currents);
+        }
+        auto const end = std::chrono::steady_clock::now();
+        std::cout << "[lfp] cutoff=" << cutoff << " factors=" << lfp.num_factors()
+                  << " time/step=" << std::chrono::duration<double>(end - start).count() / nstep
+                  << "s" << std::endl;
+    }
+}
+
 #ifdef ENABLE_SONATA_REPORTS
 #define CATCH_CONFIG_MAIN
 
@@ -198,6 +322,7 @@ TEST_CASE("LFP_ReportEvent") {
     const double report_dt = 0.1;
 
     ReportEvent event(dt, tstart, vars_to_report, report_name.data(), report_dt, ReportType::LFP);
+    event.freeze_currents(nt);
     event.lfp_calc(&nt);
 
     REQUIRE_THAT(mapinfo->_lfp[0], Catch::Matchers::WithinAbs(5.5, 1.0));
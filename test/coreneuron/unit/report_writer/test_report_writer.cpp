@@ -0,0 +1,120 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2022 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================.
+*/
+#include "coreneuron/io/reports/report_event.hpp"
+#include "coreneuron/io/reports/report_writer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace coreneuron;
+
+namespace {
+constexpr double report_step_dt = 0.025;
+
+/// A report that keeps the steps and values libsonata would read instead of recording them
+class CapturingReport: public ReportEvent {
+  public:
+    CapturingReport(const VarsToReport& vars, double report_dt, std::chrono::microseconds delay)
+        : ReportEvent(report_step_dt, 0.0, vars, "capture", report_dt, ReportType::Compartment)
+        , delay(delay) {}
+
+    std::vector<std::pair<double, std::vector<double>>> recorded;
+
+  protected:
+    void record_node_data(double step) override {
+        // libsonata keys the values by gid
+        const std::map<uint64_t, std::vector<VarWithMapping>> by_gid(registered_vars().begin(),
+                                                                     registered_vars().end());
+        std::vector<double> values;
+        for (const auto& gid: by_gid) {
+            for (const auto& var: gid.second) {
+                values.push_back(*var.var_value);
+            }
+        }
+        recorded.emplace_back(step, std::move(values));
+        // a slow writer, so that the simulation runs into back-pressure
+        std::this_thread::sleep_for(delay);
+    }
+
+  private:
+    std::chrono::microseconds delay;
+};
+
+double value(int step, int var) {
+    return 100.0 * step + var;
+}
+}  // namespace
+
+TEST_CASE("ReportWriter records the steps of the synchronous path", "[ReportWriter]") {
+    constexpr int num_vars = 3;
+    constexpr int num_steps = 42;
+    constexpr int reporting_period = 2;
+    constexpr std::size_t num_slots = 2;
+    std::vector<double> data(num_vars);
+    VarsToReport vars;
+    // gid 7 before gid 3 in the map, the reports order the gids
+    vars[7].emplace_back(0, &data[2]);
+    vars[3].emplace_back(0, &data[0]);
+    vars[3].emplace_back(1, &data[1]);
+    std::vector<double*> sources{&data[0], &data[1], &data[2]};
+    const double report_dt = reporting_period * report_step_dt;
+
+    // without a writer, the values are read when deliver records the step
+    std::vector<std::pair<double, std::vector<double>>> expected;
+    for (int step = 0; step < num_steps; ++step) {
+        for (int i = 0; i < num_vars; ++i) {
+            data[i] = value(step, i);
+        }
+        expected.emplace_back(step, data);
+    }
+
+    report_writer = std::make_unique<ReportWriter>(num_slots, true);
+    CapturingReport report(vars, report_dt, std::chrono::microseconds(200));
+    double pending_step = 0.0;
+    std::size_t num_pushed = 0;
+    for (int step = 0; step < num_steps; ++step) {
+        for (int i = 0; i < num_vars; ++i) {
+            data[i] = value(step, i);
+        }
+        if (step % reporting_period == 0) {
+            report_writer->push(&report, pending_step, step, sources);
+            pending_step = step + 1;
+            ++num_pushed;
+        }
+    }
+    // the steps after the last reporting step, as queued by push_pending_steps
+    REQUIRE(pending_step < num_steps);
+    report_writer->push(&report, pending_step, num_steps - 1, sources, false);
+    ++num_pushed;
+    // the values change while the writer still records the queued steps
+    for (int i = 0; i < num_vars; ++i) {
+        data[i] = -1.0;
+    }
+    report_writer->finalize(num_steps * report_step_dt);
+
+    const auto stats = report_writer->stats();
+    REQUIRE(num_pushed > num_slots);
+    REQUIRE(stats.num_slots == num_pushed);
+    REQUIRE(stats.max_used <= num_slots);
+    REQUIRE(stats.num_stalls > 0);
+
+    REQUIRE(report.recorded.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(report.recorded[i].first == expected[i].first);
+        // libsonata only reads the values of the reporting steps
+        if (static_cast<int>(expected[i].first) % reporting_period == 0) {
+            REQUIRE(report.recorded[i].second == expected[i].second);
+        }
+    }
+    report_writer.reset();
+}
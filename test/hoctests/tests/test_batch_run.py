@@ -0,0 +1,76 @@
+# batch_run writes a frame of the batch_save variables every tstep, as text or
+# as native doubles. With the fixed step method the steps between frames are
+# done by nrn_fixed_step_group. Both files have to hold the values that
+# Vector.record sees at those steps, the binary one exactly.
+
+import os
+import tempfile
+import numpy as np
+from neuron import h
+
+pc = h.ParallelContext()
+
+
+def model(ncell=5):
+    secs = []
+    stims = []
+    for i in range(ncell):
+        sec = h.Section(name="cell%d" % i)
+        sec.L = sec.diam = 20
+        sec.insert("hh")
+        stim = h.IClamp(sec(0.5))
+        stim.delay = 0.5 + 0.3 * i
+        stim.dur = 1e9
+        stim.amp = 0.3 + 0.05 * i
+        secs.append(sec)
+        stims.append(stim)
+    return secs, stims
+
+
+def read(path, binary):
+    with open(path, "rb") as f:
+        header = [f.readline() for i in range(2 + binary)]
+        assert header[0] == b"batch test\n"
+        assert header[1].startswith(b"batch_run from t = 0 to 5.05 in steps of 0.1")
+        if binary:
+            nvar = int(header[2].split()[2])
+            return np.fromfile(f, dtype=np.float64).reshape(-1, nvar)
+        return np.array([[float(x) for x in line.split()] for line in f])
+
+
+def test_batch_run():
+    secs, stims = model()
+    refs = [sec(0.5)._ref_v for sec in secs] + [secs[0](0.5)._ref_m_hh]
+    h.batch_save()
+    h.batch_save(*refs)
+    # every step, a frame is every fourth
+    vecs = [h.Vector().record(ref) for ref in refs]
+    tstep = 4 * h.dt
+    path = os.path.join(tempfile.mkdtemp(), "batch.dat")
+    try:
+        for nth in [1, 2]:
+            pc.nthread(nth)
+            for binary in [0, 1]:
+                h.finitialize(-65)
+                # a partial frame of steps at the end
+                h.batch_run(5.05, tstep, path, "batch test", binary)
+                assert abs(h.t - 5.05) < h.dt / 4
+                frames = read(path, binary)
+                expected = np.array([vec.as_numpy()[::4] for vec in vecs]).T
+                assert vecs[0].size() == 203
+                assert frames.shape == (51, len(refs)) == expected.shape
+                if binary:
+                    assert np.array_equal(frames, expected)
+                else:
+                    # printed with %g
+                    assert np.allclose(frames, expected, rtol=1e-5, atol=1e-4)
+                assert frames[:, 0].max() > 0  # the cell fired
+    finally:
+        pc.nthread(1)
+        h.batch_save()
+        os.remove(path)
+        os.rmdir(os.path.dirname(path))
+
+
+if __name__ == "__main__":
+    test_batch_run()
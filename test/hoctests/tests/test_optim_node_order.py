@@ -93,3 +93,55 @@ pc.nthread(2)
 p()
 
 chk.save()
+
+
+# pc.optimize_node_order(1, 1) eliminates the nodes of a level for all the
+# cells of a thread in simd loops, in runs of at least 8 nodes whose parents
+# are at a constant offset, and in gather runs for what is left. With many
+# cells of one morphology and a few of others a level has both kinds of runs.
+# The results have to be identical to optimize_node_order(1, 0).
+
+
+class BranchedCell:
+    def __init__(self, id, morph):
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.L = self.soma.diam = 20
+        self.soma.insert("hh")
+        self.dends = []
+        for k in range(2 + morph):
+            dend = h.Section(name="dend%d" % k, cell=self)
+            dend.L = 100 + 40 * k
+            dend.diam = 2
+            dend.nseg = 3 + morph + k % 2
+            dend.insert("pas")
+            dend.connect(self.dends[k // 2](1) if k > 1 else self.soma(1))
+            self.dends.append(dend)
+        self.stim = h.IClamp(self.soma(0.5))
+        self.stim.delay = 0.5 + 0.1 * (id % 5)
+        self.stim.dur = 1e9
+        self.stim.amp = 0.3
+
+    def segs(self):
+        return [seg for sec in [self.soma] + self.dends for seg in sec.allseg()]
+
+
+def lockstep_run(simd):
+    pc.optimize_node_order(1, simd)
+    h.finitialize(-65)
+    vmax = -65
+    while h.t < 5:
+        h.fadvance()
+        vmax = max(vmax, branched[0].soma(0.5).v)
+    return [seg.v for cell in branched for seg in cell.segs()], vmax
+
+
+branched = [BranchedCell(i, 0 if i < 20 else 1 + i % 3) for i in range(26)]
+for nth in [1, 2]:
+    pc.nthread(nth)
+    ref, vmax = lockstep_run(0)
+    assert lockstep_run(1) == (ref, vmax)
+    # the cells fired
+    assert vmax > 0
+pc.optimize_node_order(0)
+pc.nthread(1)
+branched = None
@@ -0,0 +1,70 @@
+"""
+CVode.jacobian(3) solves the Newton systems with GMRES, preconditioned by
+NEURON's own linear solver (jacobian(0)). Both have to integrate an HH cell
+to the same result within the integration tolerance.
+"""
+import pytest
+from neuron import h
+
+h.load_file("stdrun.hoc")
+cv = h.CVode()
+
+
+class Cell:
+    def __init__(self, name, delay):
+        self.soma = h.Section(name=f"{name}_soma")
+        self.soma.L = self.soma.diam = 20
+        self.soma.insert("hh")
+        self.dend = h.Section(name=f"{name}_dend")
+        self.dend.L = 200
+        self.dend.diam = 2
+        self.dend.nseg = 5
+        self.dend.insert("pas")
+        self.dend.connect(self.soma(1))
+        self.stim = h.IClamp(self.soma(0.5))
+        self.stim.delay = delay
+        self.stim.dur = 1e9
+        self.stim.amp = 0.3
+        self.spikes = h.Vector()
+        self.nc = h.NetCon(self.soma(0.5)._ref_v, None, sec=self.soma)
+        self.nc.record(self.spikes)
+        self.v = h.Vector()
+        self.v.record(self.soma(0.5)._ref_v, 0.1)
+
+
+def run(cells, jacobian):
+    cv.jacobian(jacobian)
+    h.finitialize(-65)
+    h.continuerun(30)
+    return [(cell.v.c(), cell.spikes.c()) for cell in cells]
+
+
+@pytest.mark.parametrize("local", [False, True])
+def test_jacobian3(local):
+    cells = [Cell("a", 1), Cell("b", 3)]
+    cv.active(1)
+    cv.use_local_dt(local)
+    cv.atol(1e-5)
+    cv.rtol(1e-5)
+    try:
+        ref = run(cells, 0)
+        krylov = run(cells, 3)
+        # prints the Krylov iteration counts, which are checked for errors
+        cv.statistics()
+    finally:
+        cv.jacobian(0)
+        cv.use_local_dt(False)
+        cv.rtol(0)
+        cv.atol(1e-3)
+        cv.active(0)
+    for (v0, s0), (v3, s3) in zip(ref, krylov):
+        assert s0.size() > 1
+        assert s3.size() == s0.size()
+        assert s3.sub(s0).abs().max() < 0.005
+        assert v3.size() == v0.size()
+        assert v3.sub(v0).abs().max() < 2.0
+
+
+if __name__ == "__main__":
+    test_jacobian3(False)
+    test_jacobian3(True)
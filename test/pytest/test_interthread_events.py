@@ -0,0 +1,85 @@
+"""
+NetCon events between threads are sent by the job of the source thread while
+the target thread may be delivering its events in its own job. No event may
+be lost, so the spike raster of a densely connected network has to be the
+same with one and with several threads, and the same in repeated runs.
+"""
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+
+class Net:
+    """hh cells, each in its own section so that they are spread over the
+    threads, connected all to all with short delays."""
+
+    def __init__(self, ncell=24):
+        self.secs = []
+        self.syns = []
+        self.stims = []
+        for i in range(ncell):
+            sec = h.Section(name=f"cell{i}")
+            sec.L = sec.diam = 20
+            sec.insert("hh")
+            syn = h.ExpSyn(sec(0.5))
+            syn.tau = 2
+            stim = h.IClamp(sec(0.5))
+            stim.delay = 0.2 * i
+            stim.dur = 1e9
+            stim.amp = 0.15 + 0.01 * (i % 5)
+            self.secs.append(sec)
+            self.syns.append(syn)
+            self.stims.append(stim)
+        self.ncs = []
+        for i, src in enumerate(self.secs):
+            for j, syn in enumerate(self.syns):
+                if i != j:
+                    nc = h.NetCon(src(0.5)._ref_v, syn, sec=src)
+                    nc.delay = 0.5 + 0.025 * ((i + 2 * j) % 9)
+                    nc.weight[0] = 0.0002
+                    self.ncs.append(nc)
+        self.tvec = h.Vector()
+        self.idvec = h.Vector()
+        self.recorders = []
+        for i, sec in enumerate(self.secs):
+            nc = h.NetCon(sec(0.5)._ref_v, None, sec=sec)
+            nc.record(self.tvec, self.idvec, i)
+            self.recorders.append(nc)
+
+    def run(self, tstop=100):
+        h.finitialize(-65)
+        h.continuerun(tstop)
+        return sorted(zip(self.idvec, self.tvec))
+
+
+def test_interthread_events():
+    net = Net()
+    try:
+        ref = net.run()
+        pc.nthread(4)
+        threaded = net.run()
+        again = net.run()
+    finally:
+        pc.nthread(1)
+    # every cell fires repeatedly
+    assert len(ref) > 2 * len(net.secs)
+    assert threaded == again
+    assert len(threaded) == len(ref)
+    for (id0, t0), (id1, t1) in zip(ref, threaded):
+        assert id0 == id1
+        # events with the same delivery time may be added in another order
+        assert abs(t0 - t1) < 1e-6
+
+
+def test_synapses_matter():
+    net = Net()
+    active = net.run()
+    for nc in net.ncs:
+        nc.weight[0] = 0
+    assert net.run() != active
+
+
+if __name__ == "__main__":
+    test_interthread_events()
+    test_synapses_matter()
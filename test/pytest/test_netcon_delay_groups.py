@@ -0,0 +1,126 @@
+"""
+The spikes of a PreSyn whose NetCons share a few delays are sent as one event
+per (target thread, delay) group. The spike times have to be the same as when
+every NetCon gets its own event, which is what happens after a delay of the
+PreSyn was changed.
+"""
+import pytest
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+cv = h.CVode()
+
+
+class Net:
+    """IntFire1 cells, each in its own section so that they can be spread over
+    threads, a few of them driven by NetStims. Most NetCon delays take one of
+    three values, every seventh target gets a delay of its own.
+    """
+
+    def __init__(self, ncell=40):
+        self.secs = [h.Section(name=f"sec{i}") for i in range(ncell)]
+        self.cells = []
+        for sec in self.secs:
+            cell = h.IntFire1(sec(0.5))
+            cell.tau = 10
+            cell.refrac = 5
+            self.cells.append(cell)
+        self.stims = []
+        for i, cell in enumerate(self.cells[:4]):
+            stim = h.NetStim()
+            stim.start = 1 + 3 * i
+            stim.interval = 15
+            stim.number = 1e9
+            nc = h.NetCon(stim, cell)
+            nc.weight[0] = 2
+            nc.delay = 1
+            self.stims.append((stim, nc))
+        self.ncs = []
+        for i, src in enumerate(self.cells):
+            for j, tar in enumerate(self.cells):
+                if i != j and (3 * i + j) % 4 != 0:
+                    nc = h.NetCon(src, tar)
+                    nc.delay = self.delay(i, j)
+                    nc.weight[0] = 0.3
+                    self.ncs.append((i, j, nc))
+        self.tvec = h.Vector()
+        self.idvec = h.Vector()
+        self.recorders = []
+        for i, cell in enumerate(self.cells):
+            nc = h.NetCon(cell, None)
+            nc.record(self.tvec, self.idvec, i)
+            self.recorders.append(nc)
+
+    @staticmethod
+    def delay(i, j):
+        if j % 7 == 0:
+            return 1.0 + 0.01 * j
+        return [1.0, 2.5, 4.0][(i + j) % 3]
+
+    def ungroup(self):
+        # setting a delay turns grouping off for the PreSyn until finitialize
+        for _, _, nc in self.ncs:
+            nc.delay = nc.delay
+
+    def change_delays(self):
+        for i, j, nc in self.ncs:
+            if i % 3 == 0:
+                nc.delay = 0.5 + self.delay(j, i)
+
+    def spikes(self):
+        return sorted(zip(self.tvec, self.idvec))
+
+
+def queued_events():
+    """Number of items on the thread 0 event queue and the NetCon events
+    they stand for."""
+    tvec = h.Vector()
+    cv.print_event_queue(tvec)
+    nctvec = h.Vector()
+    cv.event_queue_info(2, nctvec, h.List())
+    return tvec.size(), nctvec.size()
+
+
+def run(net, grouped, change_at=None, tstop=60):
+    h.finitialize(-65)
+    if not grouped:
+        net.ungroup()
+    if change_at is not None:
+        h.continuerun(change_at)
+        net.change_delays()
+    h.continuerun(tstop)
+    return net.spikes()
+
+
+@pytest.mark.parametrize("nthread", [1, 2])
+@pytest.mark.parametrize("cvode", [False, True])
+def test_delay_groups(nthread, cvode):
+    net = Net()
+    pc.nthread(nthread)
+    cv.active(cvode)
+    try:
+        # groups are used: the queue holds fewer items than NetCon events
+        h.finitialize(-65)
+        h.continuerun(10.05)
+        nitem, nevent = queued_events()
+        assert nevent > nitem
+
+        grouped = run(net, True)
+        # more cells fire than the NetStims drive
+        assert len({int(id) for _, id in grouped}) > len(net.stims)
+        assert grouped == run(net, False)
+
+        # delays changed during the run, while group events are pending
+        grouped = run(net, True, change_at=20.05)
+        assert grouped == run(net, False, change_at=20.05)
+        assert grouped != run(net, True)
+    finally:
+        cv.active(False)
+        pc.nthread(1)
+
+
+if __name__ == "__main__":
+    for nthread in [1, 2]:
+        for cvode in [False, True]:
+            test_delay_groups(nthread, cvode)
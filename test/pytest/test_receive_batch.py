@@ -0,0 +1,96 @@
+"""
+With CVode.queue_mode(1, 0, 0, 1) the NetCon events of a fixed step bin are
+handed to NET_RECEIVE in one call per mechanism type. The result has to be the
+same as with one NET_RECEIVE call per event.
+"""
+from neuron import h
+
+h.load_file("stdrun.hoc")
+cv = h.CVode()
+
+
+class Cell:
+    def __init__(self, name):
+        self.soma = h.Section(name=name)
+        self.soma.L = self.soma.diam = 20
+        self.soma.insert("hh")
+        self.syns = []
+        for k in range(3):
+            self.syns.append(h.ExpSyn(self.soma(0.5)))
+            syn = h.Exp2Syn(self.soma(0.5))
+            syn.tau2 = 3
+            self.syns.append(syn)
+        # WATCH and self events of the same bin as the input events
+        self.watch = h.WatchSyn(self.soma(0.5))
+        self.syns.append(self.watch)
+        self.v = h.Vector()
+        self.v.record(self.soma(0.5)._ref_v)
+
+
+class Net:
+    """Cell a is driven by noisy NetStims with delays that are multiples of dt,
+    so many events share a bin. The spikes of a reach b through NetCons of
+    equal delay (one PreSyn event) and of mixed delays.
+    """
+
+    def __init__(self):
+        self.a = Cell("a")
+        self.b = Cell("b")
+        self.stims = []
+        self.ncs = []
+        for i in range(8):
+            stim = h.NetStim()
+            stim.interval = 2
+            stim.number = 1e9
+            stim.start = 0
+            stim.noise = 1
+            stim.noiseFromRandom123(i, 1, 2)
+            self.stims.append(stim)
+            for k, syn in enumerate(self.a.syns):
+                nc = h.NetCon(stim, syn)
+                nc.delay = h.dt * (1 + (i + k) % 4)
+                nc.weight[0] = 0.002
+                self.ncs.append(nc)
+        for k, syn in enumerate(self.b.syns):
+            nc = h.NetCon(self.a.soma(0.5)._ref_v, syn, sec=self.a.soma)
+            nc.delay = 1
+            nc.weight[0] = 0.005
+            self.ncs.append(nc)
+        self.mixed = []
+        for k, syn in enumerate(self.b.syns):
+            nc = h.NetCon(self.b.soma(0.5)._ref_v, syn, sec=self.b.soma)
+            nc.delay = 1 + h.dt * k
+            nc.weight[0] = 0.001
+            self.mixed.append(nc)
+
+    def result(self):
+        res = []
+        for cell in [self.a, self.b]:
+            w = cell.watch
+            res.append((list(cell.v), w.nin, w.nself, w.nwatch, w.tself))
+        return res
+
+
+def test_receive_batch():
+    net = Net()
+    h.dt = 0.025
+    results = []
+    try:
+        for batch in [0, 1]:
+            assert cv.queue_mode(1, 0, 0, batch) == 1 + 8 * batch
+            h.finitialize(-65)
+            h.continuerun(50)
+            results.append(net.result())
+    finally:
+        cv.queue_mode(0, 0, 0, 0)
+    unbatched, batched = results
+    for v, nin, nself, nwatch, tself in unbatched:
+        assert nin > 0
+        # the self event of an input in the last step may still be queued
+        assert nin - 1 <= nself <= nin
+        assert nwatch > 0
+    assert batched == unbatched
+
+
+if __name__ == "__main__":
+    test_receive_batch()
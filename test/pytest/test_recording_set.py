@@ -0,0 +1,146 @@
+"""
+A RecordingSet records the same values as a Vector.record per variable, with
+one or more threads. Its block is shared with Python through the buffer
+protocol and must not move while a view exists.
+"""
+import numpy as np
+import pytest
+from neuron import h
+from neuron.expect_hocerr import expect_hocerr
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+
+class Cells:
+    """hh somas with passive dendrites, every cell in its own tree so that
+    they can be spread over threads."""
+
+    def __init__(self, ncell=6):
+        self.secs = []
+        self.stims = []
+        for i in range(ncell):
+            soma = h.Section(name=f"soma{i}")
+            soma.L = soma.diam = 20
+            soma.insert("hh")
+            dend = h.Section(name=f"dend{i}")
+            dend.L = 200
+            dend.diam = 2
+            dend.nseg = 3
+            dend.insert("pas")
+            dend.connect(soma(1))
+            stim = h.IClamp(soma(0.5))
+            stim.delay = 1 + i
+            stim.dur = 1e9
+            stim.amp = 0.1 + 0.05 * i
+            self.secs += [soma, dend]
+            self.stims.append(stim)
+
+    def refs(self):
+        refs = [seg._ref_v for sec in self.secs for seg in sec]
+        refs += [sec(0.5)._ref_m_hh for sec in self.secs if sec.has_membrane("hh")]
+        return refs
+
+
+def record(refs, every=1, float32=0):
+    rs = h.RecordingSet(every, float32)
+    pv = h.PtrVector(len(refs) - 1)
+    for i, ref in enumerate(refs[1:]):
+        pv.pset(i, ref)
+    # both ways of adding columns
+    assert rs.add(refs[0]) == 0
+    assert rs.add(pv) == 1
+    vecs = []
+    for ref in refs:
+        vec = h.Vector()
+        vec.record(ref)
+        vecs.append(vec)
+    tvec = h.Vector()
+    tvec.record(h._ref_t)
+    return rs, vecs, tvec
+
+
+@pytest.mark.parametrize("nthread", [1, 2])
+def test_recording_set_fixed_step(nthread):
+    cells = Cells()
+    refs = cells.refs()
+    pc.nthread(nthread)
+    try:
+        rs, vecs, tvec = record(refs)
+        rs3 = h.RecordingSet(3, 1)
+        for ref in refs:
+            rs3.add(ref)
+        h.finitialize(-65)
+        h.continuerun(10)
+    finally:
+        pc.nthread(1)
+
+    assert rs.ncol() == len(refs) and rs.nrow() == tvec.size()
+    t = h.Vector()
+    assert rs.tvec(t) == tvec.size()
+    assert t.eq(tvec)
+    col = h.Vector()
+    for i, vec in enumerate(vecs):
+        assert rs.column(i, col) == vec.size()
+        assert col.eq(vec)
+        assert rs.get(vec.size() - 1, i) == vec[vec.size() - 1]
+    a = np.asarray(rs)
+    assert a.shape == (rs.nrow(), rs.ncol()) and a.dtype == np.float64
+    assert np.array_equal(a, np.array([vec.as_numpy() for vec in vecs]).T)
+
+    # every third step, as float
+    a3 = np.asarray(rs3)
+    assert a3.dtype == np.float32
+    assert a3.shape == (len(range(0, len(tvec), 3)), len(refs))
+    expected = np.array([vec.as_numpy()[::3] for vec in vecs], dtype=np.float32).T
+    assert np.array_equal(a3, expected)
+
+
+@pytest.mark.parametrize("nthread", [1, 2])
+def test_recording_set_export(nthread):
+    # with 2 threads the rows are written by the worker threads, where the
+    # error of a full exported block must not be raised
+    cells = Cells(2)
+    refs = cells.refs()
+    pc.nthread(nthread)
+    try:
+        rs, vecs, _ = record(refs)
+        rs.reserve(10)
+        h.finitialize(-65)
+        h.continuerun(0.1)
+        nrow = rs.nrow()
+        assert nrow < 10
+        m = memoryview(rs)
+        assert m.format == "d" and m.shape == (nrow, len(refs))
+        assert m.tolist()[-1] == [vec[nrow - 1] for vec in vecs]
+
+        # reserved rows are filled in place, more would move the block
+        h.continuerun(h.t + (9 - nrow) * h.dt)
+        assert rs.nrow() == 9
+        expect_hocerr(h.continuerun, (1,))
+        # the rows that fit are recorded, the others are not
+        assert rs.nrow() == 10
+        expected = np.array([vec.as_numpy()[:10] for vec in vecs]).T
+        assert np.array_equal(np.asarray(rs), expected)
+        expect_hocerr(rs.reserve, (1000,))
+        expect_hocerr(rs.remove_all, ())
+        assert m.shape == (nrow, len(refs))
+        m.release()
+
+        # a new run overwrites the block in place, a view sees its values
+        a = np.asarray(rs)
+        h.finitialize(-70)
+        assert a[0, 0] == -70
+        del a
+        rs.reserve(1000)
+        h.continuerun(1)
+        assert rs.nrow() == vecs[0].size()
+    finally:
+        pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_recording_set_fixed_step(1)
+    test_recording_set_fixed_step(2)
+    test_recording_set_export(1)
+    test_recording_set_export(2)
@@ -0,0 +1,75 @@
+"""
+A Vector shares its data through the Python buffer protocol. While a view
+exists, the Vector must not be reallocated or shrunk.
+"""
+import numpy as np
+from neuron import h
+from neuron.expect_hocerr import expect_hocerr
+
+
+def test_memoryview_reflects_writes():
+    v = h.Vector(range(5))
+    m = memoryview(v)
+    assert m.format == "d" and m.shape == (5,) and not m.readonly
+    m[2] = 10.0
+    assert v[2] == 10.0
+    v.x[3] = 7.0
+    assert m[3] == 7.0
+    a = np.asarray(v)
+    a[0] = -1.0
+    assert v[0] == -1.0 and m[0] == -1.0
+    assert m.tolist() == v.to_python()
+    del a
+    m.release()
+
+
+def test_append_to_exported_vector_raises():
+    v = h.Vector(range(3))
+    v.buffer_size(3)
+    values = v.to_python()
+    m = memoryview(v)
+    big = h.Vector(range(100))
+    expect_hocerr(v.append, (big,))
+    expect_hocerr(v.append, tuple(range(100)))
+    expect_hocerr(v.insert, (1, big))
+    expect_hocerr(v.resize, (100,))
+    expect_hocerr(v.from_buffer, (np.zeros(100),))
+    # the Vector is unchanged and the view still valid
+    assert v.to_python() == values
+    assert m.tolist() == values
+    m.release()
+    v.append(big)
+    assert v.size() == 103
+
+
+def test_shrink_exported_vector_raises():
+    v = h.Vector(range(5))
+    m = memoryview(v)
+    expect_hocerr(v.resize, (2,))
+    expect_hocerr(v.remove, (0,))
+    expect_hocerr(v.from_buffer, (np.zeros(2),))
+    assert v.to_python() == [0.0, 1.0, 2.0, 3.0, 4.0]
+    m.release()
+    v.resize(2)
+    assert v.size() == 2
+
+
+def test_grow_exported_vector_in_place():
+    v = h.Vector(range(3))
+    v.buffer_size(10)
+    m = memoryview(v)
+    v.append(3, 4)
+    v.insert(0, h.Vector([-1.0]))
+    # the view keeps its shape and sees the moved values
+    assert v.to_python() == [-1.0, 0.0, 1.0, 2.0, 3.0, 4.0]
+    assert m.tolist() == [-1.0, 0.0, 1.0]
+    expect_hocerr(v.append, tuple(range(20)))
+    assert v.size() == 6
+    m.release()
+
+
+if __name__ == "__main__":
+    test_memoryview_reflects_writes()
+    test_append_to_exported_vector_raises()
+    test_shrink_exported_vector_raises()
+    test_grow_exported_vector_in_place()
@@ -0,0 +1,67 @@
+: Synapse for the batched NET_RECEIVE test. An input event increments the
+: conductance and sends a self event for the same time, which counts it.
+: A WATCH on the membrane potential counts the threshold crossings.
+
+NEURON {
+  POINT_PROCESS WatchSyn
+  RANGE tau, e, i, vth, nin, nself, nwatch, tself
+  NONSPECIFIC_CURRENT i
+}
+
+UNITS {
+  (nA) = (nanoamp)
+  (mV) = (millivolt)
+  (uS) = (microsiemens)
+}
+
+PARAMETER {
+  tau = 2 (ms)
+  e = 0 (mV)
+  vth = -20 (mV)
+}
+
+ASSIGNED {
+  v (mV)
+  i (nA)
+  nin (1)
+  nself (1)
+  nwatch (1)
+  tself (ms)
+}
+
+STATE {
+  g (uS)
+}
+
+INITIAL {
+  g = 0
+  nin = 0
+  nself = 0
+  nwatch = 0
+  tself = -1
+  net_send(0, 3)
+}
+
+BREAKPOINT {
+  SOLVE state METHOD cnexp
+  i = g*(v - e)
+}
+
+DERIVATIVE state {
+  g' = -g/tau
+}
+
+NET_RECEIVE(weight (uS)) {
+  if (flag == 0) {
+    g = g + weight
+    nin = nin + 1
+    net_send(0, 1)
+  } else if (flag == 1) {
+    nself = nself + 1
+    tself = t
+  } else if (flag == 2) {
+    nwatch = nwatch + 1
+  } else if (flag == 3) {
+    WATCH (v > vth) 2
+  }
+}
@@ -12,7 +12,7 @@ from neuron import config, h
 pc = h.ParallelContext()
 
 from neuron.expect_hocerr import expect_err
-from test_hoc_po import Ring
+from test_hoc_po import PyCell, Ring
 
 cvode = h.CVode()
 
@@ -50,8 +50,43 @@ def mpi_test1():  # pgvts_deliver and pc.spike_record
     cvode.condition_order(1)
 
 
-def mpi_test2():
-    return
+def mpi_test2():  # sparse and node aware exchanges deliver the same spikes as allgather
+    # ring distributed round robin so that spikes cross ranks
+    pc.gid_clear()
+    ngid = 4 * pc.nhost()
+    cells = {gid: PyCell(gid) for gid in range(pc.id(), ngid, pc.nhost())}
+    ncs = [pc.gid_connect((gid - 1) % ngid, cell.syn) for gid, cell in cells.items()]
+    for nc in ncs:
+        nc.delay = 1.0
+        nc.weight[0] = 0.004
+    for gid in cells:
+        pc.threshold(gid, -10.0)
+    if 0 in cells:
+        ic = h.IClamp(cells[0].soma(0.5))
+        ic.delay = 1
+        ic.dur = 0.2
+        ic.amp = 0.3
+    spiketime = h.Vector()
+    spikegid = h.Vector()
+    pc.spike_record(-1, spiketime, spikegid)
+    results = []
+    # allgather, sparse and node aware allgather, then allgather and node aware
+    # allgather with compression
+    for nspike, xchng_meth in [(0, 0), (0, 2), (0, 16), (2, 0), (2, 16)]:
+        pc.spike_compress(nspike, 0, xchng_meth)
+        # bit 4 of the method properties, the ranks of the test share a node
+        assert bool(int(pc.send_time(8)) & 16) == bool(xchng_meth & 16)
+        run(20.0)
+        results.append((spiketime.c(), spikegid.c()))
+    # more than the stimulated cell spiked, so spikes crossed ranks
+    assert pc.allreduce(results[0][0].size(), 1) > 1
+    for i, j in [(0, 1), (0, 2), (3, 4)]:
+        assert results[i][0].eq(results[j][0])
+        assert results[i][1].eq(results[j][1])
+    pc.spike_compress(0, 0, 0)
+    pc.gid_clear()
+    del cells, ncs
+    locals()
 
 
 def err_test1():
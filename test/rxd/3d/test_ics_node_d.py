@@ -0,0 +1,44 @@
+from math import exp
+
+
+def test_ics_node_d_mid_run(neuron_nosave_instance):
+    """Changing Node.d during a fixed step run has to take effect on the next
+    step although the factors of the ADI line matrices are cached"""
+
+    h, rxd, save_path = neuron_nosave_instance
+    rxd.set_solve_type(dimension=3)
+    dend = h.Section(name="dend")
+    dend.nseg = 11
+    dend.pt3dclear()
+    dend.pt3dadd(-3, 0, 0, 3)
+    dend.pt3dadd(3, 0, 0, 3)
+    r = rxd.Region([dend], dx=0.75)
+
+    def initial(nd):
+        return exp(-((nd.x3d - 0.375) ** 2 + nd.y3d**2 + nd.z3d**2))
+
+    def changed(nd, dr=None):
+        return 0.5 if nd.x3d < 0 else 0.1
+
+    # d is changed in place, in the _dgrid the species already has
+    ca = rxd.Species(r, d=lambda nd, dr: 0.1, initial=initial)
+    # factored with the changed d from its first step on
+    ref = rxd.Species(r, d=changed, initial=initial)
+    # keeps the old d
+    old = rxd.Species(r, d=lambda nd, dr: 0.1, initial=initial)
+
+    h.dt *= 10
+    h.finitialize(-65)
+    h.continuerun(2)
+    for nd, nd_ref, nd_old in zip(ca.nodes, ref.nodes, old.nodes):
+        nd_ref.concentration = nd_old.concentration = nd.concentration
+        nd.d = changed(nd)
+    h.continuerun(4)
+
+    max_err = max_change = 0
+    for nd, nd_ref, nd_old in zip(ca.nodes, ref.nodes, old.nodes):
+        max_err = max(max_err, abs(nd.concentration - nd_ref.concentration))
+        max_change = max(max_change, abs(nd.concentration - nd_old.concentration))
+    assert max_err < 1e-12
+    # the change of d matters, a stale factorization would not pass
+    assert max_change > 1e-6
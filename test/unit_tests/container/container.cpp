@@ -1,7 +1,11 @@
+#include "multicore.h"
+#include "neuron/cache/mechanism_range.hpp"
+#include "neuron/container/memory_usage.hpp"
 #include "neuron/container/soa_container.hpp"
 #include "neuron/container/view_utils.hpp"
 #include "neuron/model_data.hpp"
 #include "nrn_ansi.h"
+#include "section.h"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -118,6 +122,149 @@ TEST_CASE("Multi-threaded calls to nrn_ensure_model_data_are_sorted()",
     }
 }
 
+namespace {
+/**
+ * @brief Require that the pdata cache of every Memb_list holds what its dparam refer to.
+ */
+void require_pdata_caches_valid() {
+    auto const token = nrn_ensure_model_data_are_sorted();
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        for (NrnThreadMembList* tml = nt->tml; tml; tml = tml->next) {
+            Memb_list* const ml = tml->ml;
+            auto const& ptr_cache = token.mech_cache(tml->index).pdata_ptr_cache;
+            auto const offset = ml->get_storage_offset();
+            neuron::cache::indices_to_cache(tml->index, [&](auto field) {
+                REQUIRE(field < ptr_cache.size());
+                REQUIRE(ptr_cache[field]);
+                for (int i = 0; i < ml->nodecount; ++i) {
+                    REQUIRE(ptr_cache[field][offset + i] ==
+                            ml->pdata[i][field].template get<double*>());
+                }
+            });
+        }
+    }
+}
+}  // namespace
+
+SCENARIO("Re-sorting reuses the caches of unchanged mechanism types", "[Neuron][data_structures]") {
+    GIVEN("An initialised model with a synapse-free cell") {
+        REQUIRE(hoc_oc("create pdc_soma, pdc_dend\n"
+                       "pdc_soma { L = 20 diam = 20 insert hh }\n"
+                       "pdc_dend { L = 200 diam = 2 nseg = 5 insert pas }\n"
+                       "connect pdc_dend(0), pdc_soma(1)\n"
+                       "objref pdc_syn\n"
+                       "finitialize(-65)\n") == 0);
+        require_pdata_caches_valid();
+        // Run a hoc statement that changes the model and initialise again, which
+        // should sort the model once, fully or only the changed types.
+        auto const change = [](const char* stmt, bool full) {
+            auto const before = model_sort_timing;
+            REQUIRE(hoc_oc(stmt) == 0);
+            REQUIRE(hoc_oc("finitialize(-65)\n") == 0);
+            REQUIRE(model_sort_timing.full == before.full + full);
+            REQUIRE(model_sort_timing.incremental == before.incremental + !full);
+            require_pdata_caches_valid();
+        };
+        THEN("Only the changed types are sorted while the Nodes do not move") {
+            // a new instance of a point process type
+            change("pdc_dend pdc_syn = new ExpSyn(0.5)\n", false);
+            // its area pointer changes
+            change("pdc_soma pdc_syn.loc(0.5)\n", false);
+            // the Nodes of a new section and a new ion instance
+            change("create pdc_new\npdc_new insert na_ion\n", true);
+            // Nodes are deleted
+            change("pdc_dend delete_section()\n", true);
+            // nothing changed, nothing is sorted
+            auto const before = model_sort_timing;
+            REQUIRE(hoc_oc("finitialize(-65)\n") == 0);
+            REQUIRE(model_sort_timing.full == before.full);
+            REQUIRE(model_sort_timing.incremental == before.incremental);
+        }
+        REQUIRE(hoc_oc("objref pdc_syn\n"
+                       "pdc_new delete_section()\n"
+                       "pdc_soma delete_section()\n") == 0);
+        REQUIRE(neuron::model().node_data().size() == 0);
+    }
+}
+
+namespace {
+/**
+ * @brief Storage rows and caches that a sort leaves behind.
+ *
+ * rows holds the row of each Node followed by those of its Props, in thread
+ * and Node order.
+ */
+struct SortedLayout {
+    std::vector<std::size_t> rows;
+    std::vector<std::vector<std::size_t>> mechanism_offset;
+    std::vector<std::vector<std::vector<double*>>> pdata;
+};
+
+SortedLayout full_sort() {
+    // Without a cache to reuse and with all the data unsorted, the sort is a
+    // full one
+    neuron::model().node_data().mark_as_unsorted();
+    neuron::model().apply_to_mechanisms([](auto& mech_data) { mech_data.mark_as_unsorted(); });
+    neuron::cache::stale_model.reset();
+    auto const full = model_sort_timing.full;
+    auto const token = nrn_ensure_model_data_are_sorted();
+    REQUIRE(model_sort_timing.full == full + 1);
+    SortedLayout layout;
+    for (NrnThread* nt: for_threads(nrn_threads, nrn_nthread)) {
+        for (int i = 0; i < nt->end; ++i) {
+            ::Node* const nd = nt->_v_node[i];
+            layout.rows.push_back(nd->id().current_row());
+            for (Prop* p = nd->prop; p; p = p->next) {
+                layout.rows.push_back(p->current_row());
+            }
+        }
+        layout.mechanism_offset.push_back(token.thread_cache(nt->id).mechanism_offset);
+    }
+    for (auto const& mech_cache: token.cache().mechanism) {
+        layout.pdata.push_back(mech_cache.pdata);
+    }
+    return layout;
+}
+}  // namespace
+
+SCENARIO("Sorting the mechanism types in parallel gives the serial result",
+         "[Neuron][data_structures]") {
+    GIVEN("A model of several cells in four NrnThreads") {
+        REQUIRE(hoc_oc("objref pss_pc, pss_syns\n"
+                       "pss_pc = new ParallelContext()\n"
+                       "pss_syns = new List()\n"
+                       "create pss_soma[8], pss_dend[8]\n"
+                       "for i = 0, 7 {\n"
+                       "    pss_soma[i] { L = 20 diam = 20 insert hh }\n"
+                       "    pss_dend[i] { L = 100 diam = 2 nseg = 3 + i % 3 insert pas }\n"
+                       "    connect pss_dend[i](0), pss_soma[i](1)\n"
+                       "    if (i % 2) { pss_dend[i] pss_syns.append(new ExpSyn(0.5)) }\n"
+                       "}\n"
+                       "pss_pc.nthread(4, 0)\n"
+                       "finitialize(-65)\n") == 0);
+        REQUIRE(nrn_nthread == 4);
+        THEN("The storage order and the caches do not depend on the number of worker threads") {
+            // The first full sort may make room in the ion storage, after that
+            // nothing moves
+            full_sort();
+            auto const serial = full_sort();
+            REQUIRE(hoc_oc("pss_pc.nthread(4, 1)\n") == 0);
+            auto const parallel = full_sort();
+            REQUIRE(parallel.rows == serial.rows);
+            REQUIRE(parallel.mechanism_offset == serial.mechanism_offset);
+            REQUIRE(parallel.pdata == serial.pdata);
+            require_pdata_caches_valid();
+        }
+        REQUIRE(hoc_oc("pss_pc.nthread(1)\n"
+                       "objref pss_syns, pss_pc\n"
+                       "for i = 0, 7 {\n"
+                       "    pss_dend[i] delete_section()\n"
+                       "    pss_soma[i] delete_section()\n"
+                       "}\n") == 0);
+        REQUIRE(neuron::model().node_data().size() == 0);
+    }
+}
+
 TEST_CASE("soa::get_array_dims", "[Neuron][data_structures]") {
     storage data;
 